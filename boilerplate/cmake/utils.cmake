@@ -79,7 +79,7 @@ macro(set_opt_level)
     get_npm_config_variable_as_string_optional(OPT_LEVEL)
     if (DEFINED OPT_LEVEL)
         if (NOT "${OPT_LEVEL}" STREQUAL "")
-            string(REGEX MATCH "^\-O[0-3]$" OPT_LEVEL ${OPT_LEVEL})
+            string(REGEX MATCH "^\-O[0-3sz]$" OPT_LEVEL ${OPT_LEVEL})
             if ("${OPT_LEVEL}" STREQUAL "")
                 set(OPT_LEVEL "-O3")
             endif()
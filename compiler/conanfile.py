@@ -88,6 +88,15 @@ class TSNativeCompilerConan(ConanFile):
         llc_path_dst = os.path.join(self.package_folder, "bin")
         shutil.copy2(llc_path_src, os.path.join(llc_path_dst, "tsnative-llc%s" % binext))
 
+        opt_path_src = os.path.join(llvm_path, "opt%s" % binext)
+        shutil.copy2(opt_path_src, os.path.join(llc_path_dst, "tsnative-opt%s" % binext))
+
+        llvm_link_path_src = os.path.join(llvm_path, "llvm-link%s" % binext)
+        shutil.copy2(llvm_link_path_src, os.path.join(llc_path_dst, "tsnative-llvm-link%s" % binext))
+
+        llvm_split_path_src = os.path.join(llvm_path, "llvm-split%s" % binext)
+        shutil.copy2(llvm_split_path_src, os.path.join(llc_path_dst, "tsnative-llvm-split%s" % binext))
+
     def package_info(self):
         self.env_info.path.append(self.package_folder)
         self.cpp_info.bindirs = ["bin"]
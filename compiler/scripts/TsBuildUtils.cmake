@@ -386,13 +386,33 @@ function(compile_ll target dep_target ll_bytecode optimizationLevel output_dir c
         set(END_PROFILE_COMMAND "${Python_EXECUTABLE} ${BUILD_TIME_PROFILER_SCRIPT} --tag COMPILE_IR --end")
     endif()
 
+    # -O0 skips the IR pass pipeline, -Os/-Oz have no llc counterpart and are compiled with -O2
+    set(llcOptimizationLevel ${optimizationLevel})
+    set(optimized_bytecode ${ll_bytecode})
+    if ("${optimizationLevel}" MATCHES "^-O([1-3sz])$")
+        # nested MATCHES below resets CMAKE_MATCH_1
+        set(optLevel "${CMAKE_MATCH_1}")
+        string(REPLACE ".ll" ".opt.bc" optimized_bytecode "${ll_bytecode}")
+        if ("${optLevel}" MATCHES "[sz]")
+            set(llcOptimizationLevel -O2)
+        endif()
+
+        add_custom_command(
+            OUTPUT ${optimized_bytecode}
+            DEPENDS ${ll_bytecode}
+            COMMAND echo "Running opt..."
+            COMMAND ${LLVM_TOOLS_BINARY_DIR}/opt${CMAKE_EXECUTABLE_SUFFIX} "-passes=default<O${optLevel}>" ${ll_bytecode} -o ${optimized_bytecode}
+            VERBATIM
+        )
+    endif()
+
     # TODO: make compile options configurable
     add_custom_command(
         OUTPUT ${output}
-        DEPENDS ${ll_bytecode}
+        DEPENDS ${optimized_bytecode}
         COMMAND echo "Running llc..."
         COMMAND bash -c ${START_PROFILE_COMMAND}
-        COMMAND ${LLVM_TOOLS_BINARY_DIR}/llc${CMAKE_EXECUTABLE_SUFFIX} ${optimizationLevel} -relocation-model=pic -filetype=obj ${ll_bytecode} -o ${output}
+        COMMAND ${LLVM_TOOLS_BINARY_DIR}/llc${CMAKE_EXECUTABLE_SUFFIX} ${llcOptimizationLevel} -relocation-model=pic -filetype=obj ${optimized_bytecode} -o ${output}
         COMMAND bash -c ${END_PROFILE_COMMAND}
     )
 
@@ -461,13 +481,17 @@ function(add_antiq_executable target ...)
     message(STATUS "ARG_INCLUDES ${ARG_INCLUDES}")
     message(STATUS "ARG_DEPENDENCIES ${ARG_DEPENDENCIES}") # TODO: remove
     message(STATUS "ARG_DEFINITIONS ${ARG_DEFINITIONS}")
-    message(STATUS "ARG_OPTIMIZATION_LEVEL ${OPTIMIZATION_LEVEL}")
+    message(STATUS "ARG_OPTIMIZATION_LEVEL ${ARG_OPTIMIZATION_LEVEL}")
     message(STATUS "ARG_IS_TEST ${ARG_IS_TEST}")
     message(STATUS "ARG_IS_PRINT_IR ${ARG_IS_PRINT_IR}")
     message(STATUS "ARG_TRACE_IMPORT ${ARG_TRACE_IMPORT}")
     message(STATUS "ARG_IS_DEBUG ${ARG_IS_DEBUG}")
     message(STATUS "ARG_EXECUTABLE_PATH ${ARG_EXECUTABLE_PATH}")
 
+    if ("${ARG_OPTIMIZATION_LEVEL}" STREQUAL "")
+        set(ARG_OPTIMIZATION_LEVEL "${OPTIMIZATION_LEVEL}")
+    endif()
+
     if ("${ARG_EXECUTABLE_PATH}" STREQUAL "")
         set(ARG_EXECUTABLE_PATH "${CMAKE_CURRENT_BINARY_DIR}/${target}")
         message(STATUS "ARG_EXECUTABLE_PATH ${ARG_EXECUTABLE_PATH}")
@@ -593,7 +617,7 @@ function(add_antiq_executable target ...)
         compile_ll_${binary_name}
         compile_ts_${binary_name}
         "${LL_BYTECODE}"
-        "${OPTIMIZATION_LEVEL}"
+        "${ARG_OPTIMIZATION_LEVEL}"
         "${output_dir}"
         COMPILED_SOURCE
     )
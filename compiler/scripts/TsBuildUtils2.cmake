@@ -9,6 +9,21 @@ else()
     find_program(llcBin tsnative-llc REQUIRED)
 endif()
 
+if(${CMAKE_VERSION} VERSION_LESS "3.18.0")
+    find_program(optBin tsnative-opt)
+    if (NOT optBin)
+        message(FATAL_ERROR "tsnative-opt not found")
+    endif()
+else()
+    find_program(optBin tsnative-opt REQUIRED)
+endif()
+
+# Optional, only LTO builds need it
+find_program(llvmLinkBin tsnative-llvm-link)
+
+# Optional, only builds with CODEGEN_JOBS > 1 need it
+find_program(llvmSplitBin tsnative-llvm-split)
+
 set (nmBin ${CMAKE_NM})
 
 if (${TS_PROFILE_BUILD})
@@ -44,7 +59,14 @@ set(CACHED_CMAKE_CURRENT_LIST_DIR ${CMAKE_CURRENT_LIST_DIR})
 #  TS_DEBUG             Compile user code in the debug mode
 #  PRINT_IR             Print IR code to console.
 #  TRACE_IMPORT         Enable ts module resolution tracing
-#  OPT_LEVEL            Optimization level that will be passed to llc "as is"
+#  OPT_LEVEL            Optimization level: -O0, -O1, -O2, -O3, -Os or -Oz. The IR is run through
+#                       the tsnative-opt pass pipeline of that level (nothing is run for -O0) and then
+#                       compiled by llc. Defaults to -O0.
+#  LTO                  Link the TS module with the tsnative-std bitcode (tsnative-std built with BUILD_BITCODE)
+#                       before optimization, so small runtime functions can be inlined into TS code.
+#                       Runtime code that is not used is dropped by the linker.
+#  CODEGEN_JOBS         Split the optimized IR into that many modules (tsnative-llvm-split) and compile them by
+#                       separate llc commands, so the build system can run them in parallel. Defaults to 1.
 #  WATCH_SOURCES        List of files, because of changes in which, it is necessary to rebuild the project.
 #                       If not provided, the all sources from the directory containing main ts file will be used as
 #                       the files from TS_HEADERS property defined in LIBRARIES targets.
@@ -55,7 +77,8 @@ set(CACHED_CMAKE_CURRENT_LIST_DIR ${CMAKE_CURRENT_LIST_DIR})
 
 function (add_ts_library ARG_NAME ...)
     set(options )
-    set(oneValueArgs SRC TS_CONFIG BASE_URL TS_DEBUG PRINT_IR TRACE_IMPORT OPT_LEVEL ENABLE_OPTIMIZATIONS)
+    set(oneValueArgs SRC TS_CONFIG BASE_URL TS_DEBUG PRINT_IR TRACE_IMPORT OPT_LEVEL ENABLE_OPTIMIZATIONS LTO
+        CODEGEN_JOBS)
     set(multiValueArgs DEFINES LIBRARIES WATCH_SOURCES DEPENDS)
 
     cmake_parse_arguments(PARSE_ARGV 1 "ARG" "${options}" "${oneValueArgs}" "${multiValueArgs}")
@@ -108,17 +131,16 @@ function (add_ts_library ARG_NAME ...)
     _printVar(definitions)
     _printVar(libraries)
 
-    # Stages 0-2 produce files with mangled and demangled names for input targets(libraries),
-    #   instantiated classes and functions. And add them to two lists: mangledTables and demangledTables.
+    # Stages 0-1 produce files with mangled and demangled names for input targets(libraries)
+    #   and instantiated templates. And add them to two lists: mangledTables and demangledTables.
     # Stage 3 compiles mainTs and produces an IR bytecode.
-    # Stage 4 compiles IR to an object file.
+    # Stage 4 compiles IR to object files, one per CODEGEN_JOBS partition.
     # Stage 5 compiles seed and creates an object library.
 
     # These top-level targets will be created.
 
     set(stage0 "${targetName}_extract_symbols")
-    set(stage1 "${targetName}_instantiated_classes")
-    set(stage2 "${targetName}_instantiated_functions")
+    set(stage1 "${targetName}_instantiated_templates")
 
     set(mangledTables )
     set(demangledTables )
@@ -142,8 +164,8 @@ function (add_ts_library ARG_NAME ...)
     # - If defined, do nothing.
     _collectWatchSources()
 
-    _addStage(${stage1} ${stage0} "instantiated_classes.cpp" --processTemplateClasses)
-    _addStage(${stage2} ${stage1} "instantiated_functions.cpp" --processTemplateFunctions)
+    # Template classes and functions are instantiated by a single compiler run
+    _addStage(${stage1} ${stage0} "instantiated_classes.cpp;instantiated_functions.cpp" --processTemplates)
 
     # Stage 2
 
@@ -155,34 +177,136 @@ function (add_ts_library ARG_NAME ...)
         MANGLED ${mangledTables}
         DEMANGLED ${demangledTables}
         FLAGS ${baseFlags};${extraFlags};--emitIR
-        DEPENDS ${stage2}
+        DEPENDS ${stage1}
     )
 
     # Stage 3
 
-    string(REPLACE ".ll" ".cpp.o" objFile "${llFile}")
-    add_custom_command(
-        OUTPUT ${objFile}
-        DEPENDS ${llFile}
-        COMMENT "[TS2] ${llcBin}: ${llFile}"
-        COMMAND ${CMAKE_COMMAND} -E "${PROFILER_CMD_START}" ${objFile}
-        COMMAND ${llcBin}
-            ${llFile}
-            ${ARG_OPT_LEVEL}
-            -relocation-model=pic
-            -filetype=obj
-            -mtriple ${CMAKE_CXX_COMPILER_TARGET}
-            -o ${objFile}
-        COMMAND ${CMAKE_COMMAND} -E "${PROFILER_CMD_END}" ${objFile}
-        COMMAND_EXPAND_LISTS
-    )
+    _optPipeline("${ARG_OPT_LEVEL}" passPipeline llcOptLevel)
+
+    set(irFile ${llFile})
+    set(llcFlags )
+
+    if (ARG_LTO)
+        if (NOT tsnative-std_BITCODE OR NOT llvmLinkBin)
+            message(FATAL_ERROR "LTO requires tsnative-std built with BUILD_BITCODE and tsnative-llvm-link")
+        endif()
+
+        string(REPLACE ".ll" ".lto.bc" irFile "${llFile}")
+        add_custom_command(
+            OUTPUT ${irFile}
+            DEPENDS ${llFile} ${tsnative-std_BITCODE}
+            COMMENT "[TS2] ${llvmLinkBin}: ${llFile}"
+            COMMAND ${CMAKE_COMMAND} -E "${PROFILER_CMD_START}" ${irFile}
+            COMMAND ${llvmLinkBin}
+                ${llFile}
+                ${tsnative-std_BITCODE}
+                -o ${irFile}
+            COMMAND ${CMAKE_COMMAND} -E "${PROFILER_CMD_END}" ${irFile}
+            COMMAND_EXPAND_LISTS
+            VERBATIM
+        )
+
+        # The object now defines the runtime itself: one section per symbol lets the linker
+        # drop the parts nothing refers to
+        set(llcFlags -function-sections -data-sections)
+    endif()
+
+    if (DEFINED passPipeline)
+        set(linkedFile ${irFile})
+        string(REGEX REPLACE "\\.(ll|lto\\.bc)$" ".opt.bc" irFile "${linkedFile}")
+        add_custom_command(
+            OUTPUT ${irFile}
+            DEPENDS ${linkedFile}
+            COMMENT "[TS2] ${optBin}: ${linkedFile}"
+            COMMAND ${CMAKE_COMMAND} -E "${PROFILER_CMD_START}" ${irFile}
+            COMMAND ${optBin}
+                ${linkedFile}
+                -passes=${passPipeline}
+                -o ${irFile}
+            COMMAND ${CMAKE_COMMAND} -E "${PROFILER_CMD_END}" ${irFile}
+            COMMAND_EXPAND_LISTS
+            VERBATIM
+        )
+    endif()
+
+    if (NOT ARG_CODEGEN_JOBS)
+        set(ARG_CODEGEN_JOBS 1)
+    endif()
+
+    set(codegenInputs ${irFile})
+
+    if (ARG_CODEGEN_JOBS GREATER 1)
+        if (NOT llvmSplitBin)
+            message(FATAL_ERROR "CODEGEN_JOBS requires tsnative-llvm-split")
+        endif()
+
+        # tsnative-llvm-split writes <prefix>0 ... <prefix>N-1
+        string(REPLACE ".ll" ".part" splitPrefix "${llFile}")
+        math(EXPR lastPart "${ARG_CODEGEN_JOBS} - 1")
+
+        set(codegenInputs )
+        foreach (part RANGE ${lastPart})
+            list(APPEND codegenInputs ${splitPrefix}${part})
+        endforeach()
+
+        add_custom_command(
+            OUTPUT ${codegenInputs}
+            DEPENDS ${irFile}
+            COMMENT "[TS2] ${llvmSplitBin}: ${irFile}"
+            COMMAND ${CMAKE_COMMAND} -E "${PROFILER_CMD_START}" ${splitPrefix}
+            COMMAND ${llvmSplitBin}
+                ${irFile}
+                -j=${ARG_CODEGEN_JOBS}
+                -o ${splitPrefix}
+            COMMAND ${CMAKE_COMMAND} -E "${PROFILER_CMD_END}" ${splitPrefix}
+            COMMAND_EXPAND_LISTS
+            VERBATIM
+        )
+    endif()
+
+    set(objFiles )
+    foreach (codegenInput ${codegenInputs})
+        if (codegenInput STREQUAL irFile)
+            string(REPLACE ".ll" ".cpp.o" objFile "${llFile}")
+        else()
+            set(objFile ${codegenInput}.cpp.o)
+        endif()
+
+        add_custom_command(
+            OUTPUT ${objFile}
+            DEPENDS ${codegenInput}
+            COMMENT "[TS2] ${llcBin}: ${codegenInput}"
+            COMMAND ${CMAKE_COMMAND} -E "${PROFILER_CMD_START}" ${objFile}
+            COMMAND ${llcBin}
+                ${codegenInput}
+                ${llcOptLevel}
+                ${llcFlags}
+                -relocation-model=pic
+                -filetype=obj
+                -mtriple ${CMAKE_CXX_COMPILER_TARGET}
+                -o ${objFile}
+            COMMAND ${CMAKE_COMMAND} -E "${PROFILER_CMD_END}" ${objFile}
+            COMMAND_EXPAND_LISTS
+        )
+
+        list(APPEND objFiles ${objFile})
+    endforeach()
 
     # Stage 4
 
-    add_library(${targetName} STATIC ${objFile})
+    add_library(${targetName} STATIC ${objFiles})
 
     target_link_directories(${targetName} PUBLIC ${outputDir})
-    target_link_libraries(${targetName} PUBLIC tsnative-std::tsnative-std ${stage1} ${stage2})
+    target_link_libraries(${targetName} PUBLIC tsnative-std::tsnative-std ${stage1})
+
+    if (ARG_LTO)
+        if (APPLE)
+            target_link_options(${targetName} INTERFACE -Wl,-dead_strip)
+        elseif (NOT WIN32)
+            target_link_options(${targetName} INTERFACE -Wl,--gc-sections)
+        endif()
+    endif()
 
     # main()
 
@@ -211,6 +335,35 @@ macro (_requiredArgs ...)
     endforeach()
 endmacro()
 
+#
+# Maps OPT_LEVEL to the module pass pipeline for tsnative-opt (new pass manager syntax)
+# and to the codegen level for llc, which has no size levels.
+# ARG_OUT_PASSES is left undefined if the IR should not be optimized at all.
+#
+function (_optPipeline ARG_OPT_LEVEL ARG_OUT_PASSES ARG_OUT_LLC_LEVEL)
+    if ("${ARG_OPT_LEVEL}" STREQUAL "")
+        set(ARG_OPT_LEVEL "-O0")
+    endif()
+
+    string(REGEX MATCH "^-O([0-3sz])$" _match "${ARG_OPT_LEVEL}")
+    if ("${_match}" STREQUAL "")
+        message(FATAL_ERROR "Unsupported OPT_LEVEL '${ARG_OPT_LEVEL}', expected one of -O0, -O1, -O2, -O3, -Os, -Oz")
+    endif()
+
+    set(_level ${CMAKE_MATCH_1})
+
+    if ("${_level}" STREQUAL "0")
+        unset(${ARG_OUT_PASSES} PARENT_SCOPE)
+        set(${ARG_OUT_LLC_LEVEL} -O0 PARENT_SCOPE)
+    elseif ("${_level}" MATCHES "[sz]")
+        set(${ARG_OUT_PASSES} "default<O${_level}>" PARENT_SCOPE)
+        set(${ARG_OUT_LLC_LEVEL} -O2 PARENT_SCOPE)
+    else()
+        set(${ARG_OUT_PASSES} "default<O${_level}>" PARENT_SCOPE)
+        set(${ARG_OUT_LLC_LEVEL} -O${_level} PARENT_SCOPE)
+    endif()
+endfunction()
+
 macro (_printVar var)
     message(STATUS "[TS2] ${var}=${${var}}")
 endmacro()
@@ -220,8 +373,8 @@ endmacro()
 #
 function (_add_ts_command ARG_SRC ...)
     set(options )
-    set(oneValueArgs OUTPUT)
-    set(multiValueArgs MANGLED DEMANGLED FLAGS DEPENDS)
+    set(oneValueArgs )
+    set(multiValueArgs OUTPUT MANGLED DEMANGLED FLAGS DEPENDS)
 
     cmake_parse_arguments(PARSE_ARGV 1 "ARG" "${options}" "${oneValueArgs}" "${multiValueArgs}")
 
@@ -234,8 +387,8 @@ function (_add_ts_command ARG_SRC ...)
     # Arguments
     set(flags ${ARG_FLAGS})
     set(inputFile ${ARG_SRC})
-    set(outputFile ${ARG_OUTPUT})
-    set(outputDir ${ARG_OUTPUT})
+    set(outputFiles ${ARG_OUTPUT})
+    list(GET ARG_OUTPUT 0 outputFile)
     set(mangledTable ${ARG_MANGLED})
     set(demangledTable ${ARG_DEMANGLED})
     set(dependencies ${ARG_DEPENDS})
@@ -258,19 +411,25 @@ function (_add_ts_command ARG_SRC ...)
         set(tsCompiler ${TS_COMPILER})
     endif()
 
+    # Compilations are sent to the compile server (tsnative-compiler --server <socket>) if there is one
+    if (TS_COMPILER_SERVER)
+        list(APPEND flags --connect ${TS_COMPILER_SERVER})
+    endif()
+
     add_custom_command(
-        OUTPUT ${outputFile}
+        OUTPUT ${outputFiles}
         DEPENDS ${inputFile} ${dependencies}
         COMMENT "[TS2] ${tsCompiler}: ${outputFile}"
-        COMMAND ${CMAKE_COMMAND} -E "${PROFILER_CMD_START}" ${ARG_OUTPUT}
+        COMMAND ${CMAKE_COMMAND} -E "${PROFILER_CMD_START}" ${outputFile}
         COMMAND ${CMAKE_COMMAND} -E env "${tsCompilerEnv}" ${tsCompiler}
         ARGS ${inputFile}
             --build ${outputDir}
+            --cacheDir ${outputDir}/cache
             --mangledTables "$<JOIN:${mangledTable},${commaSep}>"
             --demangledTables "$<JOIN:${demangledTable},${commaSep}>"
             "$<$<BOOL:${includeDirs}>:--includeDirs>" "$<JOIN:${includeDirs},${commaSep}>"
             "${flags}"
-        COMMAND ${CMAKE_COMMAND} -E "${PROFILER_CMD_END}" ${ARG_OUTPUT}
+        COMMAND ${CMAKE_COMMAND} -E "${PROFILER_CMD_END}" ${outputFile}
         COMMAND_EXPAND_LISTS
         VERBATIM
     )
@@ -398,28 +557,29 @@ macro (_collectWatchSources)
     endif()
 endmacro()
 
-macro (_addStage ARG_STAGE ARG_DEPENDS ARG_FILENAME ARG_FLAG)
-    set(cppFile ${outputDir}/${ARG_FILENAME})
+macro (_addStage ARG_STAGE ARG_DEPENDS ARG_FILENAMES ARG_FLAG)
+    set(cppFiles ${ARG_FILENAMES})
+    list(TRANSFORM cppFiles PREPEND ${outputDir}/)
     set(cppTarget ${ARG_STAGE})
 
-    # Generating .cpp file
+    # Generating .cpp files
 
     _add_ts_command(${mainTs}
-        OUTPUT ${cppFile}
+        OUTPUT ${cppFiles}
         MANGLED ${mangledTables}
         DEMANGLED ${demangledTables}
         FLAGS ${baseFlags};${ARG_FLAG};--templatesOutputDir;${outputDir}
         DEPENDS ${ARG_DEPENDS} ${watchSources}
     )
 
-    # Compile .cpp file
+    # Compile .cpp files
 
-    add_library(${cppTarget} STATIC ${cppFile})
+    add_library(${cppTarget} STATIC ${cppFiles})
 
     target_link_libraries(${cppTarget} PUBLIC ${libraries} tsnative-std::tsnative-std)
     set_target_properties(${cppTarget} PROPERTIES ARCHIVE_OUTPUT_DIRECTORY ${outputDir})
 
-    # Extract symbols from .cpp file
+    # Extract symbols from .cpp files
 
     _add_nm_command(${cppTarget})
 
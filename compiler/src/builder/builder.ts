@@ -2,7 +2,7 @@ import { LLVMGenerator } from "../generator";
 import * as llvm from "llvm-node";
 import * as ts from "typescript";
 import { LLVMArrayType, LLVMStructType, LLVMType } from "../llvm/type";
-import { LLVMValue } from "../llvm/value";
+import { LLVMConstantFP, LLVMConstantInt, LLVMValue } from "../llvm/value";
 
 export class FunctionMeta {
   needUnwind: boolean = false;
@@ -188,6 +188,7 @@ export class Builder {
 
   createSafeRet(value: LLVMValue) {
     this.generator.symbolTable.currentScope.deinitialize();
+    this.generator.meta.getStackFrame(this.generator.currentFunction)?.unregister();
     this.checkRet(value);
     return this.builder.createRet(value.unwrapped);
   }
@@ -254,17 +255,24 @@ export class Builder {
   createCondBr(condition: LLVMValue, 
                then: llvm.BasicBlock, 
                elseBlock: llvm.BasicBlock) {
-    if (!condition.type.isTSBoolean()) {
-      throw new Error(`Expected boolean condition, got ${condition.type.toString()}`);
+    let unboxed = condition;
+
+    // i1 comes from conditions lowered to plain comparisons, see NumericLowering
+    if (!condition.type.isIntegerType(1)) {
+      if (!condition.type.isTSBoolean()) {
+        throw new Error(`Expected boolean condition, got ${condition.type.toString()}`);
+      }
+
+      unboxed = this.generator.builtinBoolean.getUnboxed(condition);
     }
 
-    const unboxed = this.generator.builtinBoolean.getUnboxed(condition);
     const condBr = this.builder.createCondBr(unboxed.unwrapped, then, elseBlock);
     return LLVMValue.create(condBr, this.generator);
   }
 
   createRetVoid() {
     this.generator.symbolTable.currentScope.deinitialize();
+    this.generator.meta.getStackFrame(this.generator.currentFunction)?.unregister();
     this.builder.createRetVoid();
   }
 
@@ -278,6 +286,37 @@ export class Builder {
     return LLVMValue.create(alloca, this.generator);
   }
 
+  // Alloca in the entry block: it is made once per call even if asked for in a loop, and mem2reg can promote it
+  createEntryBlockAlloca(type: LLVMType) {
+    const terminator = this.generator.currentFunction.getEntryBlock()?.getTerminator();
+
+    // no terminator means the entry block is still being emitted
+    if (!terminator) {
+      return this.createAlloca(type);
+    }
+
+    return this.generator.withInsertBlockKeeping(() => {
+      this.builder.setInsertionPoint(terminator);
+      return this.createAlloca(type);
+    });
+  }
+
+  // Allocas made between save and restore live just for a call, so they do not grow the stack in a loop
+  createStackSave() {
+    const i8PtrType = LLVMType.getInt8Type(this.generator).getPointer();
+    const { fn: stackSave } = this.generator.llvm.function.create(i8PtrType, [], "llvm.stacksave");
+    return this.createSafeCall(stackSave, []);
+  }
+
+  createStackRestore(stackPointer: LLVMValue) {
+    const { fn: stackRestore } = this.generator.llvm.function.create(
+      LLVMType.getVoidType(this.generator),
+      [LLVMType.getInt8Type(this.generator).getPointer()],
+      "llvm.stackrestore"
+    );
+    this.createSafeCall(stackRestore, [stackPointer]);
+  }
+
   createBitCast(value: LLVMValue, destType: LLVMType, name?: string) {
     if (value.type.isLazyClosure() && destType.isClosure()) {
       throw new Error("Cannot bitcast lazy closure to closure");
@@ -289,18 +328,36 @@ export class Builder {
     return castedLLVMValue;
   }
 
+  // Result of '>>>' is uint32, the one of other bitwise operators is int32
   private withDoublesAsInts(
     lhs: LLVMValue,
     rhs: LLVMValue,
     generator: LLVMGenerator,
-    handler: (lhs: LLVMValue, rhs: LLVMValue) => LLVMValue
+    handler: (lhs: LLVMValue, rhs: LLVMValue) => LLVMValue,
+    isUnsignedResult = false
   ): LLVMValue {
-    lhs = generator.builder.createFPToSI(lhs, LLVMType.getInt32Type(generator));
-    rhs = generator.builder.createFPToSI(rhs, LLVMType.getInt32Type(generator));
+    const result = handler(this.createToInt32(lhs), this.createToInt32(rhs));
+    const doubleType = LLVMType.getDoubleType(generator);
+
+    return isUnsignedResult ? this.createUIToFP(result, doubleType) : this.createSIToFP(result, doubleType);
+  }
 
-    const result = handler(lhs, rhs);
+  // ECMAScript ToInt32: NaN and infinities give 0, others are truncated and wrapped modulo 2^32.
+  // fptosi of a value out of range is poison, so the value is brought into (-2^32, 2^32) by frem first:
+  // it is exact and keeps the integer part modulo 2^32
+  private createToInt32(value: LLVMValue) {
+    const zero = LLVMConstantFP.get(this.generator, 0);
+    const isFinite = this.createFCmpOEQ(this.createFSub(value, value), zero);
+    const finite = this.createSelect(isFinite, value, zero);
 
-    return generator.builder.createSIToFP(result, LLVMType.getDoubleType(generator));
+    const wrapped = this.createFRem(finite, LLVMConstantFP.get(this.generator, 2 ** 32));
+    const asInt64 = this.createFPToSI(wrapped, LLVMType.getInt64Type(this.generator));
+    return this.createIntCast(asInt64, LLVMType.getInt32Type(this.generator), true);
+  }
+
+  // Only the low five bits of a shift count are used
+  private createShiftCount(value: LLVMValue) {
+    return this.createAnd(value, LLVMConstantInt.get(this.generator, 31));
   }
 
   createFPToSI(value: LLVMValue, type: LLVMType, name?: string) {
@@ -313,6 +370,11 @@ export class Builder {
     return LLVMValue.create(casted, this.generator);
   }
 
+  createIntCast(value: LLVMValue, type: LLVMType, isSigned: boolean, name?: string) {
+    const casted = this.builder.createIntCast(value.unwrapped, type.unwrapped, isSigned, name);
+    return LLVMValue.create(casted, this.generator);
+  }
+
   createUIToFP(value: LLVMValue, type: LLVMType, name?: string) {
     const casted = this.builder.createUIToFP(value.unwrapped, type.unwrapped, name);
     return LLVMValue.create(casted, this.generator);
@@ -427,7 +489,7 @@ export class Builder {
 
   createShl(lhs: LLVMValue, rhs: LLVMValue, name?: string): LLVMValue {
     if (lhs.type.isDoubleType() && rhs.type.isDoubleType()) {
-      return this.withDoublesAsInts(lhs, rhs, this.generator, (l, r) => this.createShl(l, r, name));
+      return this.withDoublesAsInts(lhs, rhs, this.generator, (l, r) => this.createShl(l, this.createShiftCount(r), name));
     }
 
     const value = this.builder.createShl(lhs.unwrapped, rhs.unwrapped, name);
@@ -436,7 +498,14 @@ export class Builder {
 
   createLShr(lhs: LLVMValue, rhs: LLVMValue, name?: string): LLVMValue {
     if (lhs.type.isDoubleType() && rhs.type.isDoubleType()) {
-      return this.withDoublesAsInts(lhs, rhs, this.generator, (l, r) => this.createLShr(l, r, name));
+      const isUnsignedResult = true;
+      return this.withDoublesAsInts(
+        lhs,
+        rhs,
+        this.generator,
+        (l, r) => this.createLShr(l, this.createShiftCount(r), name),
+        isUnsignedResult
+      );
     }
 
     const value = this.builder.createLShr(lhs.unwrapped, rhs.unwrapped, name);
@@ -445,7 +514,7 @@ export class Builder {
 
   createAShr(lhs: LLVMValue, rhs: LLVMValue, name?: string): LLVMValue {
     if (lhs.type.isDoubleType() && rhs.type.isDoubleType()) {
-      return this.withDoublesAsInts(lhs, rhs, this.generator, (l, r) => this.createAShr(l, r, name));
+      return this.withDoublesAsInts(lhs, rhs, this.generator, (l, r) => this.createAShr(l, this.createShiftCount(r), name));
     }
 
     const value = this.builder.createAShr(lhs.unwrapped, rhs.unwrapped, name);
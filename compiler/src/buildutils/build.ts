@@ -1,7 +1,6 @@
-import * as fs from "fs";
-import * as llvm from "llvm-node";
 import * as path from "path";
-import { CommanderStatic } from "commander";
+import { Command } from "commander";
+import { writeFileIfChanged } from "./cache";
 
 export class Build {
   private replaceOrAddExtension(filename: string, extension: string): string {
@@ -10,13 +9,16 @@ export class Build {
     return filename.substr(0, pos) + extension;
   }
 
-  writeIRToFile(module: llvm.Module, targetPath: string, argv: CommanderStatic): string {
+  writeIRToFile(ir: string, targetPath: string, argv: Command): string {
     const basename = this.replaceOrAddExtension(path.basename(targetPath, ".ts"), ".ll");
 
     const outputFile = argv.build ? path.join(argv.build, path.sep, basename) : basename;
 
-    fs.writeFileSync(outputFile, module.print());
-    console.log(`${outputFile} written`);
+    if (writeFileIfChanged(outputFile, ir)) {
+      console.log(`${outputFile} written`);
+    } else {
+      console.log(`${outputFile} is up to date`);
+    }
     return outputFile;
   }
 }
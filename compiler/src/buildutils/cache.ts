@@ -0,0 +1,111 @@
+import * as crypto from "crypto";
+import * as fs from "fs";
+import * as path from "path";
+import * as ts from "typescript";
+
+// Writes 'content' only if it differs from what is already on disk.
+// Keeping the timestamp of an unchanged output lets the build system skip everything downstream of it.
+export function writeFileIfChanged(file: string, content: string) {
+  if (fs.existsSync(file) && fs.readFileSync(file).toString() === content) {
+    return false;
+  }
+
+  fs.writeFileSync(file, content);
+  return true;
+}
+
+// Content addressed cache of compiler outputs.
+// Key is a hash of every input that affects the output: the whole program text (including std declarations),
+// compiler options, symbol tables and the compiler itself. Same inputs give the same IR or instantiated templates,
+// so they are restored from disk instead of being generated again.
+export class CompilationCache {
+  private static readonly MAX_ENTRIES = 32;
+
+  private readonly cacheDir: string;
+  private readonly programHash: string;
+  private readonly inputsHash: string;
+
+  constructor(cacheDir: string, program: ts.Program, inputs: string[], flags: string[]) {
+    this.cacheDir = cacheDir;
+
+    const programHash = crypto.createHash("sha256");
+    programHash.update(JSON.stringify(program.getCompilerOptions()));
+
+    for (const sourceFile of program.getSourceFiles()) {
+      programHash.update(sourceFile.fileName);
+      programHash.update(sourceFile.text);
+    }
+
+    this.programHash = programHash.digest("hex");
+
+    const inputsHash = crypto.createHash("sha256");
+    inputsHash.update(this.programHash);
+    inputsHash.update(flags.join("\0"));
+
+    for (const input of inputs) {
+      inputsHash.update(input);
+      inputsHash.update(fs.readFileSync(input));
+    }
+
+    this.inputsHash = inputsHash.digest("hex");
+
+    fs.mkdirSync(this.cacheDir, { recursive: true });
+  }
+
+  // True if exactly this program has already passed the type check.
+  // Template instantiation stages and compilation run on the same sources, so only the first of them has to check it.
+  isTypeChecked() {
+    return this.touch(this.getEntryPath("checked", this.programHash));
+  }
+
+  markTypeChecked() {
+    fs.writeFileSync(this.getEntryPath("checked", this.programHash), "");
+    this.evict();
+  }
+
+  // Returns output cached for 'kind' (e.g. 'll', 'classes') or undefined
+  get(kind: string): string | undefined {
+    const entry = this.getEntryPath(kind, this.inputsHash);
+
+    if (!this.touch(entry)) {
+      return undefined;
+    }
+
+    return fs.readFileSync(entry).toString();
+  }
+
+  put(kind: string, content: string) {
+    fs.writeFileSync(this.getEntryPath(kind, this.inputsHash), content);
+    this.evict();
+  }
+
+  private getEntryPath(kind: string, hash: string) {
+    return path.join(this.cacheDir, `${kind}-${hash}`);
+  }
+
+  // Marks entry as recently used. Returns false if there is no such entry.
+  private touch(entry: string) {
+    if (!fs.existsSync(entry)) {
+      return false;
+    }
+
+    const now = new Date();
+    fs.utimesSync(entry, now, now);
+    return true;
+  }
+
+  // Keeps only the most recently used entries
+  private evict() {
+    const entries = fs
+      .readdirSync(this.cacheDir)
+      .map((name) => {
+        const entry = path.join(this.cacheDir, name);
+        return { entry, mtime: fs.statSync(entry).mtimeMs };
+      })
+      .sort((lhs, rhs) => rhs.mtime - lhs.mtime);
+
+    for (const { entry } of entries.slice(CompilationCache.MAX_ENTRIES)) {
+      fs.unlinkSync(entry);
+    }
+  }
+}
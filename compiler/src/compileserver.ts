@@ -0,0 +1,114 @@
+import * as fs from "fs";
+import * as net from "net";
+import * as readline from "readline";
+
+// Compile server keeps the compiler process (and everything it has loaded and parsed) alive between compilations.
+// Protocol is newline delimited JSON over a local socket (unix domain socket or windows named pipe):
+//   client -> server: { cwd: string, args: string[] }            one request per connection
+//   server -> client: { output: string } ... { exitCode: number }  output of compilation, then its result
+
+type CompileRequest = {
+  cwd: string;
+  args: string[];
+};
+
+type CompileFunction = (args: string[]) => Promise<number>;
+
+// Compilations run one at a time: they share process' cwd and stdout
+let queue: Promise<void> = Promise.resolve();
+
+function serve(socket: net.Socket, request: CompileRequest, compile: CompileFunction) {
+  const send = (message: object) => {
+    if (!socket.destroyed) {
+      socket.write(JSON.stringify(message) + "\n");
+    }
+  };
+
+  const stdoutWrite = process.stdout.write;
+  const stderrWrite = process.stderr.write;
+
+  const redirect = (chunk: string | Uint8Array) => {
+    send({ output: chunk.toString() });
+    return true;
+  };
+
+  queue = queue.then(async () => {
+    let exitCode = 1;
+
+    process.stdout.write = redirect as typeof process.stdout.write;
+    process.stderr.write = redirect as typeof process.stderr.write;
+
+    try {
+      process.chdir(request.cwd);
+      exitCode = await compile(request.args);
+    } catch (e) {
+      send({ output: (e.stack || String(e)) + "\n" });
+    } finally {
+      process.stdout.write = stdoutWrite;
+      process.stderr.write = stderrWrite;
+    }
+
+    send({ exitCode });
+    socket.end();
+  });
+}
+
+export function startCompileServer(socketPath: string, compile: CompileFunction) {
+  // socket file is left behind if previous server was killed
+  if (process.platform !== "win32" && fs.existsSync(socketPath)) {
+    fs.unlinkSync(socketPath);
+  }
+
+  const server = net.createServer((socket) => {
+    const lines = readline.createInterface({ input: socket });
+
+    lines.once("line", (line) => {
+      lines.close();
+      serve(socket, JSON.parse(line), compile);
+    });
+
+    socket.on("error", () => socket.destroy());
+  });
+
+  return new Promise<void>((resolve, reject) => {
+    server.once("error", reject);
+    server.listen(socketPath, () => {
+      console.log(`Compile server is listening on '${socketPath}'`);
+      resolve();
+    });
+  });
+}
+
+// Returns exit code of compilation or undefined if there is no server at 'socketPath'
+export function connectToCompileServer(socketPath: string, args: string[]) {
+  return new Promise<number | undefined>((resolve) => {
+    let connected = false;
+    let exitCode: number | undefined;
+
+    const socket = net.createConnection(socketPath, () => {
+      connected = true;
+
+      const request: CompileRequest = { cwd: process.cwd(), args };
+      socket.write(JSON.stringify(request) + "\n");
+    });
+
+    readline.createInterface({ input: socket }).on("line", (line) => {
+      const message = JSON.parse(line);
+
+      if (message.output !== undefined) {
+        process.stdout.write(message.output);
+      } else if (message.exitCode !== undefined) {
+        exitCode = message.exitCode;
+      }
+    });
+
+    socket.on("error", (e) => {
+      if (connected) {
+        console.error(`Connection to compile server is lost: ${e.message}`);
+      }
+    });
+
+    // server that dropped connection without result is as good as a failed compilation
+    socket.on("close", () => resolve(connected ? exitCode ?? 1 : undefined));
+  });
+}
@@ -10,6 +10,7 @@ import { Declaration } from "../ts/declaration";
 import { LLVMType } from "../llvm/type";
 import { CXXForwardsDeclarator } from "./cxxforwardsdeclarator";
 import { Scope } from "../scope";
+import { writeFileIfChanged } from "../buildutils/cache";
 
 export class TemplateInstantiator {
   private readonly sources: ts.SourceFile[];
@@ -17,9 +18,13 @@ export class TemplateInstantiator {
   private readonly includeDirs: string[] = [];
 
   private generatedContent: string[] = [];
+  // Classes instantiated by the current run, see 'instantiateAll'
+  private readonly pendingClasses = new Set<string>();
 
-  private readonly INSTANTIATED_FUNCTIONS_FILE: string;
-  private readonly INSTANTIATED_CLASSES_FILE: string;
+  static readonly INSTANTIATED_FUNCTIONS_FILE = "instantiated_functions.cpp";
+  static readonly INSTANTIATED_CLASSES_FILE = "instantiated_classes.cpp";
+
+  private readonly templateInstancesPath: string;
 
   constructor(
     program: ts.Program,
@@ -64,8 +69,7 @@ export class TemplateInstantiator {
 
     this.includeDirs = includeDirs;
 
-    this.INSTANTIATED_FUNCTIONS_FILE = path.join(templateInstancesPath, "instantiated_functions.cpp");
-    this.INSTANTIATED_CLASSES_FILE = path.join(templateInstancesPath, "instantiated_classes.cpp");
+    this.templateInstancesPath = templateInstancesPath;
   }
 
   private instantiateIteratorResult(type: TSType) {
@@ -246,16 +250,7 @@ export class TemplateInstantiator {
     const visitor = this.withTypesMapFromTypesProviderForNode(call, (typesMap: Map<string, TSType>) => {
       const argumentTypes = computeArgumentTypes(typesMap);
 
-      const maybeExists = CXXSymbols().getOrCreate(cppArrayType).filter((s) => s.demangled.includes(cppArrayType + "::" + methodName));
-
-      const exists = maybeExists.some((symbol) => {
-        return (
-          ExternalSymbolsProvider.extractParameterTypes(symbol.demangled) ===
-          ExternalSymbolsProvider.unqualifyParameters(argumentTypes)
-        );
-      });
-
-      if (exists) {
+      if (this.isMethodInstantiated(cppArrayType, methodName, argumentTypes, methodDeclaration)) {
         return;
       }
 
@@ -293,6 +288,29 @@ export class TemplateInstantiator {
     });
   }
 
+  private isMethodInstantiated(
+    cppClassType: string,
+    methodName: string,
+    argumentTypes: string[],
+    methodDeclaration: Declaration
+  ) {
+    // Explicit instantiation of a class instantiates all of its members except member templates
+    if (this.pendingClasses.has(cppClassType) && !methodDeclaration.typeParameters?.length) {
+      return true;
+    }
+
+    const maybeExists = CXXSymbols()
+      .getByName(methodName)
+      .filter((s) => s.demangled.includes(cppClassType + "::" + methodName));
+
+    return maybeExists.some((symbol) => {
+      return (
+        ExternalSymbolsProvider.extractParameterTypes(symbol.demangled) ===
+        ExternalSymbolsProvider.unqualifyParameters(argumentTypes)
+      );
+    });
+  }
+
   private handleArrayMethods(node: ts.CallExpression) {
     if (!ts.isPropertyAccessExpression(node.expression)) {
       throw new Error(`Expected PropertyAccessExpression, got '${ts.SyntaxKind[node.expression.kind]}'`);
@@ -350,15 +368,7 @@ export class TemplateInstantiator {
       }
     }
 
-    const maybeExists = CXXSymbols().getOrCreate(cppArrayType).filter((s) => s.demangled.includes(cppArrayType + "::" + methodName));
-    const exists = maybeExists.some((symbol) => {
-      return (
-        ExternalSymbolsProvider.extractParameterTypes(symbol.demangled) ===
-        ExternalSymbolsProvider.unqualifyParameters(argumentTypes)
-      );
-    });
-
-    if (!exists) {
+    if (!this.isMethodInstantiated(cppArrayType, methodName, argumentTypes, methodDeclaration)) {
       const templateSignature =
         "template " + cppReturnType + " " + cppArrayType + "::" + methodName + "(" + argumentTypes.join(", ") + ");"; // @todo: constness handling
       this.generatedContent.push(templateSignature);
@@ -478,7 +488,7 @@ export class TemplateInstantiator {
     return flatten(includes).filter((filename) => filename.endsWith(".h"));
   }
 
-  private handleInstantiated(source: string) {
+  private handleInstantiated(filename: string) {
     this.generatedContent = this.generatedContent.filter((s, idx) => this.generatedContent.indexOf(s) === idx);
 
     const forwardDeclarations = new CXXForwardsDeclarator(this.generatedContent).createForwardDeclarations();
@@ -489,9 +499,11 @@ export class TemplateInstantiator {
       this.generatedContent.unshift(`#include "${include}"`);
     }
 
-    fs.writeFileSync(source, this.generatedContent.join("\n"));
+    const content = this.generatedContent.join("\n");
+    writeFileIfChanged(path.join(this.templateInstancesPath, filename), content);
 
     this.generatedContent = [];
+    return content;
   }
 
   mapNodeVisitor(node: ts.Node) {
@@ -548,14 +560,17 @@ export class TemplateInstantiator {
     );
   }
 
-  instantiateClasses() {
+  private collectClasses() {
     for (const sourceFile of this.sources) {
       sourceFile.forEachChild(this.arrayNodeVisitor.bind(this));
       sourceFile.forEachChild(this.mapNodeVisitor.bind(this));
       sourceFile.forEachChild(this.setNodeVisitor.bind(this));
     }
+  }
 
-    return this.handleInstantiated(this.INSTANTIATED_CLASSES_FILE);
+  instantiateClasses() {
+    this.collectClasses();
+    return this.handleInstantiated(TemplateInstantiator.INSTANTIATED_CLASSES_FILE);
   }
 
   instantiateFunctions() {
@@ -563,6 +578,24 @@ export class TemplateInstantiator {
       sourceFile.forEachChild(this.methodsVisitor.bind(this));
     }
 
-    return this.handleInstantiated(this.INSTANTIATED_FUNCTIONS_FILE);
+    return this.handleInstantiated(TemplateInstantiator.INSTANTIATED_FUNCTIONS_FILE);
+  }
+
+  // Classes and functions by the same instance, so the program is type checked and declarations are handled once.
+  // Members of the classes instantiated here are known to exist without waiting for their symbols to be extracted.
+  instantiateAll() {
+    this.collectClasses();
+
+    for (const line of this.generatedContent) {
+      const instance = /^template class (.+);$/.exec(line);
+      if (instance) {
+        this.pendingClasses.add(instance[1]);
+      }
+    }
+
+    const classes = this.handleInstantiated(TemplateInstantiator.INSTANTIATED_CLASSES_FILE);
+    const functions = this.instantiateFunctions();
+
+    return { classes, functions };
   }
 }
@@ -1,6 +1,6 @@
 import { ExpressionHandlerChain } from "../handlers/expression";
 import { NodeHandlerChain } from "../handlers/node";
-import { Scope, SymbolTable, Environment, addClassScope } from "../scope";
+import { Scope, SymbolTable, Environment, addClassScope, StackFrame } from "../scope";
 import * as llvm from "llvm-node";
 import * as ts from "typescript";
 import { BuiltinTSClosure, BuiltinIteratorResult, BuiltinNumber, BuiltinBoolean } from "../tsbuiltins";
@@ -90,8 +90,10 @@ export class LLVMGenerator {
     this.runtime.initGlobalState();
     this.ts.null.init();
     this.ts.undef.init();
+    this.ts.union.initConstants();
     this.builtinNumber.initNan();
     this.builtinNumber.initInfinity();
+    this.builtinBoolean.initConstants();
   }
 
   createModule(): llvm.Module {
@@ -108,6 +110,7 @@ export class LLVMGenerator {
     this.builder.setInsertionPoint(entryBlock);
 
     this.initGlobalConstants();
+    StackFrame.enterWithoutSlots(this);
 
     if (dbg) {
       dbg.emitMainScope(main.unwrapped as llvm.Function);
@@ -118,6 +121,8 @@ export class LLVMGenerator {
     const result = this.runtime.getLoop().run().asLLVMInteger();
     this.builder.createSafeRet(result);
 
+    this.ts.str.emitLiterals();
+
     if (dbg) {
       dbg.emitProcedureEnd(main.unwrapped as llvm.Function);
       dbg.finalize();
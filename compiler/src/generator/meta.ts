@@ -1,7 +1,8 @@
 import * as crypto from "crypto";
 import * as ts from "typescript";
+import * as llvm from "llvm-node";
 
-import { Environment } from "../scope";
+import { Environment, StackFrame } from "../scope";
 import { TSType } from "../ts/type";
 import { LLVMValue } from "../llvm/value";
 import { Declaration } from "../ts/declaration";
@@ -23,6 +24,14 @@ class FixedArgsCountStorage {
   readonly storage = new Map<number, number>();
 }
 
+class DirectFunctionStorage {
+  readonly storage = new Map<ts.Declaration, LLVMValue>();
+}
+
+class StackFrameStorage {
+  readonly storage = new Map<string, StackFrame>();
+}
+
 class SuperCallTracker {
   value = false;
 }
@@ -33,6 +42,8 @@ export class MetaInfoStorage {
   private readonly superCallTracker = new SuperCallTracker();
   private readonly classDeclarationTypeMapper = new ClassDeclarationTypeMapperStorage();
   private readonly fixedArgs = new FixedArgsCountStorage();
+  private readonly directFunctions = new DirectFunctionStorage();
+  private readonly stackFrames = new StackFrameStorage();
   private currentClassDeclaration: Declaration | undefined;
 
   registerClosureParameter(parentFunction: string, closureParameter: string, closureFunctionDeclaration: Declaration) {
@@ -90,6 +101,24 @@ export class MetaInfoStorage {
     return count;
   }
 
+  // Variant of function declaration that gets parameters as LLVM arguments, see FunctionDeclarationHandler
+  registerDirectFunction(declaration: Declaration, fn: LLVMValue) {
+    this.directFunctions.storage.set(declaration.unwrapped, fn);
+  }
+
+  getDirectFunction(declaration: Declaration) {
+    return this.directFunctions.storage.get(declaration.unwrapped);
+  }
+
+  // Functions are keyed by their (unique) names: llvm-node wraps the same function into different objects
+  registerStackFrame(fn: llvm.Function, frame: StackFrame) {
+    this.stackFrames.storage.set(fn.name, frame);
+  }
+
+  getStackFrame(fn: llvm.Function) {
+    return this.stackFrames.storage.get(fn.name);
+  }
+
   registerClassTypeMapper(declaration: Declaration, mapper: GenericTypeMapper) {
     this.classDeclarationTypeMapper.storage.set(declaration.unwrapped, mapper);
   }
@@ -26,7 +26,7 @@ export class DummyArgumentsCreator {
           nullArg = this.generator.ts.union.create();
         }
 
-        const nullArgPtrPtr = this.generator.gc.allocate(nullArg.type);
+        const nullArgPtrPtr = this.generator.gc.allocateTraced(nullArg.type);
         this.generator.builder.createSafeStore(nullArg, nullArgPtrPtr);
 
         return nullArgPtrPtr;
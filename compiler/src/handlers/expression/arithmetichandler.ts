@@ -2,10 +2,20 @@ import * as ts from "typescript";
 import { AbstractExpressionHandler } from "./expressionhandler";
 import { Environment } from "../../scope";
 import { LLVMValue } from "../../llvm/value";
+import { NumericLowering } from "../numericlowering";
 
 export class ArithmeticHandler extends AbstractExpressionHandler {
   handle(expression: ts.Expression, env?: Environment): LLVMValue | undefined {
     if (ts.isBinaryExpression(expression) && this.canHandle(expression)) {
+      const numericLowering = new NumericLowering(this.generator);
+      if (numericLowering.isArithmetic(expression)) {
+        return numericLowering.handleBoxed(expression, env);
+      }
+
+      if (this.isStringConcatenationChain(expression)) {
+        return this.handleStringConcatenationChain(expression, env);
+      }
+
       this.generator.emitLocation(expression.left);
       this.generator.emitLocation(expression.right);
       const left = this.generator.handleExpression(expression.left, env).derefToPtrLevel1();
@@ -34,6 +44,51 @@ export class ArithmeticHandler extends AbstractExpressionHandler {
     return;
   }
 
+  // a + b + c... of at least three operands that produces a string
+  private isStringConcatenationChain(expression: ts.BinaryExpression) {
+    const left = NumericLowering.skipParentheses(expression.left);
+
+    return (
+      this.isStringConcatenation(expression) &&
+      ts.isBinaryExpression(left) &&
+      this.isStringConcatenation(left)
+    );
+  }
+
+  private isStringConcatenation(expression: ts.BinaryExpression) {
+    return (
+      expression.operatorToken.kind === ts.SyntaxKind.PlusToken &&
+      this.generator.ts.checker.getTypeAtLocation(expression).isString()
+    );
+  }
+
+  // Chain is concatenated at once instead of a new string for every '+'.
+  // Conversions keep the order of left-associative '+': the first two operands are evaluated before either of them
+  // is converted, every further operand is converted right after its evaluation
+  private handleStringConcatenationChain(expression: ts.BinaryExpression, env?: Environment) {
+    const operands: ts.Expression[] = [];
+
+    let current: ts.Expression = expression;
+    while (ts.isBinaryExpression(current) && this.isStringConcatenation(current)) {
+      operands.unshift(current.right);
+      current = NumericLowering.skipParentheses(current.left);
+    }
+    operands.unshift(current);
+
+    const evaluate = (operand: ts.Expression) => {
+      this.generator.emitLocation(operand);
+      return this.generator.handleExpression(operand, env);
+    };
+
+    const [first, second] = [evaluate(operands[0]), evaluate(operands[1])];
+    const parts = [this.generator.ts.str.coerce(first), this.generator.ts.str.coerce(second)];
+    for (const operand of operands.slice(2)) {
+      parts.push(this.generator.ts.str.coerce(evaluate(operand)));
+    }
+
+    return this.generator.ts.str.createConcatAll(parts);
+  }
+
   private canHandle(expression: ts.BinaryExpression) {
     switch (expression.operatorToken.kind) {
       case ts.SyntaxKind.PlusToken:
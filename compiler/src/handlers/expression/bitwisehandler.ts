@@ -2,12 +2,18 @@ import * as ts from "typescript";
 import { AbstractExpressionHandler } from "./expressionhandler";
 import { Environment } from "../../scope";
 import { LLVMValue } from "../../llvm/value";
+import { NumericLowering } from "../numericlowering";
 
 export class BitwiseHandler extends AbstractExpressionHandler {
   handle(expression: ts.Expression, env?: Environment): LLVMValue | undefined {
     if (ts.isBinaryExpression(expression) && this.canHandle(expression)) {
       const binaryExpression = expression as ts.BinaryExpression;
 
+      const numericLowering = new NumericLowering(this.generator);
+      if (numericLowering.isArithmetic(binaryExpression)) {
+        return numericLowering.handleBoxed(binaryExpression, env);
+      }
+
       this.generator.emitLocation(binaryExpression.left);
       this.generator.emitLocation(binaryExpression.right);
 
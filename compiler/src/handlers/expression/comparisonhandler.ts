@@ -2,10 +2,15 @@ import * as ts from "typescript";
 import { AbstractExpressionHandler } from "./expressionhandler";
 import { Environment } from "../../scope";
 import { LLVMValue } from "../../llvm/value";
+import { NumericLowering } from "../numericlowering";
 
 export class ComparisonHandler extends AbstractExpressionHandler {
   handle(expression: ts.Expression, env?: Environment): LLVMValue | undefined {
     if (ts.isBinaryExpression(expression) && this.canHandle(expression)) {
+      const numericLowering = new NumericLowering(this.generator);
+      if (numericLowering.isComparison(expression)) {
+        return numericLowering.handleBoxed(expression, env);
+      }
 
       this.generator.emitLocation(expression.left);
       this.generator.emitLocation(expression.right);
@@ -0,0 +1,66 @@
+import * as ts from "typescript";
+import { AbstractExpressionHandler } from "./expressionhandler";
+import { Environment } from "../../scope";
+import { LLVMConstantFP, LLVMValue } from "../../llvm/value";
+import { ConstantValue } from "../../ts/constantfolding";
+
+// Emits compound expressions known at compile time (see ConstantFolding) as their values.
+// Literals and identifiers are left to their own handlers: there is nothing to fold there
+export class ConstantHandler extends AbstractExpressionHandler {
+  handle(expression: ts.Expression, env?: Environment): LLVMValue | undefined {
+    const value = this.isFoldable(expression) ? this.generator.ts.constants.evaluate(expression) : undefined;
+
+    if (value !== undefined && this.hasTypeOf(expression, value)) {
+      this.generator.emitLocation(expression);
+      return this.createConstant(value);
+    }
+
+    if (this.next) {
+      return this.next.handle(expression, env);
+    }
+
+    return;
+  }
+
+  private isFoldable(expression: ts.Expression) {
+    return (
+      ts.isBinaryExpression(expression) ||
+      ts.isPrefixUnaryExpression(expression) ||
+      ts.isTemplateExpression(expression) ||
+      ts.isConditionalExpression(expression) ||
+      ts.isPropertyAccessExpression(expression) ||
+      ts.isCallExpression(expression)
+    );
+  }
+
+  // Representation of the expression is chosen by its type, e.g. 'flag || "default"' is a union
+  private hasTypeOf(expression: ts.Expression, value: ConstantValue) {
+    const type = this.generator.ts.checker.getTypeAtLocation(expression);
+
+    if (type.isEnum()) {
+      return false;
+    }
+
+    switch (typeof value) {
+      case "number":
+        return type.isNumber();
+      case "string":
+        return type.isString();
+      default:
+        return type.isBoolean();
+    }
+  }
+
+  // Strings and booleans are immutable and shared. Numbers may be changed in place (e.g. by '++'), so every
+  // evaluation boxes its own one; the value is still a constant for LLVM
+  private createConstant(value: ConstantValue) {
+    switch (typeof value) {
+      case "number":
+        return this.generator.builtinNumber.create(LLVMConstantFP.get(this.generator, value));
+      case "string":
+        return this.generator.ts.str.create(value);
+      default:
+        return this.generator.builtinBoolean.getConstant(value);
+    }
+  }
+}
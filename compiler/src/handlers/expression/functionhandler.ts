@@ -6,6 +6,7 @@ import {
   Scope,
   Environment,
   createEnvironment,
+  StackFrame,
 } from "../../scope";
 import * as llvm from "llvm-node";
 import * as ts from "typescript";
@@ -24,11 +25,16 @@ import { getInvocableBody, needUnwind } from "../../builder/builder";
 import { TSSymbol } from "../../ts/symbol";
 import { DummyArgumentsCreator } from "../dummyargumentscreator";
 import { VariableFinder } from "../variablefinder"
+import { DirectlyCallable } from "../../ts/classhierarchy";
+import { NumericLowering } from "../numericlowering";
 
 export class FunctionHandler extends AbstractExpressionHandler {
   private readonly sysVFunctionHandler: SysVFunctionHandler;
   private readonly dummyArgsCreator: DummyArgumentsCreator;
 
+  // Methods compiled for direct calls, see handleDirectCall. Keyed by method's qualified name and environment layout.
+  private readonly directCallTargets = new Map<string, LLVMValue>();
+
   constructor(generator: LLVMGenerator) {
     super(generator);
     this.sysVFunctionHandler = new SysVFunctionHandler(generator);
@@ -483,7 +489,9 @@ export class FunctionHandler extends AbstractExpressionHandler {
       environmentVariables,
       this.generator,
       { args: dummyArguments, signature },
-      outerEnv
+      outerEnv,
+      undefined,
+      /* for closure = */ !declaration.typeParameters
     );
 
     if (declaration.typeParameters) {
@@ -544,6 +552,11 @@ export class FunctionHandler extends AbstractExpressionHandler {
     if (!valueDeclaration.isStatic()) {
       const thisValue = this.generator.handleExpression(expression.expression, outerEnv).derefToPtrLevel1();
 
+      const directTarget = this.getDirectCallTarget(expression, 0);
+      if (directTarget) {
+        return this.handleDirectCall(expression, directTarget, thisValue, []);
+      }
+
       const key = valueDeclaration.name.getText() + "__get";
 
       let getterClosure = this.generator.ts.obj.get(thisValue, key);
@@ -860,6 +873,11 @@ export class FunctionHandler extends AbstractExpressionHandler {
       return this.handleStaticMethodCall(expression, signature, valueDeclaration, qualifiedName, outerEnv);
     }
 
+    const directFunction = this.generator.meta.getDirectFunction(valueDeclaration);
+    if (directFunction && ts.isIdentifier(expression.expression)) {
+      return this.handleDirectFunctionCall(expression, valueDeclaration, directFunction, outerEnv);
+    }
+
     const functionToCallPtrPtr = this.generator.handleExpression(expression.expression, outerEnv);
     let functionToCall = functionToCallPtrPtr.derefToPtrLevel1();
     if (functionToCall.type.isUnion()) {
@@ -951,6 +969,11 @@ export class FunctionHandler extends AbstractExpressionHandler {
     }, this.generator.symbolTable.currentScope);
 
 
+    const directTarget = this.getDirectCallTarget(propertyAccessExpression, args.length);
+    if (directTarget) {
+      return this.handleDirectCall(callExpression, directTarget, object, args);
+    }
+
     const methodName = propertyAccessExpression.name.getText();
     let closure = this.generator.ts.obj.get(object, methodName);
     const methodSymbol = objectType.getProperty(methodName);
@@ -964,6 +987,159 @@ export class FunctionHandler extends AbstractExpressionHandler {
     return this.handleTSClosureCall(callExpression, signature, args, closure);
   }
 
+  // Method (or getter) that is the only possible target of the call according to class hierarchy analysis
+  private getDirectCallTarget(expression: ts.PropertyAccessExpression, argumentsCount: number) {
+    if (this.generator.meta.inSuperCall()) {
+      return undefined;
+    }
+
+    const target = this.generator.ts.classHierarchy.getMonomorphicTarget(expression);
+
+    if (!target || target.parameters.length !== argumentsCount) {
+      return undefined;
+    }
+
+    // environment of directly called method is built from its source file's scope, not from the call site's one
+    if (!this.generator.symbolTable.getScope(target.getSourceFile().fileName)) {
+      return undefined;
+    }
+
+    return Declaration.create(target, this.generator);
+  }
+
+  // Calls a method without taking its closure from the object. Method is compiled into a standalone function
+  // (like static methods are) that gets 'this' and arguments in environment created right here, on the stack
+  // unless the method has nested functions that may keep it.
+  private handleDirectCall(
+    expression: ts.CallExpression | ts.PropertyAccessExpression,
+    method: Declaration,
+    thisValue: LLVMValue,
+    args: LLVMValue[]
+  ) {
+    const classDeclaration = Declaration.create(method.parent as ts.ClassLikeDeclaration, this.generator);
+    const thisType = classDeclaration.type;
+
+    const signature = this.generator.ts.checker.getSignatureFromDeclaration(method);
+
+    // same adjustment as closures get in handleTSClosureCall
+    const adjustedArgs = signature.getDeclaredParameters().map((parameter, index) => {
+      const type = this.generator.ts.checker.getTypeAtLocation(parameter).getLLVMType();
+      const arg = args[index];
+
+      return !arg.type.equals(type) && type.isUnion() ? this.generator.ts.union.create(arg) : arg;
+    });
+
+    const fileScope = this.generator.symbolTable.getScope(method.unwrapped.getSourceFile().fileName)!;
+
+    return this.generator.symbolTable.withLocalScope((scope: Scope) => {
+      const makeRoot = false;
+      const thisValueTyped = this.generator.builder.createBitCast(thisValue, thisType.getLLVMType());
+      scope.set(this.generator.internalNames.This, thisValueTyped, makeRoot);
+
+      const body = ConciseBody.create(method.body!, this.generator);
+      const environmentVariables = body.getEnvironmentVariables(signature, scope);
+      if (!environmentVariables.includes(this.generator.internalNames.This)) {
+        environmentVariables.push(this.generator.internalNames.This);
+      }
+
+      const onStack = this.generator.ts.classHierarchy.hasNoCaptures(method.unwrapped as DirectlyCallable);
+      const env = createEnvironment(
+        scope,
+        environmentVariables,
+        this.generator,
+        { args: adjustedArgs, signature },
+        undefined,
+        undefined,
+        undefined,
+        onStack
+      );
+
+      let tsReturnType = signature.getReturnType();
+      if (tsReturnType.isThisType()) {
+        tsReturnType = thisType;
+      }
+      const llvmReturnType = tsReturnType.getLLVMReturnType();
+
+      const { qualifiedName } = FunctionMangler.mangle(method, undefined, thisType, [], this.generator);
+      const key = `${qualifiedName}:${env.type.toString()}:${env.variables.join(",")}`;
+
+      let fn = this.directCallTargets.get(key);
+      if (!fn) {
+        fn = this.generator.llvm.function.create(
+          llvmReturnType,
+          [env.voidStar],
+          qualifiedName + "__direct__" + this.generator.randomString
+        ).fn;
+
+        FunctionHandler.handleFunctionBody(method, fn, this.generator, env);
+        LLVMFunction.verify(fn, expression);
+
+        this.directCallTargets.set(key, fn);
+      }
+
+      const callResult = this.invoke(expression, method.body, fn, [env.untyped]);
+
+      const resolvedReturnType = this.generator.ts.checker.getTypeAtLocation(expression);
+      if (!resolvedReturnType.isSupported()) {
+        return callResult;
+      }
+
+      return this.generator.builder.createBitCast(callResult, resolvedReturnType.getLLVMReturnType());
+    }, fileScope);
+  }
+
+  // Calls variant of function declaration that gets parameters as LLVM arguments (see FunctionDeclarationHandler).
+  // Closure is only used to get environment with captured variables from.
+  private handleDirectFunctionCall(
+    expression: ts.CallExpression,
+    valueDeclaration: Declaration,
+    fn: LLVMValue,
+    outerEnv?: Environment
+  ) {
+    const closure = this.generator.handleExpression(expression.expression, outerEnv).derefToPtrLevel1();
+    const environment = this.generator.builder.createSafeCall(this.generator.tsclosure.getLLVMGetEnvironment(), [
+      this.generator.builder.createBitCast(closure, this.generator.tsclosure.getLLVMType()),
+    ]);
+
+    const numericLowering = new NumericLowering(this.generator);
+    const fnArguments = (fn.unwrapped as llvm.Function).getArguments();
+
+    const args = expression.arguments.map((argument, index) => {
+      let value = this.generator.handleExpression(argument, outerEnv).derefToPtrLevel1();
+
+      // mimics 'value' semantic for primitives; result of arithmetic and a loop counter read are fresh values
+      // nobody else refers to
+      const isFreshValue =
+        (ts.isBinaryExpression(argument) && numericLowering.isArithmetic(argument)) ||
+        (ts.isIdentifier(argument) && Boolean(this.generator.ts.inductionVariables.getCell(argument)));
+      if (value.isTSPrimitivePtr() && !isFreshValue) {
+        value = value.clone();
+      }
+
+      const parameterType = LLVMType.make(fnArguments[index + 1].type, this.generator);
+
+      if (parameterType.isUnion() && !value.type.isUnion()) {
+        value = this.generator.ts.union.create(value);
+      } else if (value.type.isUnion() && !parameterType.isUnion()) {
+        value = this.generator.ts.union.get(value);
+      }
+
+      return this.generator.builder.createBitCast(value, parameterType);
+    });
+
+    const callResult = this.invoke(expression, valueDeclaration.body, fn, [
+      this.generator.builder.asVoidStar(environment),
+      ...args,
+    ]);
+
+    const resolvedReturnType = this.generator.ts.checker.getTypeAtLocation(expression);
+    if (!resolvedReturnType.isSupported()) {
+      return callResult;
+    }
+
+    return this.generator.builder.createBitCast(callResult, resolvedReturnType.getLLVMReturnType());
+  }
+
   private handleStaticMethodCall(expression: ts.CallExpression, signature: Signature, valueDeclaration: Declaration, qualifiedName: string, outerEnv?: Environment) {
     const args = this.generator.symbolTable.withLocalScope((localScope: Scope) => {
       return this.handleCallArguments(expression, signature, localScope, outerEnv);
@@ -1118,9 +1294,11 @@ export class FunctionHandler extends AbstractExpressionHandler {
 
     const arrayType = lastParameter.valueDeclaration!.type;
 
-    let arrayPtr = this.generator.gc.allocateObject(this.generator.ts.array.getLLVMType().getPointerElementType());
+    const arrayPtr = this.generator.gc.allocateObject(this.generator.ts.array.getLLVMType().getPointerElementType());
     this.generator.ts.array.callDefaultConstructor(this.generator.builder.asVoidStar(arrayPtr), arrayType);
 
+    const elements: { value: LLVMValue; isSpread: boolean }[] = [];
+
     for (let i = restArgumentsStartIndex; i < args.length; ++i) {
       const arg = args[i];
       const isSpread = ts.isSpreadElement(arg);
@@ -1128,19 +1306,16 @@ export class FunctionHandler extends AbstractExpressionHandler {
       const expr = isSpread ? (arg as ts.SpreadElement).expression : arg;
       let value = this.generator.handleExpression(expr, outerEnv).derefToPtrLevel1();
 
-      if (value.type.isArray()) {
-        arrayPtr = value;
-        continue;
-      }
-
-      if (value.isTSPrimitivePtr()) {
+      if (!isSpread && value.isTSPrimitivePtr()) {
         // mimics 'value' semantic for primitives
         value = value.clone();
       }
 
-      this.generator.ts.array.callPush(arrayType, arrayPtr, value, isSpread);
+      elements.push({ value, isSpread });
     }
 
+    this.generator.ts.array.callPushArguments(arrayType, arrayPtr, elements);
+
     scope.set(lastParameter.escapedName.toString(), arrayPtr);
     return arrayPtr;
   }
@@ -1335,12 +1510,14 @@ export class FunctionHandler extends AbstractExpressionHandler {
       throw new Error(`Expected hoisted variable '${variableName}' should be LLVMValue with ** inside`);
     }
 
-    let hoisted = this.generator.builder.createLoad(hoistedPtrPtr);
-    if (hoisted.type.isUnion()) {
-      this.generator.ts.union.set(hoisted, this.generator.ts.obj.create());
-      hoisted = this.generator.ts.union.get(hoisted);
+    const hoistedType = hoistedPtrPtr.type.getPointerElementType();
+    if (hoistedType.isUnion()) {
+      const placeholder = this.generator.ts.obj.create();
+      this.generator.builder.createSafeStore(this.generator.ts.union.create(placeholder), hoistedPtrPtr);
+      return placeholder;
     }
 
+    const hoisted = this.generator.builder.createLoad(hoistedPtrPtr);
     return this.generator.builder.createBitCast(hoisted, this.generator.ts.obj.getLLVMType());
   }
 
@@ -1395,7 +1572,15 @@ export class FunctionHandler extends AbstractExpressionHandler {
         outerEnv
       );
 
-      const env = createEnvironment(parentScope, environmentVariables, this.generator, undefined, outerEnv);
+      const env = createEnvironment(
+        parentScope,
+        environmentVariables,
+        this.generator,
+        undefined,
+        outerEnv,
+        undefined,
+        /* for closure = */ true
+      );
 
       const tsReturnType = signature.getReturnType();
       const llvmReturnType = tsReturnType.getLLVMReturnType();
@@ -1521,7 +1706,9 @@ export class FunctionHandler extends AbstractExpressionHandler {
         args: dummyArguments,
         signature,
       },
-      outerEnv
+      outerEnv,
+      undefined,
+      /* for closure = */ !declaration.typeParameters
     );
 
     if (declaration.typeParameters) {
@@ -1561,7 +1748,14 @@ export class FunctionHandler extends AbstractExpressionHandler {
     return result;
   }
 
-  public static handleFunctionBody(declaration: Declaration, fn: LLVMValue, generator: LLVMGenerator, env?: Environment) {
+  // 'parameterNames' are given if parameters are passed as LLVM arguments following the environment
+  public static handleFunctionBody(
+    declaration: Declaration,
+    fn: LLVMValue,
+    generator: LLVMGenerator,
+    env?: Environment,
+    parameterNames?: string[]
+  ) {
     const dbg = generator.getDebugInfo();
     generator.withInsertBlockKeeping(() => {
       return generator.symbolTable.withLocalScope(
@@ -1581,6 +1775,22 @@ export class FunctionHandler extends AbstractExpressionHandler {
                 dbg.emitLocation(declaration?.body);
               }
 
+              const frame = StackFrame.enter(declaration.body!, parameterNames || [], generator);
+
+              if (parameterNames) {
+                const fnArguments = (fn.unwrapped as llvm.Function).getArguments();
+
+                // Every call gets its own cells in the stack frame
+                parameterNames.forEach((name, index) => {
+                  const argument = LLVMValue.create(fnArguments[index + 1], generator);
+                  const cell = frame!.getCell(name, argument.type)!;
+                  generator.builder.createSafeStore(argument, cell);
+
+                  const makeRoot = false;
+                  bodyScope.set(name, cell, makeRoot);
+                });
+              }
+
               bodyScope.initializeVariablesAndFunctionDeclarations(declaration.body!, generator);
 
               if (ts.isBlock(declaration.body!) && declaration.body!.statements.length > 0) {
@@ -1718,7 +1928,7 @@ export class FunctionHandler extends AbstractExpressionHandler {
             this.handleClassOwnMethods(expression, classDeclaration, thisValuePtr, bodyScope, environment!);
 
             if (isSuperCall) {
-              const thisValuePtrPtr = this.generator.gc.allocate(thisValuePtr.type);
+              const thisValuePtrPtr = this.generator.gc.allocateTraced(thisValuePtr.type);
               this.generator.builder.createSafeStore(thisValuePtr, thisValuePtrPtr);
               this.generator.builder.createSafeStore(thisValuePtrPtr, thisValuePtrPtrPtr);
             }
@@ -1739,7 +1949,7 @@ export class FunctionHandler extends AbstractExpressionHandler {
             }
 
             if (isSuperCall) {
-              const originalThisValuePtrPtr = this.generator.gc.allocate(originalThisValuePtr.type);
+              const originalThisValuePtrPtr = this.generator.gc.allocateTraced(originalThisValuePtr.type);
               this.generator.builder.createSafeStore(originalThisValuePtr, originalThisValuePtrPtr);
               this.generator.builder.createSafeStore(originalThisValuePtrPtr, thisValuePtrPtrPtr);
             } else {
@@ -1853,7 +2063,9 @@ export class FunctionHandler extends AbstractExpressionHandler {
             args: dummyArguments,
             signature,
           },
-          environment
+          environment,
+          undefined,
+          /* for closure = */ true
         );
 
         let tsReturnType = signature.getReturnType();
@@ -301,7 +301,12 @@ export class SysVFunctionHandler {
     }
 
     if (parameterDeclaration.isOptional() && parameterDeclaration.type.isSupported()) {
-      return this.generator.ts.union.create(arg);
+      return this.generator.ts.union.wrap(arg);
+    }
+
+    // union values are kept unwrapped in compiled code, std takes them as Union*
+    if (arg.type.isUnion() && !parameterDeclaration.dotDotDotToken) {
+      return this.generator.ts.union.wrap(arg);
     }
 
     return this.generator.builder.asVoidStar(arg);
@@ -314,18 +319,16 @@ export class SysVFunctionHandler {
       return [];
     }
 
-    const argsToArray = this.generator.ts.array.getArgsToArrayConverter();
+    const arrayType = this.generator.ts.array.getDeclaration().type;
     const aggregatorStackArrPtr = this.generator.builder.createAlloca(this.generator.ts.array.getLLVMType().getPointerElementType());
-    this.generator.ts.array.callDefaultConstructor(aggregatorStackArrPtr, this.generator.ts.array.getDeclaration().type);
-    
-    const argsToArrayStackPtr = this.generator.builder.createAlloca(argsToArray.getLLVMType().getPointerElementType());
-    argsToArray.callConstructor(argsToArrayStackPtr, aggregatorStackArrPtr);
+    this.generator.ts.array.callDefaultConstructor(aggregatorStackArrPtr, arrayType);
 
-    for (const {argument, index} of spreadPairs) {
-      const llvmArgPtr = this.convertTSArgToLLVMArg(argument, index, declaration, outerEnv);
-      const isSpread = ts.isSpreadElement(argument);
-      argsToArray.callAddObject(argsToArrayStackPtr, llvmArgPtr, isSpread);
-    }
+    const elements = spreadPairs.map(({ argument, index }) => ({
+      value: this.convertTSArgToLLVMArg(argument, index, declaration, outerEnv),
+      isSpread: ts.isSpreadElement(argument),
+    }));
+
+    this.generator.ts.array.callPushArguments(arrayType, aggregatorStackArrPtr, elements);
 
     return [aggregatorStackArrPtr];
   }
@@ -412,7 +415,7 @@ export class SysVFunctionHandler {
         throw new Error(`Expected optional argument, got '${parameterDeclaration.getText()}'`);
       }
 
-      const value = this.generator.ts.union.create();
+      const value = this.generator.ts.union.wrap();
 
       args.push(value);
     }
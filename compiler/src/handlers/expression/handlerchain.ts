@@ -5,6 +5,7 @@ import {
   AssignmentHandler,
   BitwiseHandler,
   ComparisonHandler,
+  ConstantHandler,
   CompoundAssignmentHandler,
   FunctionHandler,
   IdentifierHandler,
@@ -33,6 +34,7 @@ export class ExpressionHandlerChain {
     this.generator = generator;
 
     noop
+      .setNext(new ConstantHandler(generator))
       .setNext(new AccessHandler(generator))
       .setNext(new ArithmeticHandler(generator))
       .setNext(new AssignmentHandler(generator))
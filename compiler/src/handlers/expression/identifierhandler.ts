@@ -38,6 +38,12 @@ export class IdentifierHandler extends AbstractExpressionHandler {
       return this.generator.ts.undef.get();
     }
 
+    // counter of a counted for-loop is a raw double, see InductionVariables
+    const counter = this.generator.ts.inductionVariables.getCell(expression);
+    if (counter) {
+      return this.generator.builtinNumber.create(this.generator.builder.createLoad(counter));
+    }
+
     let identifier = expression.getText();
     const varFinder = new VariableFinder(this.generator);
     if (env) {
@@ -4,6 +4,7 @@ export { CastHandler } from "./casthandler";
 export { AssignmentHandler } from "./assignmenthandler";
 export { BitwiseHandler } from "./bitwisehandler";
 export { ComparisonHandler } from "./comparisonhandler";
+export { ConstantHandler } from "./constanthandler";
 export { CompoundAssignmentHandler } from "./compoundhandler";
 export { FunctionHandler } from "./functionhandler";
 export { SysVFunctionHandler } from "./functionhandler_sysv";
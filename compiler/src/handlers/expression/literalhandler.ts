@@ -1,7 +1,7 @@
 import * as ts from "typescript";
 import { AbstractExpressionHandler } from "./expressionhandler";
 import { Environment } from "../../scope";
-import { LLVMConstantFP, LLVMConstantInt, LLVMValue } from "../../llvm/value";
+import { LLVMConstantFP, LLVMValue } from "../../llvm/value";
 import { TSTuple } from "../../ts/tuple";
 
 export class LiteralHandler extends AbstractExpressionHandler {
@@ -59,11 +59,7 @@ export class LiteralHandler extends AbstractExpressionHandler {
   }
 
   private handleBooleanLiteral(expression: ts.BooleanLiteral): LLVMValue {
-    const value =
-      expression.kind === ts.SyntaxKind.TrueKeyword
-        ? LLVMConstantInt.getTrue(this.generator)
-        : LLVMConstantInt.getFalse(this.generator);
-    return this.generator.builtinBoolean.createHeap(value); // Probably can be allocated on stack?
+    return this.generator.builtinBoolean.getConstant(expression.kind === ts.SyntaxKind.TrueKeyword);
   }
 
   private handleNumericLiteral(expression: ts.NumericLiteral): LLVMValue {
@@ -72,13 +68,7 @@ export class LiteralHandler extends AbstractExpressionHandler {
   }
 
   private handleStringLiteral(expression: ts.StringLiteral): LLVMValue {
-    const llvmThisType = this.generator.ts.str.getLLVMType();
-    const constructor = this.generator.ts.str.getLLVMConstructor();
-    const ptr = this.generator.builder.createGlobalStringPtr(expression.text);
-    const allocated = this.generator.gc.allocateObject(llvmThisType.getPointerElementType());
-    const thisUntyped = this.generator.builder.asVoidStar(allocated);
-    this.generator.builder.createSafeCall(constructor, [thisUntyped, ptr]);
-    return allocated;
+    return this.generator.ts.str.create(expression.text);
   }
 
   private handleObjectLiteralExpression(expression: ts.ObjectLiteralExpression, env?: Environment): LLVMValue {
@@ -156,6 +146,7 @@ export class LiteralHandler extends AbstractExpressionHandler {
     }
 
     const elementType = arrayType.getTypeGenericArguments()[0];
+    const elements: { value: LLVMValue; isSpread: boolean }[] = [];
 
     for (const element of expression.elements) {
       const isSpread = ts.isSpreadElement(element);
@@ -169,9 +160,11 @@ export class LiteralHandler extends AbstractExpressionHandler {
       //   elementValue = this.generator.ts.union.create(elementValue);
       // }
 
-      this.generator.ts.array.callPush(arrayType, arrayPtr, elementValue, isSpread);
+      elements.push({ value: elementValue, isSpread });
     }
 
+    this.generator.ts.array.callPushArguments(arrayType, arrayPtr, elements);
+
     return arrayPtr;
   }
 }
@@ -4,6 +4,7 @@ import * as llvm from "llvm-node";
 import { AbstractExpressionHandler } from "./expressionhandler";
 import { Environment } from "../../scope";
 import { LLVMValue } from "../../llvm/value";
+import { NumericLowering } from "../numericlowering";
 
 export class LogicHandler extends AbstractExpressionHandler {
   handle(expression: ts.Expression, env?: Environment): LLVMValue | undefined {
@@ -27,8 +28,7 @@ export class LogicHandler extends AbstractExpressionHandler {
     }
 
     if (ts.isConditionalExpression(expression)) {
-      const conditionValue = this.generator.handleExpression(expression.condition, env).derefToPtrLevel1();
-      const condition = conditionValue.makeBoolean().derefToPtrLevel1();
+      const condition = new NumericLowering(this.generator).handleCondition(expression.condition, env);
 
       const tsType = this.generator.ts.checker.getTypeAtLocation(expression);
 
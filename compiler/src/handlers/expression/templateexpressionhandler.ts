@@ -17,34 +17,23 @@ export class TemplateExpressionHandler extends AbstractExpressionHandler {
     return;
   }
 
+  // Template is concatenated at once: every span is converted to string once and the result is the only new string
   private handleTemplateExpression(expression: ts.TemplateExpression, env?: Environment) {
-    const stringType = this.generator.ts.str.getLLVMType();
-    const stringConstructor = this.generator.ts.str.getLLVMConstructor();
-    let allocated = this.generator.gc.allocate(stringType.getPointerElementType());
-    allocated = this.generator.builder.asVoidStar(allocated);
+    const parts: LLVMValue[] = [];
 
-    const head = this.generator.builder.createGlobalStringPtr(expression.head.rawText || "");
-    this.generator.builder.createSafeCall(stringConstructor, [allocated, head]);
+    if (expression.head.rawText) {
+      parts.push(this.generator.ts.str.create(expression.head.rawText));
+    }
 
     for (const span of expression.templateSpans) {
-      const value = this.generator.handleExpression(span.expression, env).derefToPtrLevel1();
-
-      const allocatedSpanExpression = this.generator.ts.obj.objectToString(value);
-
-      allocated = this.generator.ts.str.createConcat(allocated, allocatedSpanExpression);
+      const value = this.generator.handleExpression(span.expression, env);
+      parts.push(this.generator.ts.str.coerce(value));
 
       if (span.literal.rawText) {
-        const allocatedLiteral = this.generator.gc.allocate(stringType.getPointerElementType());
-        const literal = this.generator.builder.createGlobalStringPtr(span.literal.rawText);
-        this.generator.builder.createSafeCall(stringConstructor, [
-          this.generator.builder.asVoidStar(allocatedLiteral),
-          literal,
-        ]);
-
-        allocated = this.generator.ts.str.createConcat(allocated, allocatedLiteral);
+        parts.push(this.generator.ts.str.create(span.literal.rawText));
       }
     }
 
-    return allocated;
+    return this.generator.ts.str.createConcatAll(parts);
   }
 }
@@ -2,13 +2,14 @@ import * as ts from "typescript";
 import { AbstractNodeHandler } from "./nodehandler";
 import { Scope, Environment } from "../../scope";
 import { IfBlockCreator } from "../ifblockcreator";
+import { NumericLowering } from "../numericlowering";
 
 export class BranchHandler extends AbstractNodeHandler {
   handle(node: ts.Node, parentScope: Scope, env?: Environment): boolean {
     if (ts.isIfStatement(node)) {
       this.generator.emitLocation(node);
       const statement = node as ts.IfStatement;
-      const condition = this.generator.handleExpression(statement.expression, env).derefToPtrLevel1().makeBoolean();
+      const condition = new NumericLowering(this.generator).handleCondition(statement.expression, env);
 
       const ifBlockCreator = new IfBlockCreator(this.generator);
 
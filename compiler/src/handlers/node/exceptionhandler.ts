@@ -15,10 +15,17 @@ import { getInvocableBody, needUnwind } from "../../builder/builder";
 
 type FunctionEntry = { fn: LLVMValue; existing: boolean };
 
+// Throw from a try block of the same function: exception value and the block it comes from
+type LocalThrow = { value: llvm.Value; block: llvm.BasicBlock };
+type CatchTarget = { functionName: string; caughtBB: llvm.BasicBlock; localThrows: LocalThrow[] };
+
 /*
   ExceptionHandler class is provides exception handling via C++ Runtime realization described
   https://itanium-cxx-abi.github.io/cxx-abi/abi-eh.html
   This DWARF has implementation in LLVM https://llvm.org/docs/ExceptionHandling.html
+
+  Only exceptions that leave a function are thrown this way. Throw that is caught by a try of the same function
+  is a branch to its catch: no exception object is allocated and nothing is unwound.
 */
 
 export class ExceptionHandler extends AbstractNodeHandler {
@@ -28,7 +35,7 @@ export class ExceptionHandler extends AbstractNodeHandler {
   private static beginCatch: FunctionEntry; // __cxa_begin_catch --- LLVM ABI Itanium intrinsic
   private static endCatch: FunctionEntry; // __cxa_end_catch --- LLVM ABI Itanium intrinsic
   private static personality: FunctionEntry; // __gxx_personality_v0 -- Personality function
-  private readonly unreachableBlockName: string = "unreachable";
+  private readonly catchTargets = new Map<llvm.BasicBlock, CatchTarget>(); // by landing pad
 
   handle(node: ts.Node, parentScope: Scope, env?: Environment): boolean {
     const { builder, currentFunction, context } = this.generator;
@@ -50,6 +57,8 @@ export class ExceptionHandler extends AbstractNodeHandler {
         currentFunction
       );
       const ldPadBB = llvm.BasicBlock.create(context, "catch.body", currentFunction);
+      const caughtBB = llvm.BasicBlock.create(context, "catch.caught", currentFunction);
+      this.catchTargets.set(ldPadBB, { functionName: currentFunction.name, caughtBB, localThrows: [] });
 
       /* We will keep a stack of landing pages in order to correctly handle
          the context of the transition to the unwinding instructions
@@ -89,7 +98,14 @@ export class ExceptionHandler extends AbstractNodeHandler {
         const value = this.generator.handleExpression(node.expression, env).derefToPtrLevel1();
 
         this.generator.symbolTable.currentScope.deinitialize();
-        this.emitThrowBlock(value, node);
+
+        const catchTarget = needUnwind(node) ? this.getCatchTarget() : undefined;
+        if (catchTarget) {
+          this.emitLocalThrow(value, catchTarget);
+        } else {
+          this.generator.meta.getStackFrame(currentFunction)?.unregister();
+          this.emitThrowBlock(value, node);
+        }
       }
       return true;
     }
@@ -126,20 +142,35 @@ export class ExceptionHandler extends AbstractNodeHandler {
         "exception.slot"
       );
 
+      // frames of callees left by the exception are dropped, this one stays registered
+      this.generator.meta.getStackFrame(currentFunction)?.register();
+
+      // Value caught as 'void*' is the thrown pointer itself, so exception object is released right away.
+      // This also keeps 'return' from catch body from leaking it
+      const caughtException = builder.createSafeCall(ExceptionHandler.beginCatch.fn, [selector], "begin_catch");
+      builder.createSafeCall(ExceptionHandler.endCatch.fn, []);
+
+      const catchTarget = this.catchTargets.get(lpad)!;
+      this.catchTargets.delete(lpad);
+
+      builder.createBr(catchTarget.caughtBB);
+      builder.setInsertionPoint(catchTarget.caughtBB);
+
+      const exceptionValue = builder.unwrap().createPhi(int8PtrTy.unwrapped, catchTarget.localThrows.length + 1);
+      exceptionValue.addIncoming(caughtException.unwrapped, lpad);
+      catchTarget.localThrows.forEach(({ value, block }) => exceptionValue.addIncoming(value, block));
+
       // HACK!
       // 1. try { scope1 } catch(e) { scope 2} - e actually belongs to a scope2
       // 2. scope 2 does not exist at this point
       // 3. we know for sure than node.block will be a block hence we can call BlockHandler
       // 4. Lambda postpones creation of e to set it into scope 2
       const prepare = (): void => {
-        const exceptionValue = builder.createSafeCall(
-          ExceptionHandler.beginCatch.fn,
-          [selector],
-          "begin_catch"
-        );
-
         if (node.variableDeclaration) {
-          this.generator.symbolTable.currentScope.set(node.variableDeclaration.name.getText(), exceptionValue);
+          this.generator.symbolTable.currentScope.set(
+            node.variableDeclaration.name.getText(),
+            LLVMValue.create(exceptionValue, this.generator)
+          );
         }
       };
 
@@ -148,15 +179,36 @@ export class ExceptionHandler extends AbstractNodeHandler {
           throw new Error("Catch does not contain Block! Probably syntax error");
       }
 
-      const currentBB = this.generator.builder.getInsertBlock();
-      if (currentBB && !currentBB.getTerminator()) {
-        this.generator.builder.createSafeCall(ExceptionHandler.endCatch.fn, []);
-      }
       return true;
     }
     return false;
   }
 
+  // Innermost try of the function being compiled. Landing pads of functions the closure is nested into don't count
+  private getCatchTarget() {
+    const { builder, currentFunction } = this.generator;
+
+    if (builder.landingPadStack.length === 0) {
+      return undefined;
+    }
+
+    const catchTarget = this.catchTargets.get(builder.landingPadStack[builder.landingPadStack.length - 1]);
+    return catchTarget?.functionName === currentFunction.name ? catchTarget : undefined;
+  }
+
+  private emitLocalThrow(raisedException: LLVMValue, catchTarget: CatchTarget) {
+    const { builder, currentFunction } = this.generator;
+
+    const throwBlock = llvm.BasicBlock.create(this.generator.context, "throw", currentFunction);
+    builder.createBr(throwBlock);
+    builder.setInsertionPoint(throwBlock);
+
+    const value = builder.asVoidStar(raisedException);
+    catchTarget.localThrows.push({ value: value.unwrapped, block: throwBlock });
+
+    builder.createBr(catchTarget.caughtBB);
+  }
+
   emitThrowBlock(raisedException: LLVMValue, node: ts.Node): void {
     const { builder, currentFunction } = this.generator;
     const int8PtrTy = LLVMType.getInt8Type(this.generator).getPointer();
@@ -185,38 +237,17 @@ export class ExceptionHandler extends AbstractNodeHandler {
     );
     builder.createSafeStore(raisedException, exceptionPtr);
 
-    // Income from try block.
-    if (needUnwind(node)) {
-      const ldPadBB =
-        builder.landingPadStack[builder.landingPadStack.length - 1];
-      const unreachableBB = this.getOrCreateUnreachableBlock();
-      {
-        builder
-          .unwrap()
-          .CreateInvoke(
-            ExceptionHandler.throwException.fn.unwrapped,
-            unreachableBB,
-            ldPadBB,
-            [
-              allocateException.unwrapped,
-              builder.createBitCast(ExceptionHandler.typeInfo, int8PtrTy)
-                .unwrapped,
-              LLVMConstant.createNullValue(int8PtrTy, this.generator).unwrapped,
-            ]
-          );
-      }
-    } else {
-      const block = getInvocableBody(node);
-      builder.functionMetaEntry.set(block as ts.Block, { needUnwind: true });
+    // Exception leaves the function: its callers in try blocks need to invoke it
+    const block = getInvocableBody(node);
+    builder.functionMetaEntry.set(block as ts.Block, { needUnwind: true });
 
-      currentFunction.addFnAttr(llvm.Attribute.AttrKind.UWTable);
-      builder.createSafeCall(ExceptionHandler.throwException.fn, [
-        allocateException,
-        builder.createBitCast(ExceptionHandler.typeInfo, int8PtrTy),
-        LLVMConstant.createNullValue(int8PtrTy, this.generator),
-      ]);
-      builder.unwrap().CreateUnreachable();
-    }
+    currentFunction.addFnAttr(llvm.Attribute.AttrKind.UWTable);
+    builder.createSafeCall(ExceptionHandler.throwException.fn, [
+      allocateException,
+      builder.createBitCast(ExceptionHandler.typeInfo, int8PtrTy),
+      LLVMConstant.createNullValue(int8PtrTy, this.generator),
+    ]);
+    builder.unwrap().CreateUnreachable();
   }
 
   createFunction(
@@ -228,25 +259,6 @@ export class ExceptionHandler extends AbstractNodeHandler {
     return functionInstance.create(ret, args, name);
   }
 
-  getOrCreateUnreachableBlock(): llvm.BasicBlock {
-    const { context, currentFunction, builder } = this.generator;
-    const blocks = currentFunction.getBasicBlocks();
-    const unreachableBB = blocks.find(
-      (block: llvm.BasicBlock) => block.name === this.unreachableBlockName
-    );
-    if (unreachableBB) return unreachableBB;
-    return this.generator.withInsertBlockKeeping(() => {
-      const newUnreachableBB = llvm.BasicBlock.create(
-        context,
-        this.unreachableBlockName,
-        currentFunction
-      );
-      builder.setInsertionPoint(newUnreachableBB);
-      builder.unwrap().CreateUnreachable();
-      return newUnreachableBB;
-    });
-  }
-
   initRTTI(): void {
     const int8PtrTy = LLVMType.getInt8Type(this.generator).getPointer();
     const int64Ty = LLVMType.getInt64Type(this.generator);
@@ -32,6 +32,11 @@ export class FunctionDeclarationHandler extends AbstractNodeHandler {
         }
 
         const env = this.createEnvironmentForDeclaration(declaration, outerEnv);
+
+        if (this.generator.ts.functionUsage.canPassArgumentsDirectly(declaration.unwrapped as ts.FunctionDeclaration)) {
+            this.createDirectFunctionForDeclaration(declaration, env);
+        }
+
         const closure = this.createClosureForDeclaration(declaration, env);
 
         this.registerClosureForDeclaration(closure, declaration, parentScope);
@@ -87,7 +92,9 @@ export class FunctionDeclarationHandler extends AbstractNodeHandler {
                 args: dummyArguments,
                 signature,
             },
-            outerEnv
+            outerEnv,
+            undefined,
+            /* for closure = */ !declaration.typeParameters
         );
     }
 
@@ -110,6 +117,40 @@ export class FunctionDeclarationHandler extends AbstractNodeHandler {
         return this.generator.tsclosure.createClosure(fn, env, declaration);
     }
 
+    // Function that is never used as a value is called by the variant that gets parameters as LLVM arguments.
+    // Calls do not write arguments into the closure environment (shared by all of them, recursive ones as well)
+    // and do not allocate cells for them, environment is left with captured variables only.
+    // Closure is still created: it holds the environment and it is used by calls compiled before this point.
+    createDirectFunctionForDeclaration(declaration: Declaration, env: Environment) {
+        const signature = this.generator.ts.checker.getSignatureFromDeclaration(declaration);
+        const llvmReturnType = signature.getReturnType().getLLVMReturnType();
+
+        const parameters = signature.getDeclaredParameters();
+        const parameterNames = parameters.map((parameter) => parameter.name.getText());
+        const llvmParameterTypes = parameters.map((parameter) =>
+            this.generator.ts.checker.getTypeAtLocation(parameter).getLLVMType()
+        );
+
+        const functionName = this.getDeclarationName(declaration) + "__direct__" + this.generator.randomString;
+        const { fn } = this.generator.llvm.function.create(
+            llvmReturnType,
+            [env.voidStar, ...llvmParameterTypes],
+            functionName
+        );
+
+        // recursive calls in the body are direct too
+        this.generator.meta.registerDirectFunction(declaration, fn);
+
+        FunctionHandler.handleFunctionBody(
+            declaration,
+            fn,
+            this.generator,
+            env.withParametersPassedByValue(parameterNames),
+            parameterNames
+        );
+        LLVMFunction.verify(fn, declaration);
+    }
+
     registerClosureForDeclaration(closure: LLVMValue, declaration: Declaration, parentScope: Scope) {
         const name = this.getDeclarationName(declaration);
         parentScope.setOrAssign(name, closure);
@@ -2,10 +2,11 @@ import { BasicBlock } from "llvm-node";
 import * as ts from "typescript";
 
 import { AbstractNodeHandler } from "./nodehandler";
-import { Scope, Environment, HeapVariableDeclaration } from "../../scope";
+import { Scope, Environment, HeapVariableDeclaration, StackFrame } from "../../scope";
 import { last } from "lodash";
-import { LLVMValue } from "../../llvm/value";
+import { LLVMConstantFP, LLVMValue } from "../../llvm/value";
 import { LoopHelper } from "./loophelper";
+import { NumericLowering } from "../numericlowering";
 import { ExitingBlocks } from "../../llvm/exiting_blocks";
 import { LLVMType } from "../../llvm/type";
 import { TSType } from "../../ts/type";
@@ -63,7 +64,7 @@ export class LoopHandler extends AbstractNodeHandler {
 
     builder.createBr(condition);
     builder.setInsertionPoint(condition);
-    const conditionValue = this.generator.handleExpression(statement.expression, env).derefToPtrLevel1();
+    const conditionValue = new NumericLowering(this.generator).handleCondition(statement.expression, env);
     builder.createCondBr(conditionValue, body, exiting);
 
     currentFunction.addBasicBlock(bodyLatch);
@@ -120,7 +121,7 @@ export class LoopHandler extends AbstractNodeHandler {
     builder.createBr(condition);
 
     builder.setInsertionPoint(condition);
-    const conditionValue = this.generator.handleExpression(statement.expression, env).derefToPtrLevel1();
+    const conditionValue = new NumericLowering(this.generator).handleCondition(statement.expression, env);
     builder.createCondBr(conditionValue, body, exiting);
 
     builder.setInsertionPoint(exiting);
@@ -135,6 +136,8 @@ export class LoopHandler extends AbstractNodeHandler {
     const { builder, context, symbolTable, currentFunction } = this.generator;
 
     const start = BasicBlock.create(context, "for.start");
+    const inductionVariable = this.generator.ts.inductionVariables.find(statement);
+    let inductionCell: LLVMValue | undefined;
 
     const handlerImpl = (counters: string[] = []): void => {
       const condition = BasicBlock.create(context, "for.condition");
@@ -150,7 +153,7 @@ export class LoopHandler extends AbstractNodeHandler {
         builder.createBr(condition);
         currentFunction.addBasicBlock(condition);
         builder.setInsertionPoint(condition);
-        const conditionValue = this.generator.handleExpression(statement.condition, env).derefToPtrLevel1();
+        const conditionValue = new NumericLowering(this.generator).handleCondition(statement.condition, env);
         builder.createCondBr(conditionValue, body, exiting);
       } else {
         builder.createBr(body);
@@ -195,7 +198,7 @@ export class LoopHandler extends AbstractNodeHandler {
 
         value = value.derefToPtrLevel1();
 
-        let clone = this.generator.gc.allocate(value.type);
+        let clone = this.generator.gc.allocateTraced(value.type);
         this.generator.gc.addRoot(clone);
 
         clone = clone.makeAssignment(value);
@@ -242,7 +245,11 @@ export class LoopHandler extends AbstractNodeHandler {
       if (statement.incrementor) {
         currentFunction.addBasicBlock(incrementor);
         builder.setInsertionPoint(incrementor);
-        this.generator.handleExpression(statement.incrementor, env);
+        if (inductionCell) {
+          this.handleInductionVariableUpdate(statement.incrementor, inductionCell, env);
+        } else {
+          this.generator.handleExpression(statement.incrementor, env);
+        }
 
         if (statement.condition) {
           builder.createBr(condition);
@@ -264,10 +271,27 @@ export class LoopHandler extends AbstractNodeHandler {
         builder.createBr(start);
         builder.setInsertionPoint(start);
 
+        if (inductionVariable) {
+          inductionCell = builder.createEntryBlockAlloca(LLVMType.getDoubleType(this.generator));
+          const initialValue = new NumericLowering(this.generator).handleOperand(inductionVariable.initializer!, env);
+          builder.createSafeStore(initialValue, inductionCell);
+
+          this.generator.ts.inductionVariables.register(inductionVariable, inductionCell);
+          handlerImpl();
+          this.generator.ts.inductionVariables.unregister(inductionVariable);
+          return;
+        }
+
         const prevState = localScope.names();
         this.generator.handleNode(statement.initializer!, localScope, env);
         const currState = localScope.names();
-        const counters = currState.filter(x => !prevState.includes(x));
+
+        // every iteration gets its own copy of counters for closures to capture, others stay in the stack frame
+        const frame = StackFrame.current(this.generator);
+        const stackCounters = (statement.initializer as ts.VariableDeclarationList).declarations
+          .filter((declaration) => frame?.hasSlot(declaration))
+          .map((declaration) => declaration.name.getText());
+        const counters = currState.filter(x => !prevState.includes(x) && !stackCounters.includes(x));
 
         handlerImpl(counters);
       }, this.generator.symbolTable.currentScope);
@@ -279,6 +303,28 @@ export class LoopHandler extends AbstractNodeHandler {
     }
   }
 
+  // 'i++', '--i', 'i += step'... of a counter that is a raw double, see InductionVariables
+  private handleInductionVariableUpdate(incrementor: ts.Expression, cell: LLVMValue, env?: Environment) {
+    const builder = this.generator.builder;
+
+    incrementor = NumericLowering.skipParentheses(incrementor);
+
+    let step: LLVMValue;
+    let isDecrement: boolean;
+
+    if (ts.isBinaryExpression(incrementor)) {
+      step = new NumericLowering(this.generator).handleOperand(incrementor.right, env);
+      isDecrement = incrementor.operatorToken.kind === ts.SyntaxKind.MinusEqualsToken;
+    } else {
+      const unary = incrementor as ts.PrefixUnaryExpression | ts.PostfixUnaryExpression;
+      step = LLVMConstantFP.get(this.generator, 1);
+      isDecrement = unary.operator === ts.SyntaxKind.MinusMinusToken;
+    }
+
+    const value = builder.createLoad(cell);
+    builder.createSafeStore(isDecrement ? builder.createSub(value, step) : builder.createAdd(value, step), cell);
+  }
+
   private handleForOfStatement(statement: ts.ForOfStatement, env?: Environment): void {
     if (statement.awaitModifier) {
       throw new Error(`'await' currently is not supported in for..of, '${statement.getText()}'`);
@@ -374,7 +420,7 @@ export class LoopHandler extends AbstractNodeHandler {
         currentFunction.addBasicBlock(end);
 
         // Process the case where variable in for_of is tuple
-        let incPlaceholderPtrPtr = this.generator.gc.allocate(variableType.getLLVMType());
+        let incPlaceholderPtrPtr = this.generator.gc.allocateTraced(variableType.getLLVMType());
         if (isTupleInitializer()) {
           const bindingPattern = initializer.name as ts.ArrayBindingPattern;
 
@@ -523,7 +569,7 @@ export class LoopHandler extends AbstractNodeHandler {
         const iterator = this.generator.builder.createSafeCall(iteratorGetterMethod, [indicesTypeLess])
         const iteratorDeclaration = this.generator.ts.iterableIterator.getIteratorDeclaration(arrayDeclaration);
 
-        let incPlaceholderPtrPtr = this.generator.gc.allocate(variableType.getLLVMType());
+        let incPlaceholderPtrPtr = this.generator.gc.allocateTraced(variableType.getLLVMType());
         updateScope(incPlaceholderPtrPtr);
 
         builder.createBr(bodyLatch);
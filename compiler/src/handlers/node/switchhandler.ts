@@ -3,6 +3,9 @@ import * as ts from "typescript";
 import { AbstractNodeHandler } from "./nodehandler";
 import { Scope, Environment } from "../../scope";
 import { ExitingBlocks } from "../../llvm/exiting_blocks";
+import { LLVMConstantFP, LLVMConstantInt, LLVMValue } from "../../llvm/value";
+import { LLVMType } from "../../llvm/type";
+import { TSString } from "../../ts/string";
 
 export class SwitchHandler extends AbstractNodeHandler {
   handle(node: ts.Node, parentScope: Scope, env?: Environment): boolean {
@@ -63,7 +66,19 @@ export class SwitchHandler extends AbstractNodeHandler {
       this.generator.builder.setInsertionPoint(switchBlock);
 
       const blocks = this.handleClauses(clauses, endBlock, parentScope, env);
-      this.handleConditions(node, clauses, blocks, endBlock, env);
+      const hasDefault = clauses.length > 0 && ts.isDefaultClause(clauses[clauses.length - 1]);
+      const fallbackBlock = hasDefault ? blocks[blocks.length - 1] : endBlock;
+
+      const numericCases = this.getNumericCaseValues(node, clauses);
+      const stringCases = this.getStringCaseValues(node, clauses);
+
+      if (numericCases) {
+        this.handleNumericDispatch(node, numericCases, blocks, fallbackBlock, env);
+      } else if (stringCases) {
+        this.handleStringDispatch(node, clauses, stringCases, blocks, fallbackBlock, env);
+      } else {
+        this.handleConditions(node, clauses, blocks, fallbackBlock, env);
+      }
     });
 
     this.generator.builder.setInsertionPoint(endBlock);
@@ -109,7 +124,7 @@ export class SwitchHandler extends AbstractNodeHandler {
     node: ts.SwitchStatement,
     clauses: ts.CaseOrDefaultClause[],
     blocks: llvm.BasicBlock[],
-    endBlock: llvm.BasicBlock,
+    fallbackBlock: llvm.BasicBlock,
     env?: Environment
   ) {
     const conditionBlocks = (clauses.filter((clause) => ts.isCaseClause(clause)) as ts.CaseClause[]).map((clause) => {
@@ -117,8 +132,6 @@ export class SwitchHandler extends AbstractNodeHandler {
       return BasicBlock.create(this.generator.context, blockName, this.generator.currentFunction);
     });
 
-    const defaultBlock = blocks.find((block) => block.name.includes("default"));
-
     this.generator.withInsertBlockKeeping(() => {
       for (let i = 0; i < conditionBlocks.length; ++i) {
         const clause = clauses[i];
@@ -136,11 +149,268 @@ export class SwitchHandler extends AbstractNodeHandler {
           );
           const comparisonResult = this.generator.handleExpression(comparisonExpression, env).derefToPtrLevel1();
 
-          this.generator.builder.createCondBr(comparisonResult, block, nextConditionBlock || defaultBlock || endBlock);
+          this.generator.builder.createCondBr(comparisonResult, block, nextConditionBlock || fallbackBlock);
         }
       }
     });
 
-    this.generator.builder.createBr(conditionBlocks[0] || defaultBlock || endBlock);
+    this.generator.builder.createBr(conditionBlocks[0] || fallbackBlock);
+  }
+
+  // Integral values of case labels if every label is a compile time constant (literal or const)
+  // and the discriminant is a number.
+  // Case clauses go first in 'clauses' (see correctClausesOrder), so values are indexed the same way as clause blocks.
+  private getNumericCaseValues(node: ts.SwitchStatement, clauses: ts.CaseOrDefaultClause[]) {
+    const discriminantType = this.generator.ts.checker.getTypeAtLocation(node.expression);
+
+    if (!discriminantType.isNumber() || discriminantType.isEnum() || discriminantType.isUnion()) {
+      return undefined;
+    }
+
+    const values: number[] = [];
+
+    for (const clause of clauses) {
+      if (ts.isDefaultClause(clause)) {
+        break;
+      }
+
+      const value = this.getConstantCaseValue(clause.expression);
+
+      if (typeof value !== "number" || !Number.isInteger(value) || value < -(2 ** 31) || value > 2 ** 31 - 1) {
+        return undefined;
+      }
+
+      values.push(value);
+    }
+
+    return values.length > 0 ? values : undefined;
+  }
+
+  private getStringCaseValues(node: ts.SwitchStatement, clauses: ts.CaseOrDefaultClause[]) {
+    const discriminantType = this.generator.ts.checker.getTypeAtLocation(node.expression);
+
+    if (!discriminantType.isString() || discriminantType.isUnion()) {
+      return undefined;
+    }
+
+    const values: string[] = [];
+
+    for (const clause of clauses) {
+      if (ts.isDefaultClause(clause)) {
+        break;
+      }
+
+      const value = this.getConstantCaseValue(clause.expression);
+
+      if (typeof value !== "string") {
+        return undefined;
+      }
+
+      values.push(value);
+    }
+
+    return values.length > 0 ? values : undefined;
+  }
+
+  // Labels are evaluated lazily in ECMAScript, so only those without side effects may be dispatched on ahead of time
+  private getConstantCaseValue(expression: ts.Expression): number | string | undefined {
+    if (ts.isParenthesizedExpression(expression)) {
+      return this.getConstantCaseValue(expression.expression);
+    }
+
+    if (ts.isNumericLiteral(expression)) {
+      return parseFloat(expression.text);
+    }
+
+    if (ts.isStringLiteral(expression) || ts.isNoSubstitutionTemplateLiteral(expression)) {
+      return expression.text;
+    }
+
+    if (ts.isPrefixUnaryExpression(expression) && expression.operator === ts.SyntaxKind.MinusToken) {
+      const value = this.getConstantCaseValue(expression.operand);
+      return typeof value === "number" ? -value : undefined;
+    }
+
+    if (ts.isIdentifier(expression) && this.generator.ts.checker.nodeHasSymbolAndDeclaration(expression)) {
+      const declaration = this.generator.ts.checker.getSymbolAtLocation(expression).unwrapped.valueDeclaration;
+
+      if (!declaration || !(ts.getCombinedNodeFlags(declaration) & ts.NodeFlags.Const)) {
+        return undefined;
+      }
+
+      // const declarations keep literal type
+      const type = this.generator.ts.checker.getTypeAtLocation(expression).unwrap();
+
+      if (type.isNumberLiteral() || type.isStringLiteral()) {
+        return type.value;
+      }
+    }
+
+    return undefined;
+  }
+
+  // Discriminant is unboxed and converted to i32 once, then compared against every distinct label.
+  // The chain of integer comparisons is turned into a single 'switch' (a jump table for dense labels) by the optimizer.
+  private handleNumericDispatch(
+    node: ts.SwitchStatement,
+    values: number[],
+    blocks: llvm.BasicBlock[],
+    fallbackBlock: llvm.BasicBlock,
+    env?: Environment
+  ) {
+    const builder = this.generator.builder;
+    const name = node.expression.getText();
+
+    const discriminant = this.generator.handleExpression(node.expression, env).derefToPtrLevel1();
+
+    if (!discriminant.type.isTSNumber()) {
+      throw new Error(`Expected number discriminant, got '${discriminant.type.toString()}' at '${name}'`);
+    }
+
+    const unboxed = this.generator.builtinNumber.getUnboxed(discriminant);
+
+    const currentFunction = this.generator.currentFunction;
+    const convertBlock = BasicBlock.create(this.generator.context, `switch.${name}.convert`, currentFunction);
+    const dispatchBlock = BasicBlock.create(this.generator.context, `switch.${name}.dispatch`, currentFunction);
+
+    // fptosi is only defined in range, NaN fails both (ordered) comparisons
+    const inRange = builder.createAnd(
+      builder.createFCmpOGE(unboxed, LLVMConstantFP.get(this.generator, Math.min(...values))),
+      builder.createFCmpOLE(unboxed, LLVMConstantFP.get(this.generator, Math.max(...values)))
+    );
+    builder.createCondBr(inRange, convertBlock, fallbackBlock);
+
+    builder.setInsertionPoint(convertBlock);
+
+    const int32Type = LLVMType.getInt32Type(this.generator);
+    const converted = builder.createFPToSI(unboxed, int32Type);
+
+    // fractional values match no label
+    const convertedBack = builder.createSIToFP(converted, LLVMType.getDoubleType(this.generator));
+    const isIntegral = builder.createFCmpOEQ(convertedBack, unboxed);
+    builder.createCondBr(isIntegral, dispatchBlock, fallbackBlock);
+
+    builder.setInsertionPoint(dispatchBlock);
+
+    this.createIntegerDispatch(
+      converted,
+      values.map((value, index) => ({ key: value, target: blocks[index] })),
+      32,
+      fallbackBlock
+    );
+  }
+
+  // Strings are dispatched on String::hash reduced modulo the smallest number that keeps hashes of labels distinct.
+  // Bucket found by the hash is confirmed by equality check with its label(s), so any string works
+  // and the cost of dispatch does not depend on the number of cases.
+  private handleStringDispatch(
+    node: ts.SwitchStatement,
+    clauses: ts.CaseOrDefaultClause[],
+    values: string[],
+    blocks: llvm.BasicBlock[],
+    fallbackBlock: llvm.BasicBlock,
+    env?: Environment
+  ) {
+    const builder = this.generator.builder;
+    const name = node.expression.getText();
+
+    const discriminant = this.generator.handleExpression(node.expression, env).derefToPtrLevel1();
+
+    if (!discriminant.type.isString()) {
+      throw new Error(`Expected string discriminant, got '${discriminant.type.toString()}' at '${name}'`);
+    }
+
+    const hashes = values.map(TSString.hash);
+    const modulus = SwitchHandler.findPerfectModulus(hashes);
+
+    const int64Type = LLVMType.getInt64Type(this.generator);
+    const boxedHash = this.generator.ts.str.createHash(discriminant);
+    const hash = builder.createFPToSI(this.generator.builtinNumber.getUnboxed(boxedHash), int64Type);
+    const reducedHash = modulus ? builder.createRem(hash, LLVMConstantInt.get(this.generator, modulus, 64)) : hash;
+
+    // Labels with the same (reduced) hash share a bucket and are checked in source order,
+    // so the first of duplicates wins
+    const buckets = new Map<number, number[]>();
+
+    hashes.forEach((value, index) => {
+      const key = modulus ? value % modulus : value;
+      buckets.set(key, [...(buckets.get(key) || []), index]);
+    });
+
+    const cases = Array.from(buckets.entries()).map(([key, indexes]) => {
+      const bucketName = `switch.${name}.bucket_${key}`;
+      const target = BasicBlock.create(this.generator.context, bucketName, this.generator.currentFunction);
+
+      this.generator.withInsertBlockKeeping(() => {
+        builder.setInsertionPoint(target);
+
+        indexes.forEach((index, i) => {
+          const label = this.generator.handleExpression((clauses[index] as ts.CaseClause).expression, env);
+          const isEqual = discriminant.createEquals(label);
+
+          if (i === indexes.length - 1) {
+            builder.createCondBr(isEqual, blocks[index], fallbackBlock);
+            return;
+          }
+
+          const next = BasicBlock.create(this.generator.context, `${bucketName}.next`, this.generator.currentFunction);
+          builder.createCondBr(isEqual, blocks[index], next);
+          builder.setInsertionPoint(next);
+        });
+      });
+
+      return { key, target };
+    });
+
+    this.createIntegerDispatch(reducedHash, cases, 64, fallbackBlock);
+  }
+
+  // Emits 'icmp eq' per distinct key, the first target of a key wins.
+  // llvm-node has no binding for SwitchInst, the optimizer folds such chains into one.
+  private createIntegerDispatch(
+    value: LLVMValue,
+    cases: { key: number; target: llvm.BasicBlock }[],
+    numBits: number,
+    fallbackBlock: llvm.BasicBlock
+  ) {
+    const builder = this.generator.builder;
+    const seen = new Set<number>();
+
+    const distinct = cases.filter(({ key }) => {
+      if (seen.has(key)) {
+        return false;
+      }
+
+      seen.add(key);
+      return true;
+    });
+
+    distinct.forEach(({ key, target }, index) => {
+      const isLast = index === distinct.length - 1;
+      const next = isLast
+        ? fallbackBlock
+        : BasicBlock.create(this.generator.context, `switch.case_${key}.next`, this.generator.currentFunction);
+
+      // decimal string keeps full hashes above 2^31 intact on the way to APInt
+      const constant = LLVMConstantInt.get(this.generator, String(key), numBits);
+      builder.createCondBr(builder.createICmpEQ(value, constant), target, next);
+
+      if (!isLast) {
+        builder.setInsertionPoint(next);
+      }
+    });
+  }
+
+  // Smallest modulus that maps distinct hashes to distinct values, or undefined to dispatch on full hash
+  private static findPerfectModulus(hashes: number[]) {
+    const distinct = Array.from(new Set(hashes));
+
+    for (let modulus = distinct.length; modulus <= distinct.length * 8; ++modulus) {
+      if (new Set(distinct.map((hash) => hash % modulus)).size === distinct.length) {
+        return modulus;
+      }
+    }
+
+    return undefined;
   }
 }
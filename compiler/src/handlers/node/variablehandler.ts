@@ -1,4 +1,4 @@
-import { Scope, HeapVariableDeclaration, Environment, addClassScope } from "../../scope";
+import { Scope, HeapVariableDeclaration, Environment, addClassScope, StackFrame } from "../../scope";
 import { LLVMConstantFP, LLVMValue } from "../../llvm/value";
 import * as ts from "typescript";
 import { AbstractNodeHandler } from "./nodehandler";
@@ -80,7 +80,7 @@ export class VariableHandler extends AbstractNodeHandler {
       initializer = this.generator.builder.createBitCast(initializer, this.generator.ts.undef.getLLVMType());
     }
 
-    parentScope.setOrAssign(name, initializer);
+    this.setVariable(declaration, name, initializer, parentScope);
 
     if (outerEnv?.variables.includes(name)) {
       const index = outerEnv.getVariableIndex(name);
@@ -112,6 +112,25 @@ export class VariableHandler extends AbstractNodeHandler {
     }
   }
 
+  // Variables no closure captures get their cells in the stack frame, see VariableCapture
+  private setVariable(declaration: ts.VariableDeclaration, name: string, value: LLVMValue, scope: Scope) {
+    const stackCell =
+      !scope.get(name) && value.type.getPointerLevel() === 1
+        ? StackFrame.current(this.generator)?.getCell(declaration, value.type)
+        : undefined;
+
+    if (!stackCell) {
+      scope.setOrAssign(name, value);
+      return;
+    }
+
+    this.generator.builder.createSafeStore(value, stackCell);
+
+    // stack frame is a root already
+    const makeRoot = false;
+    scope.set(name, stackCell, makeRoot);
+  }
+
   private handleVariables(statement: VariableLike, parentScope: Scope, env?: Environment): void {
     const declarations = ts.isVariableStatement(statement)
       ? statement.declarationList.declarations
@@ -161,7 +180,7 @@ export class VariableHandler extends AbstractNodeHandler {
         }
       }
 
-      parentScope.setOrAssign(name, allocated);
+      this.setVariable(declaration, name, allocated, parentScope);
       initializer = undefined;
     } else {
       this.checkAssignmentFromMethod(declaration);
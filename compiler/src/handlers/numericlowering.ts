@@ -0,0 +1,264 @@
+import * as ts from "typescript";
+import { LLVMGenerator } from "../generator";
+import { Environment } from "../scope";
+import { LLVMConstantFP, LLVMConstantInt, LLVMValue } from "../llvm/value";
+import { LLVMType } from "../llvm/type";
+
+// Lowers expressions over numbers to plain LLVM instructions.
+// Operands are unboxed once at the leaves, intermediate results stay in registers
+// (double for arithmetic, i1 for comparisons) and only the result of the whole tree is boxed.
+// Subtrees known at compile time (see ConstantFolding) are LLVM constants.
+export class NumericLowering {
+  private generator: LLVMGenerator;
+
+  constructor(generator: LLVMGenerator) {
+    this.generator = generator;
+  }
+
+  // True if 'expression' is a numeric operation that produces a raw double
+  isArithmetic(expression: ts.Expression): boolean {
+    expression = NumericLowering.skipParentheses(expression);
+
+    if (ts.isNumericLiteral(expression) || this.getFoldedNumber(expression) !== undefined) {
+      return true;
+    }
+
+    if (ts.isIdentifier(expression)) {
+      return Boolean(this.generator.ts.inductionVariables.getCell(expression));
+    }
+
+    if (ts.isPrefixUnaryExpression(expression)) {
+      return (
+        (expression.operator === ts.SyntaxKind.MinusToken || expression.operator === ts.SyntaxKind.PlusToken) &&
+        this.isNumber(expression.operand)
+      );
+    }
+
+    if (ts.isBinaryExpression(expression)) {
+      return NumericLowering.isArithmeticOperator(expression.operatorToken.kind) && this.hasNumberOperands(expression);
+    }
+
+    return false;
+  }
+
+  // True if 'expression' is a comparison of two numbers that produces a raw i1
+  isComparison(expression: ts.Expression): boolean {
+    expression = NumericLowering.skipParentheses(expression);
+
+    return (
+      ts.isBinaryExpression(expression) &&
+      NumericLowering.isComparisonOperator(expression.operatorToken.kind) &&
+      this.hasNumberOperands(expression)
+    );
+  }
+
+  // Returns boxed Number for arithmetic and boxed Boolean for comparison
+  handleBoxed(expression: ts.Expression, env?: Environment): LLVMValue {
+    if (this.isComparison(expression)) {
+      return this.generator.builtinBoolean.createHeap(this.handleComparison(expression, env));
+    }
+
+    return this.generator.builtinNumber.create(this.handleArithmetic(expression, env));
+  }
+
+  // Returns raw i1 if the condition is a numeric comparison and boxed Boolean otherwise.
+  // Builder.createCondBr accepts both.
+  handleCondition(expression: ts.Expression, env?: Environment): LLVMValue {
+    const folded = this.getFoldedBoolean(expression);
+    if (folded !== undefined) {
+      return folded ? LLVMConstantInt.getTrue(this.generator) : LLVMConstantInt.getFalse(this.generator);
+    }
+
+    if (this.isComparison(expression)) {
+      return this.handleComparison(expression, env);
+    }
+
+    return this.generator.handleExpression(expression, env).derefToPtrLevel1().makeBoolean();
+  }
+
+  handleArithmetic(expression: ts.Expression, env?: Environment): LLVMValue {
+    expression = NumericLowering.skipParentheses(expression);
+
+    const builder = this.generator.builder;
+
+    if (ts.isNumericLiteral(expression)) {
+      return LLVMConstantFP.get(this.generator, parseFloat(expression.text));
+    }
+
+    const folded = this.getFoldedNumber(expression);
+    if (folded !== undefined) {
+      return LLVMConstantFP.get(this.generator, folded);
+    }
+
+    const counter = ts.isIdentifier(expression) ? this.generator.ts.inductionVariables.getCell(expression) : undefined;
+    if (counter) {
+      return builder.createLoad(counter);
+    }
+
+    if (ts.isPrefixUnaryExpression(expression)) {
+      const operand = this.handleOperand(expression.operand, env);
+      return expression.operator === ts.SyntaxKind.MinusToken ? builder.createNeg(operand) : operand;
+    }
+
+    if (!ts.isBinaryExpression(expression)) {
+      throw new Error(`Expected numeric expression, got '${expression.getText()}'`);
+    }
+
+    this.generator.emitLocation(expression.left);
+    this.generator.emitLocation(expression.right);
+
+    const lhs = this.handleOperand(expression.left, env);
+    const rhs = this.handleOperand(expression.right, env);
+
+    switch (expression.operatorToken.kind) {
+      case ts.SyntaxKind.PlusToken:
+        return builder.createAdd(lhs, rhs);
+      case ts.SyntaxKind.MinusToken:
+        return builder.createSub(lhs, rhs);
+      case ts.SyntaxKind.AsteriskToken:
+        return builder.createMul(lhs, rhs);
+      case ts.SyntaxKind.SlashToken:
+        return builder.createDiv(lhs, rhs);
+      case ts.SyntaxKind.PercentToken:
+        // frem has fmod semantics which is exactly what ECMAScript remainder is
+        return builder.createRem(lhs, rhs);
+      // Bitwise operators on doubles go through ECMAScript ToInt32, see Builder
+      case ts.SyntaxKind.AmpersandToken:
+        return builder.createAnd(lhs, rhs);
+      case ts.SyntaxKind.BarToken:
+        return builder.createOr(lhs, rhs);
+      case ts.SyntaxKind.CaretToken:
+        return builder.createXor(lhs, rhs);
+      case ts.SyntaxKind.LessThanLessThanToken:
+        return builder.createShl(lhs, rhs);
+      case ts.SyntaxKind.GreaterThanGreaterThanToken:
+        return builder.createAShr(lhs, rhs);
+      default:
+        throw new Error(`Unexpected numeric operator at '${expression.getText()}'`);
+    }
+  }
+
+  handleComparison(expression: ts.Expression, env?: Environment): LLVMValue {
+    expression = NumericLowering.skipParentheses(expression);
+
+    if (!ts.isBinaryExpression(expression)) {
+      throw new Error(`Expected numeric comparison, got '${expression.getText()}'`);
+    }
+
+    const folded = this.getFoldedBoolean(expression);
+    if (folded !== undefined) {
+      return folded ? LLVMConstantInt.getTrue(this.generator) : LLVMConstantInt.getFalse(this.generator);
+    }
+
+    this.generator.emitLocation(expression.left);
+    this.generator.emitLocation(expression.right);
+
+    const lhs = this.handleOperand(expression.left, env);
+    const rhs = this.handleOperand(expression.right, env);
+
+    const builder = this.generator.builder;
+
+    // Ordered predicates: any comparison with NaN is false, as in ECMAScript
+    switch (expression.operatorToken.kind) {
+      case ts.SyntaxKind.LessThanToken:
+        return builder.createFCmpOLT(lhs, rhs);
+      case ts.SyntaxKind.LessThanEqualsToken:
+        return builder.createFCmpOLE(lhs, rhs);
+      case ts.SyntaxKind.GreaterThanToken:
+        return builder.createFCmpOGT(lhs, rhs);
+      case ts.SyntaxKind.GreaterThanEqualsToken:
+        return builder.createFCmpOGE(lhs, rhs);
+      case ts.SyntaxKind.EqualsEqualsEqualsToken:
+        return builder.createFCmpOEQ(lhs, rhs);
+      case ts.SyntaxKind.ExclamationEqualsEqualsToken:
+        // NaN !== NaN is true, so this is the negation of ordered equality rather than ONE
+        return builder.createNot(builder.createFCmpOEQ(lhs, rhs));
+      default:
+        throw new Error(`Unexpected comparison operator at '${expression.getText()}'`);
+    }
+  }
+
+  // Raw double of any number expression
+  handleOperand(expression: ts.Expression, env?: Environment): LLVMValue {
+    if (this.isArithmetic(expression)) {
+      return this.handleArithmetic(expression, env);
+    }
+
+    const value = this.generator.handleExpression(expression, env).derefToPtrLevel1();
+
+    if (value.type.isTSNumber()) {
+      return this.generator.builtinNumber.getUnboxed(value);
+    }
+
+    // C++ enums are passed around as integers
+    if (value.type.isIntegerType()) {
+      return this.generator.builder.createSIToFP(value, LLVMType.getDoubleType(this.generator));
+    }
+
+    throw new Error(`Expected number operand, got '${value.type.toString()}' at '${expression.getText()}'`);
+  }
+
+  private getFoldedNumber(expression: ts.Expression) {
+    const value = this.generator.ts.constants.evaluate(expression);
+    return typeof value === "number" && this.isNumber(expression) && !this.isEnum(expression) ? value : undefined;
+  }
+
+  private getFoldedBoolean(expression: ts.Expression) {
+    const value = this.generator.ts.constants.evaluate(expression);
+    return typeof value === "boolean" && this.generator.ts.checker.getTypeAtLocation(expression).isBoolean()
+      ? value
+      : undefined;
+  }
+
+  private isEnum(expression: ts.Expression) {
+    return this.generator.ts.checker.getTypeAtLocation(expression).isEnum();
+  }
+
+  private isNumber(expression: ts.Expression) {
+    return this.generator.ts.checker.getTypeAtLocation(expression).isNumber();
+  }
+
+  private hasNumberOperands(expression: ts.BinaryExpression) {
+    return this.isNumber(expression.left) && this.isNumber(expression.right);
+  }
+
+  static skipParentheses(expression: ts.Expression) {
+    while (ts.isParenthesizedExpression(expression)) {
+      expression = expression.expression;
+    }
+
+    return expression;
+  }
+
+  private static isArithmeticOperator(kind: ts.SyntaxKind) {
+    switch (kind) {
+      case ts.SyntaxKind.PlusToken:
+      case ts.SyntaxKind.MinusToken:
+      case ts.SyntaxKind.AsteriskToken:
+      case ts.SyntaxKind.SlashToken:
+      case ts.SyntaxKind.PercentToken:
+      case ts.SyntaxKind.AmpersandToken:
+      case ts.SyntaxKind.BarToken:
+      case ts.SyntaxKind.CaretToken:
+      case ts.SyntaxKind.LessThanLessThanToken:
+      case ts.SyntaxKind.GreaterThanGreaterThanToken:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  private static isComparisonOperator(kind: ts.SyntaxKind) {
+    switch (kind) {
+      case ts.SyntaxKind.LessThanToken:
+      case ts.SyntaxKind.LessThanEqualsToken:
+      case ts.SyntaxKind.GreaterThanToken:
+      case ts.SyntaxKind.GreaterThanEqualsToken:
+      case ts.SyntaxKind.EqualsEqualsEqualsToken:
+      case ts.SyntaxKind.ExclamationEqualsEqualsToken:
+        return true;
+      default:
+        return false;
+    }
+  }
+}
@@ -80,10 +80,10 @@ export class LLVMValue {
       throw new Error(`Source value expected to be of PointerType, got '${other.type.toString()}'`);
     }
 
-    // mkrv @todo: what if 'value' includes 'other' union type huh?
+    // Union values may be shared (see TSUnion.create), so the cell gets the value itself instead of changing the union
     if (value.type.isUnion() && !other.type.isUnion()) {
-      this.generator.ts.union.set(value, other);
-      return value;
+      other = other.derefToPtrLevel1();
+      other = this.generator.ts.union.create(other.isTSPrimitivePtr() ? other.clone() : other);
     }
 
     if (other.type.getPointerLevel() !== 1) {
@@ -119,7 +119,8 @@ export class LLVMValue {
   // @todo: terminology mess
   createNegate(): LLVMValue {
     if (this.type.isTSNumber()) {
-      return this.createUnaryNumberOperation("negate");
+      const unboxed = this.generator.builtinNumber.getUnboxed(this.derefToPtrLevel1());
+      return this.generator.builtinNumber.create(this.generator.builder.createNeg(unboxed));
     } else if (this.type.isTSBoolean()) {
       const thisPtr = this.derefToPtrLevel1();
       const fn = this.generator.builtinBoolean.getNegateFn();
@@ -231,10 +232,16 @@ export class LLVMValue {
       const lhs = this.derefToPtrLevel1();
       const rhs = other.derefToPtrLevel1();
 
-      const fnName = name + (flags === MathFlags.Inplace ? "Inplace" : "");
-      const fn = this.generator.builtinNumber.createMathFn(fnName);
-      const lhsUntyped = this.generator.builder.asVoidStar(lhs);
-      return this.generator.builder.createSafeCall(fn, [lhsUntyped, rhs]);
+      if (flags === MathFlags.Inplace) {
+        // Number cell is shared by every reference to it, so it has to be updated in place
+        const fn = this.generator.builtinNumber.createMathFn(name + "Inplace");
+        const lhsUntyped = this.generator.builder.asVoidStar(lhs);
+        return this.generator.builder.createSafeCall(fn, [lhsUntyped, rhs]);
+      }
+
+      const lhsUnboxed = this.generator.builtinNumber.getUnboxed(lhs);
+      const rhsUnboxed = this.generator.builtinNumber.getUnboxed(rhs);
+      return this.generator.builtinNumber.create(this.createUnboxedArithmeticOperation(lhsUnboxed, rhsUnboxed, name));
     }
 
     throw new Error(
@@ -242,6 +249,35 @@ export class LLVMValue {
     );
   }
 
+  private createUnboxedArithmeticOperation(lhs: LLVMValue, rhs: LLVMValue, name: string): LLVMValue {
+    const builder = this.generator.builder;
+
+    switch (name) {
+      case "add":
+        return builder.createAdd(lhs, rhs);
+      case "sub":
+        return builder.createSub(lhs, rhs);
+      case "mul":
+        return builder.createMul(lhs, rhs);
+      case "div":
+        return builder.createDiv(lhs, rhs);
+      case "mod":
+        return builder.createRem(lhs, rhs);
+      case "bitwiseAnd":
+        return builder.createAnd(lhs, rhs);
+      case "bitwiseOr":
+        return builder.createOr(lhs, rhs);
+      case "bitwiseXor":
+        return builder.createXor(lhs, rhs);
+      case "bitwiseLeftShift":
+        return builder.createShl(lhs, rhs);
+      case "bitwiseRightShift":
+        return builder.createAShr(lhs, rhs);
+      default:
+        throw new Error(`Unknown arithmetic operation '${name}'`);
+    }
+  }
+
   createEquals(other: LLVMValue): LLVMValue {
     let thisPtr = this.derefToPtrLevel1();
     let otherPtr = other.derefToPtrLevel1();
@@ -280,11 +316,9 @@ export class LLVMValue {
   private createComparisonOperation(other: LLVMValue, name: string): LLVMValue {
       // operand type is intentionally not checked
       if (this.type.isTSNumber()) {
-        const lhs = this.derefToPtrLevel1();
-        const rhs = other.derefToPtrLevel1();
-        const fn = this.generator.builtinNumber.createBooleanFn(name);
-        const lhsUntyped = this.generator.builder.asVoidStar(lhs);
-        return this.generator.builder.createSafeCall(fn, [lhsUntyped, rhs]);
+        const lhs = this.generator.builtinNumber.getUnboxed(this.derefToPtrLevel1());
+        const rhs = this.generator.builtinNumber.getUnboxed(other.derefToPtrLevel1());
+        return this.generator.builtinBoolean.createHeap(this.createUnboxedComparison(lhs, rhs, name));
       }
   
       throw new Error(`Invalid operand types to ${name} than: 
@@ -292,11 +326,29 @@ export class LLVMValue {
                               rhs: ${other.type.toString()} ${other.type.typeIDName}`);
   }
 
+  private createUnboxedComparison(lhs: LLVMValue, rhs: LLVMValue, name: string): LLVMValue {
+    const builder = this.generator.builder;
+
+    switch (name) {
+      case "lessThan":
+        return builder.createFCmpOLT(lhs, rhs);
+      case "lessEqualsThan":
+        return builder.createFCmpOLE(lhs, rhs);
+      case "greaterThan":
+        return builder.createFCmpOGT(lhs, rhs);
+      case "greaterEqualsThan":
+        return builder.createFCmpOGE(lhs, rhs);
+      default:
+        throw new Error(`Unknown comparison operation '${name}'`);
+    }
+  }
+
   clone(): LLVMValue {
     if (this.type.isTSNumber()) {
       return this.generator.builtinNumber.clone(this);
     } else if (this.type.isString()) {
-      return this.generator.ts.str.clone(this);
+      // strings are immutable, sharing one is safe (and string literals are shared anyway, see TSString.create)
+      return this;
     } else if (this.type.isTSBoolean()) {
       return this.generator.builtinBoolean.clone(this);
     }
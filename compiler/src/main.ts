@@ -7,50 +7,68 @@ try {
 }
 
 import { LLVMGenerator } from "./generator";
-import * as argv from "commander";
+import * as commander from "commander";
+import * as crypto from "crypto";
 import * as fs from "fs";
 import * as llvm from "llvm-node";
 import * as path from "path";
 import * as ts from "typescript";
 import { Build } from "./buildutils/build";
+import { CompilationCache, writeFileIfChanged } from "./buildutils/cache";
 import { TemplateInstantiator } from "./cppintegration/templateinstantiator";
+import { connectToCompileServer, startCompileServer } from "./compileserver";
 import { initCXXSymbols } from "./mangling";
 
 var pjson = require('../package.json');
 var version_string = pjson.version + ' (Based on Node.js ' + process.version + ")"
 
-argv
-  .name('compiler') // TODO: get binary name from env?
-  .description('Typescript Native Compiler')
-  .version(version_string)
-  .option("--printIR", "print LLVM assembly to stdout")
-  .option("--emitIR", "write LLVM assembly to file")
-  .option("--processTemplateClasses", "instantiate template classes")
-  .option("--processTemplateFunctions", "instantiate template functions")
-  .option("--templatesOutputDir [value]", "specify path to instantiated templates", "")
-  .option("--target <absolute path>", "generate code for the given target")
-  .option("--build <absolute path>", "specify build dir")
-  .option("--baseUrl <absolute path>", "specify base dir")
-  .option("--tsconfig <absolute path>", "specify tsconfig")
-  .option("--trace", "enable tracing")
-  .option("--demangledTables <items>", "specify demangled symbol files (comma separated list)", (value: string) => {
-    return value.split(",");
-  })
-  .option("--mangledTables <items>", "specify mangled symbol files (comma separated list)", (value: string) => {
-    return value.split(",");
-  })
-  .option(
-    "--includeDirs <items>",
-    "specify dirs with c++ headers for templates instantiation (comma separated list)",
-    (value: string) => {
+// Server mode parses every request with the same options, errors must not terminate the process then
+function parseCommandLine(args: string[], exitOverride = false) {
+  const argv = new commander.Command();
+
+  if (exitOverride) {
+    argv.exitOverride();
+  }
+
+  argv
+    .name('compiler') // TODO: get binary name from env?
+    .description('Typescript Native Compiler')
+    .version(version_string)
+    .option("--printIR", "print LLVM assembly to stdout")
+    .option("--emitIR", "write LLVM assembly to file")
+    .option("--processTemplateClasses", "instantiate template classes")
+    .option("--processTemplateFunctions", "instantiate template functions")
+    .option("--processTemplates", "instantiate template classes and functions in a single pass")
+    .option("--templatesOutputDir [value]", "specify path to instantiated templates", "")
+    .option("--target <absolute path>", "generate code for the given target")
+    .option("--build <absolute path>", "specify build dir")
+    .option("--baseUrl <absolute path>", "specify base dir")
+    .option("--tsconfig <absolute path>", "specify tsconfig")
+    .option("--trace", "enable tracing")
+    .option("--demangledTables <items>", "specify demangled symbol files (comma separated list)", (value: string) => {
       return value.split(",");
-    }
-  )
-  .option("--debug", "Generate debug information")
-  .option("--enableOptimizations <[ON|OFF]>", "If 'ON', it disables all unnecessary allocations")
-  .parse(process.argv);
+    })
+    .option("--mangledTables <items>", "specify mangled symbol files (comma separated list)", (value: string) => {
+      return value.split(",");
+    })
+    .option(
+      "--includeDirs <items>",
+      "specify dirs with c++ headers for templates instantiation (comma separated list)",
+      (value: string) => {
+        return value.split(",");
+      }
+    )
+    .option("--debug", "Generate debug information")
+    .option("--enableOptimizations <[ON|OFF]>", "If 'ON', it disables all unnecessary allocations")
+    .option("--cacheDir <absolute path>", "reuse type check results and outputs of previous runs with the same inputs")
+    .option("--server <socket>", "keep running and serve compilation requests sent to the given local socket")
+    .option("--connect <socket>", "send compilation to the server at the given socket, compile in-process if there is none")
+    .parse(args);
 
-function parseTSConfig(): any {
+  return argv;
+}
+
+function parseTSConfig(argv: commander.Command): any {
   let tsconfig;
   try {
     tsconfig = JSON.parse(fs.readFileSync(argv.tsconfig).toString());
@@ -68,18 +86,138 @@ function getFullProgramSources(rootNames: readonly string[], options: ts.Compile
   return program.getSourceFiles().map((file) => file.fileName);
 }
 
+// Parsed source files by compiler options and file name.
+// Both programs of a compilation are created from the same files, and server mode keeps them between compilations:
+// a file is parsed again only if it has been modified.
+const parsedSourceFiles = new Map<string, { modified: number; sourceFile: ts.SourceFile | undefined }>();
+
+function withSourceFilesReuse(host: ts.CompilerHost, options: ts.CompilerOptions): ts.CompilerHost {
+  const getSourceFile = host.getSourceFile;
+  const optionsKey = JSON.stringify(options);
+
+  host.getSourceFile = (fileName, languageVersion, onError, shouldCreateNewSourceFile) => {
+    const key = optionsKey + fileName;
+    const modified = fs.existsSync(fileName) ? fs.statSync(fileName).mtimeMs : 0;
+    const parsed = parsedSourceFiles.get(key);
+
+    if (!shouldCreateNewSourceFile && parsed && parsed.modified === modified) {
+      return parsed.sourceFile;
+    }
+
+    const sourceFile = getSourceFile.call(host, fileName, languageVersion, onError, shouldCreateNewSourceFile);
+    parsedSourceFiles.set(key, { modified, sourceFile });
+    return sourceFile;
+  };
+
+  return host;
+}
+
+let llvmInitialized = false;
+
+function initLLVM() {
+  if (llvmInitialized) {
+    return;
+  }
+
+  llvm.initializeAllTargetInfos();
+  llvm.initializeAllTargets();
+  llvm.initializeAllTargetMCs();
+  llvm.initializeAllAsmParsers();
+  llvm.initializeAllAsmPrinters();
+
+  llvmInitialized = true;
+}
+
+let compilerIdentity: string | undefined;
+
+// Cached outputs are valid for the compiler that produced them only. Identity is the hash of the packaged binary
+// or, if run from sources, of every compiler module: modification times may survive a rebuild
+function getCompilerIdentity() {
+  if (!compilerIdentity) {
+    const hash = crypto.createHash("sha256");
+    const isPackaged = Boolean((process as any).pkg);
+    const files = isPackaged ? [process.execPath] : listCompilerModules(__dirname).sort();
+
+    for (const file of files) {
+      hash.update(path.relative(__dirname, file)).update(fs.readFileSync(file));
+    }
+
+    compilerIdentity = version_string + " " + hash.digest("hex");
+  }
+
+  return compilerIdentity;
+}
+
+function listCompilerModules(directory: string): string[] {
+  const modules: string[] = [];
+
+  for (const entry of fs.readdirSync(directory, { withFileTypes: true })) {
+    const entryPath = path.join(directory, entry.name);
+
+    if (entry.isDirectory()) {
+      modules.push(...listCompilerModules(entryPath));
+    } else if (entry.name.endsWith(".js")) {
+      modules.push(entryPath);
+    }
+  }
+
+  return modules;
+}
+
+function getOutputKind(argv: commander.Command) {
+  if (argv.processTemplates) {
+    return "templates";
+  }
+
+  if (argv.processTemplateClasses) {
+    return "classes";
+  }
+
+  if (argv.processTemplateFunctions) {
+    return "functions";
+  }
+
+  return "ll";
+}
+
 // entry point
-main().catch((e) => {
-  console.log(e.stack);
-  process.exit(1);
-});
+main(process.argv)
+  .then((exitCode) => {
+    process.exitCode = exitCode;
+  })
+  .catch((e) => {
+    console.log(e.stack);
+    process.exit(1);
+  });
+
+async function main(args: string[]) {
+  const argv = parseCommandLine(args);
+
+  if (argv.server) {
+    await startCompileServer(argv.server, (request: string[]) => compile(request, true));
+    return 0;
+  }
+
+  if (argv.connect) {
+    const exitCode = await connectToCompileServer(argv.connect, args);
+    if (exitCode !== undefined) {
+      return exitCode;
+    }
+
+    console.warn(`Compile server is not available at '${argv.connect}', compiling in-process`);
+  }
+
+  return compile(args);
+}
+
+async function compile(args: string[], exitOverride = false) {
+  const argv = parseCommandLine(args, exitOverride);
 
-async function main() {
   // print command line
   const files = argv.args;
-  console.log(process.argv.join(" "))
+  console.log(args.join(" "))
 
-  const tsconfig = parseTSConfig();
+  const tsconfig = parseTSConfig(argv);
   const options: ts.CompilerOptions = tsconfig.compilerOptions;
   const demangledTables: string[] = [];
   const mangledTables: string[] = [];
@@ -115,8 +253,7 @@ async function main() {
     stdlib.EVENT_LOOP_DEFINITION,
     stdlib.PROMISE_DEFINITION,
     stdlib.PARSE_INT_DEFINITION,
-    stdlib.PARSE_FLOAT_DEFINITION,
-    stdlib.ARGS_TO_ARRAY_DEFINITION
+    stdlib.PARSE_FLOAT_DEFINITION
   ];
   options.types = [];
 
@@ -152,13 +289,11 @@ async function main() {
     options.traceResolution = true
   }
 
-  const host = ts.createCompilerHost(options);
+  const host = withSourceFilesReuse(ts.createCompilerHost(options), options);
 
   const sources = getFullProgramSources(files, options, host);
   const program = ts.createProgram(sources, options, host);
 
-  const diagnostics = ts.getPreEmitDiagnostics(program);
-
   if (argv.demangledTables && argv.mangledTables) {
     demangledTables.push(...(argv.demangledTables as string[]).map((value) => value.trim()));
     mangledTables.push(...(argv.mangledTables as string[]).map((value) => value.trim()));
@@ -175,19 +310,73 @@ async function main() {
     includeDirs.push(...unique);
   }
 
-  if (diagnostics.length > 0) {
-    process.stdout.write(ts.formatDiagnosticsWithColorAndContext(diagnostics, host));
-    process.exit(1);
+  const cache = argv.cacheDir
+    ? new CompilationCache(argv.cacheDir, program, [...mangledTables, ...demangledTables], [
+        getCompilerIdentity(),
+        getOutputKind(argv),
+        ...includeDirs,
+        String(argv.enableOptimizations),
+        String(argv.debug),
+        String(argv.target),
+      ])
+    : undefined;
+
+  if (!cache || !cache.isTypeChecked()) {
+    const diagnostics = ts.getPreEmitDiagnostics(program);
+
+    if (diagnostics.length > 0) {
+      process.stdout.write(ts.formatDiagnosticsWithColorAndContext(diagnostics, host));
+      return 1;
+    }
+
+    cache?.markTypeChecked();
   }
 
-  llvm.initializeAllTargetInfos();
-  llvm.initializeAllTargets();
-  llvm.initializeAllTargetMCs();
-  llvm.initializeAllAsmParsers();
-  llvm.initializeAllAsmPrinters();
+  const cached = cache?.get(getOutputKind(argv));
+  if (cached !== undefined) {
+    if (argv.processTemplates) {
+      const { classes, functions } = JSON.parse(cached);
+      writeFileIfChanged(path.join(argv.templatesOutputDir, TemplateInstantiator.INSTANTIATED_CLASSES_FILE), classes);
+      writeFileIfChanged(path.join(argv.templatesOutputDir, TemplateInstantiator.INSTANTIATED_FUNCTIONS_FILE), functions);
+      return 0;
+    }
+
+    if (argv.processTemplateClasses || argv.processTemplateFunctions) {
+      const templatesFile = argv.processTemplateClasses
+        ? TemplateInstantiator.INSTANTIATED_CLASSES_FILE
+        : TemplateInstantiator.INSTANTIATED_FUNCTIONS_FILE;
+      writeFileIfChanged(path.join(argv.templatesOutputDir, templatesFile), cached);
+      return 0;
+    }
+
+    if (argv.printIR) {
+      process.stdout.write(cached);
+    }
+
+    if (argv.emitIR) {
+      const outputName = files.length !== 0 ? files[0] : "a.ts";
+      new Build().writeIRToFile(cached, outputName, argv);
+    }
+
+    return 0;
+  }
+
+  initLLVM();
 
   initCXXSymbols(demangledTables, mangledTables);
 
+  // generate template classes and functions
+  if (argv.processTemplates) {
+    const templateInstantiator = new TemplateInstantiator(
+      program,
+      includeDirs,
+      argv.templatesOutputDir
+    );
+    const instantiated = templateInstantiator.instantiateAll();
+    cache?.put(getOutputKind(argv), JSON.stringify(instantiated));
+    return 0;
+  }
+
   // generate template classes
   if (argv.processTemplateClasses) {
     const templateInstantiator = new TemplateInstantiator(
@@ -195,8 +384,9 @@ async function main() {
       includeDirs,
       argv.templatesOutputDir
     );
-    templateInstantiator.instantiateClasses();
-    return;
+    const instantiated = templateInstantiator.instantiateClasses();
+    cache?.put(getOutputKind(argv), instantiated);
+    return 0;
   }
 
   // generate template functions
@@ -206,8 +396,9 @@ async function main() {
       includeDirs,
       argv.templatesOutputDir
     );
-    templateInstantiator.instantiateFunctions();
-    return;
+    const instantiated = templateInstantiator.instantiateFunctions();
+    cache?.put(getOutputKind(argv), instantiated);
+    return 0;
   }
 
   let llvmModule;
@@ -217,7 +408,7 @@ async function main() {
   } catch (e) {
     console.log(files);
     console.log(e);
-    process.exit(1);
+    return 1;
   }
 
   if (argv.target) {
@@ -228,12 +419,17 @@ async function main() {
     llvmModule.targetTriple = targetTriple;
   }
 
+  const ir = llvmModule.print();
+  cache?.put(getOutputKind(argv), ir);
+
   if (argv.printIR) {
-    process.stdout.write(llvmModule.print());
+    process.stdout.write(ir);
   }
 
   if (argv.emitIR) {
     const outputName = files.length !== 0 ? files[0] : "a.ts";
-    new Build().writeIRToFile(llvmModule, outputName, argv);
+    new Build().writeIRToFile(ir, outputName, argv);
   }
+
+  return 0;
 }
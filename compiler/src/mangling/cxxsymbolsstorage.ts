@@ -1,3 +1,4 @@
+import * as fs from "fs";
 import { CXXSymbolExtractor } from "../mangling";
 
 let cxxSymbolsStorage: CXXSymbolsStorage | undefined;
@@ -10,10 +11,23 @@ export function CXXSymbols() {
     return cxxSymbolsStorage;
 }
 
+// Tables (and their modification times) the storage was created from.
+// Compile server calls 'initCXXSymbols' for every compilation, mostly with the very same tables.
+let cxxSymbolsStorageKey: string | undefined;
+
 export function initCXXSymbols(demangledFiles: string[], mangledFiles: string[]) {
+    const withModificationTime = (files: string[]) =>
+        files.map((file) => [file, fs.existsSync(file) ? fs.statSync(file).mtimeMs : 0]);
+    const key = JSON.stringify([withModificationTime(demangledFiles), withModificationTime(mangledFiles)]);
+
+    if (cxxSymbolsStorage && key === cxxSymbolsStorageKey) {
+        return;
+    }
+
     const extractor = new CXXSymbolExtractor();
     const { demangledSymbols, mangledSymbols } = extractor.readSymbols(demangledFiles, mangledFiles);
     cxxSymbolsStorage = new CXXSymbolsStorage(demangledSymbols, mangledSymbols);
+    cxxSymbolsStorageKey = key;
 }
 
 export class CXXSymbol {
@@ -28,126 +42,70 @@ export class CXXSymbol {
     }
 }
 
+// Symbols are indexed by the names of functions (and templates) they mention: every identifier followed by
+// '(' or '<', plus 'operator'. E.g. 'Array<Number*>::push(Number*)' can be found by both 'Array' and 'push'.
+// Lookups by the name of the function being called return a short list instead of all the symbols
+// starting with the same letter.
 class CXXSymbolsStorage {
-    private readonly symbols = new Map<string, CXXSymbol[]>();
+    private static readonly NAME_PATTERN = /([A-Za-z_]\w*)\s*(?=[(<])|operator/g;
+
+    private readonly symbolsByName = new Map<string, CXXSymbol[]>();
+    private readonly vtables = new Map<string, string>();
 
     constructor(demangledLines: string[], mangledLines: string[]) {
         if (mangledLines.length !== demangledLines.length) {
             throw new Error("Symbols tables size mismatch");
         }
 
-        for (let i = 0; i < demangledLines.length; ++i) {
-            const symbol = demangledLines[i];
-            const firstLetter = this.getCXXSymbolFirstLetter(symbol);
-            const lowered = firstLetter.toLocaleLowerCase();
+        const VTABLE_PREFIX = "vtable for ";
 
-            if (!this.symbols.has(lowered)) {
-                this.symbols.set(lowered, []);
+        for (let i = 0; i < demangledLines.length; ++i) {
+            const demangled = demangledLines[i].trim();
+            if (!demangled || demangled.startsWith(".")) {
+                continue; // internal stuff
             }
 
-            this.symbols.get(lowered)!.push(new CXXSymbol(symbol, mangledLines[i]));
-        }
-
-        this.symbols.delete("."); // drop all the internal stuff
-    }
-
-    getOrCreate(key: string) {
-        if (!key) {
-            throw new Error("Empty string requested as a key at CXXSymbolsStorage.get");
-        }
-
-        key = key[0].toLowerCase();
-
-        if (!this.symbols.has(key)) {
-            this.symbols.set(key, []);
-        }
-
-        return this.symbols.get(key)!;
-    }
-
-    getVTableSymbolFor(className: string) {
-        const candidates = this.getOrCreate("v");
-
-        const cxxSymbol = candidates.find((cxxSymbol) => cxxSymbol.demangled === `vtable for ${className}`);
-        if (!cxxSymbol) {
-            throw new Error(`Unable to find vtable for '${className}'`);
-        }
-
-        return cxxSymbol.mangled;
-    }
-
-    private getSignatureMeaningPart(line: string) {
-        const OPEN_BRACKET = "(";
-
-        const openBracketIndex = line.lastIndexOf(OPEN_BRACKET);
-        if (openBracketIndex === -1) {
-            return line;
-        }
-
-        const signaturePart = line.substring(0, openBracketIndex);
-        return signaturePart;
-    }
-
-    private removeSpacesFromTemplates(line: string) {
-        const OPEN_ANGLE_BRACKET = "<";
-        const CLOSE_ANGLE_BRACKET = ">";
-
-        let result = "";
-
-        const stack: number[] = [];
+            if (demangled.startsWith(VTABLE_PREFIX)) {
+                this.vtables.set(demangled.substring(VTABLE_PREFIX.length), mangledLines[i]);
+                continue;
+            }
 
-        const isInTemplate = () => stack.length > 0;
+            const symbol = new CXXSymbol(demangledLines[i], mangledLines[i]);
+            const names = new Set<string>();
 
-        for (const char of line) {
-            if (char === OPEN_ANGLE_BRACKET) {
-                stack.push(0);
-            } else if (char === CLOSE_ANGLE_BRACKET) {
-                stack.pop();
+            const pattern = new RegExp(CXXSymbolsStorage.NAME_PATTERN);
+            for (let match = pattern.exec(demangled); match; match = pattern.exec(demangled)) {
+                names.add(match[1] || match[0]);
             }
 
-            if (isInTemplate() && char === " ") {
-                continue;
-            }
+            for (const name of names) {
+                let symbols = this.symbolsByName.get(name);
+                if (!symbols) {
+                    symbols = [];
+                    this.symbolsByName.set(name, symbols);
+                }
 
-            result += char;
+                symbols.push(symbol);
+            }
         }
-
-        return result;
     }
 
-    private getCXXSymbolFirstLetter(line: string) {
-        // demangled template includes return type in signature unlike non-template:
-        // void console::log<Number*, Number*>(Number*)
-        // in general:
-        // T<U, W<X, Y>>::N f<T<M, N>, Z>(...)
-        //
-        // 1. take substring from beginning to open bracket '('
-        // 2. remove all the whitespaces in angle brackets
-        // 3. split the result by white space:
-        //          if there is return type is signature, splitting will give exactly two parts
-        //          if there is not return type is signature, splitting will give exactly one part
-        //          some internal CXX stuff is also demangled. use it as is
-
-        line = line.trim();
-        if (!line) {
-            return line;
-        }
+    // Symbols that mention function (or template) 'name', in the order of the symbol tables.
+    // 'name' may be qualified ('ns::Class::method'), only its last component is looked up.
+    getByName(name: string): readonly CXXSymbol[] {
+        const separator = name.lastIndexOf("::");
+        const unqualified = separator < 0 ? name : name.substring(separator + 2);
+        const identifier = /^(operator|[A-Za-z_]\w*)/.exec(unqualified);
 
-        const signatureMeaningPart = this.getSignatureMeaningPart(line);
-        const signatureMeaningPartWithoutTemplateSpaces = this.removeSpacesFromTemplates(signatureMeaningPart);
-
-        const parts = signatureMeaningPartWithoutTemplateSpaces.split(" ");
-
-        let part: string = "";
+        return (identifier && this.symbolsByName.get(identifier[0])) || [];
+    }
 
-        if (parts.length === 1) {
-            part = parts[0];
-        } else if (parts.length === 2) {
-            part = parts[1];
-        } else {
-            part = line;
+    getVTableSymbolFor(className: string) {
+        const vtable = this.vtables.get(className);
+        if (!vtable) {
+            throw new Error(`Unable to find vtable for '${className}'`);
         }
 
-        return part.length > 0 ? part[0] : "";
+        return vtable;
     }
 }
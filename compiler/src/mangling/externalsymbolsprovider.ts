@@ -103,7 +103,7 @@ export class ExternalSymbolsProvider {
           `(^[a-zA-Z\ \:]*)<${qualifiedName}>(::)${this.methodName}`
         );
 
-        const symbolRange = CXXSymbols().getOrCreate(qualifiedName);
+        const symbolRange = CXXSymbols().getByName(this.methodName);
 
         return this.handleDeclarationWithPredicate((cxxSymbol) => {
           return classMethodPattern.test(cxxSymbol.demangled) || mixinPattern.test(cxxSymbol.demangled);
@@ -200,7 +200,7 @@ export class ExternalSymbolsProvider {
 
       const className = classDeclaration.name.getText();
       const qualifiedName = `${this.namespace}${className}`;
-      const symbolRange = CXXSymbols().getOrCreate(qualifiedName);
+      const symbolRange = CXXSymbols().getByName(this.thisTypeName || className);
 
       return this.handleDeclarationWithPredicate((cxxSymbol) => this.isConstructor(cxxSymbol.demangled), symbolRange);
     } else if (declaration.isFunction()) {
@@ -210,7 +210,7 @@ export class ExternalSymbolsProvider {
 
       const freeFunctionPattern = new RegExp(`(?=(^| )${qualifiedName}(\\(|<))`);
 
-      const symbolRange = CXXSymbols().getOrCreate(qualifiedName);
+      const symbolRange = CXXSymbols().getByName(this.methodName);
 
       return this.handleDeclarationWithPredicate((cxxSymbol: CXXSymbol) => {
         return freeFunctionPattern.test(cxxSymbol.demangled);
@@ -233,7 +233,7 @@ export class ExternalSymbolsProvider {
 
       const mixinPattern = new RegExp(`(^[a-zA-Z\ \:]*)<${qualifiedName}>(::)${this.methodName}`);
 
-      const symbolRange = CXXSymbols().getOrCreate(qualifiedName);
+      const symbolRange = CXXSymbols().getByName(this.methodName);
 
       return this.handleDeclarationWithPredicate((cxxSymbol: CXXSymbol) => {
         const demangled = cxxSymbol.demangled;
@@ -243,7 +243,7 @@ export class ExternalSymbolsProvider {
 
     return;
   }
-  private handleDeclarationWithPredicate(predicate: Predicate, symbolRange: CXXSymbol[]) {
+  private handleDeclarationWithPredicate(predicate: Predicate, symbolRange: readonly CXXSymbol[]) {
     let candidates: CXXSymbol[] = [];
 
     for (let i = 0; i < symbolRange.length; ++i) {
@@ -296,8 +296,18 @@ export class ExternalSymbolsProvider {
     return parameters.substring(0, parameters.length - 1);
   }
 
+  // Every call site checks parameters of all its candidates, and the same symbols are candidates over and over
+  private static readonly parameterTypesCache = new Map<string, string>();
+
   static extractParameterTypes(cppSignature: string): string {
-    return this.unqualifyParameters(this.getParametersFromSignature(cppSignature).split(","));
+    let parameterTypes = this.parameterTypesCache.get(cppSignature);
+
+    if (parameterTypes === undefined) {
+      parameterTypes = this.unqualifyParameters(this.getParametersFromSignature(cppSignature).split(","));
+      this.parameterTypesCache.set(cppSignature, parameterTypes);
+    }
+
+    return parameterTypes;
   }
   static unqualifyParameters(parameters: string[]): string {
     return parameters
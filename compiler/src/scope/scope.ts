@@ -8,6 +8,7 @@ import { LLVMConstant, LLVMValue } from "../llvm/value";
 import { Declaration } from "../ts/declaration";
 import { Signature } from "../ts/signature";
 import { LLVMFunction } from "../llvm/function";
+import { StackFrame } from "./stackframe";
 
 export class Environment {
   private readonly pVariables: string[];
@@ -16,6 +17,7 @@ export class Environment {
   private readonly pLLVMType: LLVMStructType;
   private readonly pGenerator: LLVMGenerator;
   private pFixedArgsCount: number = 0;
+  private pClosureStorage: LLVMValue | undefined;
 
   constructor(variables: string[], parameterNames: string[], allocated: LLVMValue, llvmType: LLVMStructType, generator: LLVMGenerator) {
     if (!allocated.type.isPointer() || !allocated.type.getPointerElementType().isIntegerType(8)) {
@@ -81,6 +83,22 @@ export class Environment {
     this.pFixedArgsCount = count;
   }
 
+  // Not yet constructed closure this environment is allocated along with (see createEnvironment)
+  get closureStorage() {
+    return this.pClosureStorage;
+  }
+
+  set closureStorage(storage: LLVMValue | undefined) {
+    this.pClosureStorage = storage;
+  }
+
+  // Environment as seen by a function that gets parameters as LLVM arguments (see FunctionDeclarationHandler):
+  // slots of these parameters are still there (closure calls fill them) but they are never looked up
+  withParametersPassedByValue(parameterNames: string[]) {
+    const variables = this.pVariables.map((variable) => (parameterNames.includes(variable) ? "" : variable));
+    return new Environment(variables, [], this.pAllocated, this.pLLVMType, this.pGenerator);
+  }
+
   static merge(base: Environment, envs: Environment[], generator: LLVMGenerator) {
     const baseValues = [];
 
@@ -129,7 +147,7 @@ export class Environment {
       generator,
       mergedValues.map((v) => v.type)
     );
-    const allocatedMergedEnvironment = generator.gc.allocate(mergedEnvironmentType);
+    const allocatedMergedEnvironment = generator.gc.allocateTraced(mergedEnvironmentType);
 
     for (let i = 0; i < mergedValues.length; ++i) {
       const elementPtr = generator.builder.createSafeInBoundsGEP(allocatedMergedEnvironment, [0, i]);
@@ -272,7 +290,9 @@ export function createEnvironment(
   generator: LLVMGenerator,
   functionData?: { args: LLVMValue[]; signature: Signature | undefined },
   outerEnv?: Environment,
-  preferLocalThis?: boolean
+  preferLocalThis?: boolean,
+  forClosure?: boolean,
+  onStack?: boolean
 ) {
   const map = new Map<string, { type: LLVMType; allocated: LLVMValue }>();
 
@@ -344,7 +364,7 @@ export function createEnvironment(
       // @todo: remove pointer level check
       if (extracted.type.getPointerLevel() === 2 && outerEnv.isParameterIndex(index)) {
         extracted = generator.builder.createLoad(extracted);
-        const mem = generator.gc.allocate(extracted.type);
+        const mem = generator.gc.allocateTraced(extracted.type);
         generator.builder.createSafeStore(extracted, mem);
         extracted = mem;
       }
@@ -370,7 +390,9 @@ export function createEnvironment(
   for (const [_, value] of map) {
     let allocationPtrPtr = value.allocated;
     if (allocationPtrPtr.type.getPointerLevel() === 1) {
-      allocationPtrPtr = generator.gc.allocate(value.allocated.type);
+      allocationPtrPtr = onStack
+        ? generator.builder.createEntryBlockAlloca(value.allocated.type)
+        : generator.gc.allocateTraced(value.allocated.type);
       generator.builder.createSafeStore(value.allocated, allocationPtrPtr);
     }
 
@@ -383,7 +405,22 @@ export function createEnvironment(
     LLVMConstant.createNullValue(environmentDataType, generator)
   );
 
-  const environmentAlloca = generator.gc.allocate(environmentDataType);
+  if (forClosure) {
+    // Environment goes right after the closure object, so both take a single allocation
+    const { closure, environment } = generator.tsclosure.allocateWithInlineEnvironment(environmentDataType);
+    generator.builder.createSafeStore(environmentData, environment);
+
+    const closureEnvironment = new Environment(names, parameterNames, generator.builder.asVoidStar(environment), environmentDataType, generator);
+    closureEnvironment.closureStorage = closure;
+
+    return closureEnvironment;
+  }
+
+  // Environment that lives just for a call nothing can capture it in (see ClassHierarchy.hasNoCaptures).
+  // Entry block allocas are reused by every call made by the same site, also in a loop
+  const environmentAlloca = onStack
+    ? generator.builder.createEntryBlockAlloca(environmentDataType)
+    : generator.gc.allocateTraced(environmentDataType);
   generator.builder.createSafeStore(environmentData, environmentAlloca);
 
   return new Environment(names, parameterNames, generator.builder.asVoidStar(environmentAlloca), environmentDataType, generator);
@@ -566,6 +603,8 @@ export class Scope {
   private generator: LLVMGenerator;
   private isHoisted = false;
   private isDeinitialized = false;
+  // values that are not registered as gc roots, so there is nothing to remove on deinitialization
+  private readonly unrooted = new Set<string>();
 
   constructor(name: string | undefined,
     mangledName: string | undefined,
@@ -600,7 +639,7 @@ export class Scope {
 
     for (const identifier of this.map.keys()) {
       const value = this.get(identifier);
-      if (!value || value instanceof Scope) {
+      if (!value || value instanceof Scope || this.unrooted.has(identifier)) {
         continue
       }
 
@@ -655,12 +694,18 @@ export class Scope {
       const allocated = generator.gc.allocateObject(llvmType.getPointerElementType());
       const inplaceAllocatedPtr = generator.ts.obj.createInplace(allocated);
 
-      const inplaceAllocatedPtrPtr = generator.gc.allocate(inplaceAllocatedPtr.type);
+      const stackCell = ts.isVariableDeclaration(node)
+        ? StackFrame.current(generator)?.getCell(node, inplaceAllocatedPtr.type)
+        : undefined;
+
+      const inplaceAllocatedPtrPtr = stackCell || generator.gc.allocateTraced(inplaceAllocatedPtr.type);
       generator.builder.createSafeStore(inplaceAllocatedPtr, inplaceAllocatedPtrPtr);
 
       const name = node.name.getText();
 
-      this.set(name, inplaceAllocatedPtrPtr);
+      // stack frame is a root already
+      const makeRoot = !stackCell;
+      this.set(name, inplaceAllocatedPtrPtr, makeRoot);
     }
 
     root.forEachChild(initializeFrom);
@@ -738,6 +783,10 @@ export class Scope {
 
     const extractedValue = value instanceof HeapVariableDeclaration ? value.allocated : value;
 
+    if (!makeRoot) {
+      this.unrooted.add(identifier);
+    }
+
     if (extractedValue.type.getPointerLevel() === 2) {
 
       if (makeRoot) {
@@ -748,7 +797,7 @@ export class Scope {
       return;
     }
     else if (extractedValue.type.getPointerLevel() === 1) {
-      const vPtrPtr = this.generator.gc.allocate(extractedValue.type);
+      const vPtrPtr = this.generator.gc.allocateTraced(extractedValue.type);
       this.generator.builder.createSafeStore(extractedValue, vPtrPtr);
   
       this.map.set(identifier, vPtrPtr);
@@ -0,0 +1,85 @@
+import * as ts from "typescript";
+import { LLVMGenerator } from "../generator";
+import { LLVMArrayType, LLVMType } from "../llvm/type";
+import { LLVMConstant, LLVMValue } from "../llvm/value";
+
+type SlotKey = ts.VariableDeclaration | string;
+
+// Frame record of a compiled function: stack slots for its variables no closure captures (see VariableCapture)
+// and for parameters passed as LLVM arguments. Instead of a heap cell and a gc root per variable the whole frame
+// is registered in gc once on function's entry and unregistered on return or throw, see GC::pushFrame
+export class StackFrame {
+  private readonly generator: LLVMGenerator;
+  private readonly frame: LLVMValue;
+  private readonly slots = new Map<SlotKey, number>();
+
+  private constructor(keys: SlotKey[], generator: LLVMGenerator) {
+    this.generator = generator;
+
+    keys.forEach((key, index) => this.slots.set(key, index));
+
+    const i8PtrType = LLVMType.getInt8Type(generator).getPointer();
+    const frameType = LLVMArrayType.get(generator, i8PtrType, Math.max(keys.length, 1));
+
+    this.frame = generator.builder.createAlloca(frameType);
+    generator.builder.createSafeStore(LLVMConstant.createNullValue(frameType, generator), this.frame);
+  }
+
+  // To be called at the entry block of the function being compiled.
+  // Function that catches exceptions needs a frame even without slots: catch drops frames of callees left by throw
+  static enter(body: ts.ConciseBody, parameterNames: string[], generator: LLVMGenerator) {
+    const variables = generator.ts.variableCapture.getStackVariables(body);
+    const keys: SlotKey[] = [...parameterNames, ...variables];
+
+    if (keys.length === 0 && !generator.ts.variableCapture.hasCatchClause(body)) {
+      return undefined;
+    }
+
+    return StackFrame.registerFor(new StackFrame(keys, generator), generator);
+  }
+
+  // Frame without slots, for the top level code that may catch exceptions
+  static enterWithoutSlots(generator: LLVMGenerator) {
+    return StackFrame.registerFor(new StackFrame([], generator), generator);
+  }
+
+  private static registerFor(frame: StackFrame, generator: LLVMGenerator) {
+    frame.register();
+    generator.meta.registerStackFrame(generator.currentFunction, frame);
+    return frame;
+  }
+
+  // Frame of the function being compiled, if it has one
+  static current(generator: LLVMGenerator) {
+    return generator.meta.getStackFrame(generator.currentFunction);
+  }
+
+  get slotsCount() {
+    return Math.max(this.slots.size, 1);
+  }
+
+  hasSlot(key: SlotKey) {
+    return this.slots.has(key);
+  }
+
+  // Returns 'type'* cell for 'key' or undefined if it has no slot in this frame
+  getCell(key: SlotKey, type: LLVMType) {
+    const index = this.slots.get(key);
+
+    if (index === undefined) {
+      return undefined;
+    }
+
+    const slot = this.generator.builder.createSafeInBoundsGEP(this.frame, [0, index]);
+    return this.generator.builder.createBitCast(slot, type.getPointer());
+  }
+
+  // Also called when function catches an exception: frames of callees left by it are dropped then
+  register() {
+    this.generator.gc.pushFrame(this.frame, this.slotsCount);
+  }
+
+  unregister() {
+    this.generator.gc.popFrame(this.frame);
+  }
+}
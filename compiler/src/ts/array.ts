@@ -1,12 +1,11 @@
 import { LLVMGenerator } from "../generator";
 import { TSType } from "./type";
 import * as ts from "typescript";
-import { LLVMConstantFP, LLVMValue } from "../llvm/value";
+import { LLVMConstant, LLVMConstantFP, LLVMConstantInt, LLVMValue } from "../llvm/value";
 import { addClassScope } from "../scope/scope";
 import { FunctionMangler } from "../mangling/functionmangler";
-import { LLVMType } from "../llvm/type";
+import { LLVMArrayType, LLVMType } from "../llvm/type";
 import { Declaration } from "./declaration";
-import { ArgsToArray } from "./args_to_array"
 
 const stdlib = require("std/constants");
 
@@ -17,17 +16,15 @@ export class TSArray {
 
   private readonly constructorFns = new Map<string, LLVMValue>();
   private readonly subscriptFns = new Map<string, LLVMValue>();
-  private readonly pushFns = new Map<string, LLVMValue>();
+  private readonly pushArgumentsFns = new Map<string, LLVMValue>();
   private readonly concatFns = new Map<string, LLVMValue>();
   private readonly toStringFns = new Map<string, LLVMValue>();
   private readonly iteratorFns = new Map<string, LLVMValue>();
   private readonly setElementAtIndexFns = new Map<string, LLVMValue>();
-  private readonly argsToArray: ArgsToArray;
 
   constructor(generator: LLVMGenerator) {
     this.generator = generator;
-    this.argsToArray = new ArgsToArray(this.generator);
-    
+
     this.classDeclaration = this.initClassDeclaration();
 
     this.llvmType = this.classDeclaration.getLLVMStructType("array");
@@ -157,10 +154,6 @@ export class TSArray {
     this.generator.builder.createSafeCall(ctorFn, [thisVoidStar]);
   }
 
-  getArgsToArrayConverter() {
-    return this.argsToArray;
-  }
-
   private getCtorFn(arrayType: TSType): LLVMValue {
     addClassScope(this.getDeclaration().unwrapped, this.generator.symbolTable.globalScope, this.generator);
 
@@ -200,61 +193,88 @@ export class TSArray {
     return constructor;
   }
 
-  callPush(arrayType: TSType, thisPtr: LLVMValue, objPtr: LLVMValue, isSpread: boolean) {
-    const arrayTypename = arrayType.toString();
+  // Appends 'elements' in a single runtime call, see Array::pushArguments. Spread elements are arrays or tuples
+  callPushArguments(arrayType: TSType, thisPtr: LLVMValue, elements: { value: LLVMValue; isSpread: boolean }[]) {
+    if (elements.length === 0) {
+      return;
+    }
 
-    const getOrCreatePush = () => { 
-      const maybePush = this.pushFns.get(arrayTypename);
-      if (maybePush) {
-        return maybePush;
-      }
+    const pushArgumentsFn = this.getOrCreatePushArguments(arrayType);
 
-      const pushFn = this.findPush(arrayType);
-      this.pushFns.set(arrayTypename, pushFn);
-      return pushFn;
-    }
+    const builder = this.generator.builder;
+    const i8Type = LLVMType.getInt8Type(this.generator);
+    const i8PtrType = i8Type.getPointer();
 
-    const pushFn = getOrCreatePush();
+    // arguments live on stack just for the call: it may happen in a loop
+    const stackPointer = builder.createStackSave();
 
-    const aggregatorArrPtr = this.generator.builder.createAlloca(this.llvmType.getPointerElementType());
-    this.callDefaultConstructor(aggregatorArrPtr, arrayType);
-    
-    const argsToArrayStackPtr = this.generator.builder.createAlloca(this.argsToArray.getLLVMType().getPointerElementType());
-    this.argsToArray.callConstructor(argsToArrayStackPtr, aggregatorArrPtr);
-    this.argsToArray.callAddObject(argsToArrayStackPtr, objPtr, isSpread);
+    const argsArray = builder.createAlloca(LLVMArrayType.get(this.generator, i8PtrType, elements.length));
+    elements.forEach(({ value }, index) => {
+      const slot = builder.createSafeInBoundsGEP(argsArray, [0, index]);
+      builder.createSafeStore(builder.asVoidStar(value), slot);
+    });
 
-    const thisVoidStar = this.generator.builder.asVoidStar(thisPtr);
-    const emptyArrPtrVoidStar = this.generator.builder.asVoidStar(aggregatorArrPtr);
-    this.generator.builder.createSafeCall(pushFn, [thisVoidStar, emptyArrPtrVoidStar]);
+    let spreads: LLVMValue = LLVMConstant.createNullValue(i8PtrType, this.generator);
+
+    if (elements.some(({ isSpread }) => isSpread)) {
+      const spreadsArray = builder.createAlloca(LLVMArrayType.get(this.generator, i8Type, elements.length));
+      elements.forEach(({ isSpread }, index) => {
+        const slot = builder.createSafeInBoundsGEP(spreadsArray, [0, index]);
+        builder.createSafeStore(LLVMConstantInt.get(this.generator, isSpread ? 1 : 0, 8), slot);
+      });
+
+      spreads = builder.createBitCast(spreadsArray, i8PtrType);
+    }
+
+    builder.createSafeCall(pushArgumentsFn, [
+      builder.asVoidStar(thisPtr),
+      builder.createBitCast(argsArray, i8PtrType.getPointer()),
+      LLVMConstantFP.get(this.generator, elements.length),
+      spreads,
+    ]);
+
+    builder.createStackRestore(stackPointer);
   }
 
-  private findPush(arrayType: TSType) {
-    const pushSymbol = arrayType.getProperty("push");
-    const pushDeclaration = pushSymbol.valueDeclaration;
+  private getOrCreatePushArguments(arrayType: TSType) {
+    const arrayTypename = arrayType.toString();
+
+    if (this.pushArgumentsFns.has(arrayTypename)) {
+      return this.pushArgumentsFns.get(arrayTypename)!;
+    }
+
+    const declaration = this.getDeclaration().members.find(
+      (m) => m.isMethod() && m.name?.getText() === "pushArguments"
+    );
 
-    if (!pushDeclaration) {
-      throw new Error("No declaration for Array.push found");
+    if (!declaration) {
+      throw new Error("No declaration for Array.pushArguments found");
     }
 
     const { qualifiedName, isExternalSymbol } = FunctionMangler.mangle(
-      pushDeclaration,
+      declaration,
       undefined,
       arrayType,
-      [arrayType],
-      this.generator
+      [],
+      this.generator,
+      undefined,
+      ["void**, double, bool const*"]
     );
 
     if (!isExternalSymbol) {
-      throw new Error(`Array 'push' for type '${arrayType.toString()}' not found`);
+      throw new Error(`Array 'pushArguments' for type '${arrayType.toString()}' not found`);
     }
 
-    const { fn: push } = this.generator.llvm.function.create(
-      this.generator.builtinNumber.getLLVMType(),
-      [LLVMType.getInt8Type(this.generator).getPointer(), LLVMType.getInt8Type(this.generator).getPointer()],
+    const i8PtrType = LLVMType.getInt8Type(this.generator).getPointer();
+    const { fn: pushArguments } = this.generator.llvm.function.create(
+      LLVMType.getVoidType(this.generator),
+      [i8PtrType, i8PtrType.getPointer(), LLVMType.getDoubleType(this.generator), i8PtrType],
       qualifiedName
     );
 
-    return push;
+    this.pushArgumentsFns.set(arrayTypename, pushArguments);
+
+    return pushArguments;
   }
 
   createSubscriptionCall(thisValue: LLVMValue, arrayType: TSType, index: number) {
@@ -0,0 +1,321 @@
+import * as ts from "typescript";
+import { LLVMGenerator } from "../generator";
+
+export type DirectlyCallable = ts.MethodDeclaration | ts.GetAccessorDeclaration;
+
+// Whole program class hierarchy analysis.
+// Methods live in object's properties and are called through closures taken from there, but if no class derived
+// from receiver's static type redefines a method and nothing ever writes a property with that name,
+// the method called is known at compile time and the call can be made directly.
+// Types are structural, so that holds only for classes that are nominal in fact: a private or protected member
+// makes any value of the class type an instance of it or of its derived class (see isNominal).
+export class ClassHierarchy {
+  private readonly generator: LLVMGenerator;
+
+  // class declaration -> classes that extend it directly
+  private readonly derivedClasses = new Map<ts.ClassLikeDeclaration, ts.ClassLikeDeclaration[]>();
+  // names of properties that are assigned or deleted somewhere in the program
+  private readonly writtenProperties = new Set<string>();
+  // set if something that may be a class instance has a property written by computed key
+  private hasDynamicWrites = false;
+  // classes named in 'implements' clauses
+  private readonly implementedClasses = new Set<ts.ClassLikeDeclaration>();
+
+  private readonly directlyCallableCache = new Map<ts.Declaration, boolean>();
+  private readonly capturingCache = new Map<ts.Declaration, boolean>();
+
+  constructor(generator: LLVMGenerator) {
+    this.generator = generator;
+
+    for (const sourceFile of generator.program.getSourceFiles()) {
+      if (!sourceFile.isDeclarationFile) {
+        this.visit(sourceFile);
+      }
+    }
+  }
+
+  // Returns declaration of the method (or getter) called by 'expression' if it is the only possible target
+  getMonomorphicTarget(expression: ts.PropertyAccessExpression): DirectlyCallable | undefined {
+    if (expression.questionDotToken || expression.expression.kind === ts.SyntaxKind.SuperKeyword) {
+      return undefined;
+    }
+
+    const checker = this.generator.ts.checker.unwrap();
+
+    // instances of classes only: not unions, interfaces or constructors (static members)
+    const receiverType = checker.getTypeAtLocation(expression.expression);
+    const receiverDeclaration = receiverType.getSymbol()?.valueDeclaration;
+
+    if (!receiverType.isClass() || !receiverDeclaration || !ts.isClassLike(receiverDeclaration)) {
+      return undefined;
+    }
+
+    if (!this.isNominal(receiverDeclaration)) {
+      return undefined;
+    }
+
+    const target = checker.getSymbolAtLocation(expression)?.valueDeclaration;
+
+    if (!target || !(ts.isMethodDeclaration(target) || ts.isGetAccessorDeclaration(target))) {
+      return undefined;
+    }
+
+    if (ts.getCombinedModifierFlags(target) & ts.ModifierFlags.Static) {
+      return undefined;
+    }
+
+    const name = expression.name.text;
+
+    if (this.hasDynamicWrites || this.writtenProperties.has(name)) {
+      return undefined;
+    }
+
+    if (!this.isDirectlyCallable(target) || !this.isFinalFor(receiverDeclaration, name)) {
+      return undefined;
+    }
+
+    return target;
+  }
+
+  // True if 'method' has no nested functions or classes that may keep its 'this' or parameters after it returns
+  hasNoCaptures(method: DirectlyCallable) {
+    let result = this.capturingCache.get(method);
+
+    if (result === undefined) {
+      result = !ClassHierarchy.containsFunctionOrClass(method.body!);
+      this.capturingCache.set(method, result);
+    }
+
+    return result;
+  }
+
+  private static containsFunctionOrClass(node: ts.Node): boolean {
+    if (ts.isFunctionLike(node) || ts.isClassLike(node)) {
+      return true;
+    }
+
+    return Boolean(ts.forEachChild(node, ClassHierarchy.containsFunctionOrClass));
+  }
+
+  // Object literal, instance of another class of the same shape or of a class that implements 'declaration'
+  // may be typed as 'declaration' unless it has a private or protected member of its own or of its base.
+  // Then only 'implements' is left, and it does not type check either (still, it is looked for to be sure)
+  private isNominal(declaration: ts.ClassLikeDeclaration): boolean {
+    if (this.implementedClasses.has(declaration)) {
+      return false;
+    }
+
+    if (declaration.members.some((member) => ClassHierarchy.isPrivateMember(member))) {
+      return true;
+    }
+
+    const base = this.getBaseClass(declaration);
+    return Boolean(base) && this.isNominal(base!);
+  }
+
+  private static isPrivateMember(member: ts.ClassElement) {
+    const isPrivate = (node: ts.Declaration) =>
+      Boolean(ts.getCombinedModifierFlags(node) & (ts.ModifierFlags.Private | ts.ModifierFlags.Protected));
+
+    if (ts.isConstructorDeclaration(member)) {
+      return member.parameters.some(isPrivate);
+    }
+
+    return isPrivate(member) || Boolean(member.name && ts.isPrivateIdentifier(member.name));
+  }
+
+  // True if none of the classes derived from 'declaration' declare member 'name'
+  private isFinalFor(declaration: ts.ClassLikeDeclaration, name: string): boolean {
+    return (this.derivedClasses.get(declaration) || []).every((derived) => {
+      const redeclares = derived.members.some((member) => member.name && member.name.getText() === name);
+      return !redeclares && this.isFinalFor(derived, name);
+    });
+  }
+
+  // Methods are compiled separately for direct calls with environment of their own,
+  // so they must not depend on anything but 'this', arguments and top level (or ambient) declarations
+  private isDirectlyCallable(method: DirectlyCallable) {
+    let result = this.directlyCallableCache.get(method);
+
+    if (result === undefined) {
+      result = this.checkDirectlyCallable(method);
+      this.directlyCallableCache.set(method, result);
+    }
+
+    return result;
+  }
+
+  private checkDirectlyCallable(method: DirectlyCallable) {
+    const classDeclaration = method.parent;
+
+    if (
+      !method.body ||
+      method.questionToken ||
+      method.typeParameters ||
+      method.parameters.some((p) => p.dotDotDotToken || p.initializer || p.questionToken) ||
+      method.getSourceFile().isDeclarationFile ||
+      !ts.isClassLike(classDeclaration) ||
+      !this.isPlainClass(classDeclaration)
+    ) {
+      return false;
+    }
+
+    const checker = this.generator.ts.checker.unwrap();
+
+    const isTopLevel = (declaration: ts.Declaration) => {
+      if (declaration.getSourceFile().isDeclarationFile) {
+        return true;
+      }
+
+      let node: ts.Node = declaration;
+
+      if (ts.isVariableDeclaration(node)) {
+        node = node.parent.parent; // VariableDeclarationList, VariableStatement
+      }
+
+      return (
+        ts.isSourceFile(node.parent) &&
+        (ts.isVariableStatement(node) ||
+          ts.isFunctionDeclaration(node) ||
+          ts.isClassDeclaration(node) ||
+          ts.isEnumDeclaration(node))
+      );
+    };
+
+    const isInsideMethod = (node: ts.Node | undefined): boolean => {
+      return Boolean(node) && (node === method || isInsideMethod(node!.parent));
+    };
+
+    let selfContained = true;
+
+    const visit = (node: ts.Node) => {
+      if (!selfContained) {
+        return;
+      }
+
+      if (node.kind === ts.SyntaxKind.SuperKeyword || ts.isShorthandPropertyAssignment(node)) {
+        selfContained = false;
+        return;
+      }
+
+      if (ts.isIdentifier(node) && !(ts.isPropertyAccessExpression(node.parent) && node.parent.name === node)) {
+        if (node.text === "arguments") {
+          selfContained = false;
+          return;
+        }
+
+        const symbol = checker.getSymbolAtLocation(node);
+        const declaration = symbol?.valueDeclaration;
+
+        if (declaration && !isInsideMethod(declaration) && !isTopLevel(declaration)) {
+          selfContained = false;
+          return;
+        }
+      }
+
+      ts.forEachChild(node, visit);
+    };
+
+    ts.forEachChild(method.body, visit);
+
+    return selfContained;
+  }
+
+  // Non-generic class of this program that has no C++ class among its bases (those get vtable patched)
+  private isPlainClass(declaration: ts.ClassLikeDeclaration): boolean {
+    if (declaration.typeParameters || declaration.getSourceFile().isDeclarationFile) {
+      return false;
+    }
+
+    const base = this.getBaseClass(declaration);
+    return !base || this.isPlainClass(base);
+  }
+
+  private getBaseClass(declaration: ts.ClassLikeDeclaration) {
+    const extendsClause = declaration.heritageClauses?.find((clause) => clause.token === ts.SyntaxKind.ExtendsKeyword);
+
+    if (!extendsClause || extendsClause.types.length === 0) {
+      return undefined;
+    }
+
+    const checker = this.generator.ts.checker.unwrap();
+    let symbol = checker.getSymbolAtLocation(extendsClause.types[0].expression);
+
+    if (symbol && symbol.flags & ts.SymbolFlags.Alias) {
+      symbol = checker.getAliasedSymbol(symbol);
+    }
+
+    const base = symbol?.valueDeclaration;
+    return base && ts.isClassLike(base) ? base : undefined;
+  }
+
+  private visit(node: ts.Node) {
+    if (ts.isClassLike(node)) {
+      const base = this.getBaseClass(node);
+
+      if (base) {
+        this.derivedClasses.set(base, [...(this.derivedClasses.get(base) || []), node]);
+      }
+
+      this.registerImplements(node);
+    }
+
+    if (ts.isBinaryExpression(node) && this.isAssignment(node.operatorToken.kind)) {
+      this.registerWrite(node.left);
+    }
+
+    if (ts.isDeleteExpression(node)) {
+      this.registerWrite(node.expression);
+    }
+
+    ts.forEachChild(node, (child) => this.visit(child));
+  }
+
+  private registerImplements(declaration: ts.ClassLikeDeclaration) {
+    const checker = this.generator.ts.checker.unwrap();
+    const clauses = declaration.heritageClauses || [];
+
+    for (const clause of clauses.filter((c) => c.token === ts.SyntaxKind.ImplementsKeyword)) {
+      for (const type of clause.types) {
+        let symbol = checker.getSymbolAtLocation(type.expression);
+
+        if (symbol && symbol.flags & ts.SymbolFlags.Alias) {
+          symbol = checker.getAliasedSymbol(symbol);
+        }
+
+        const implemented = symbol?.valueDeclaration;
+        if (implemented && ts.isClassLike(implemented)) {
+          this.implementedClasses.add(implemented);
+        }
+      }
+    }
+  }
+
+  private registerWrite(target: ts.Expression) {
+    if (ts.isPropertyAccessExpression(target)) {
+      this.writtenProperties.add(target.name.text);
+      return;
+    }
+
+    if (!ts.isElementAccessExpression(target)) {
+      return;
+    }
+
+    if (ts.isStringLiteralLike(target.argumentExpression)) {
+      this.writtenProperties.add(target.argumentExpression.text);
+      return;
+    }
+
+    // arr[i] = ... (std containers are declared in .d.ts) is fine, obj[key] = ... may replace any method
+    const objectType = this.generator.ts.checker.unwrap().getTypeAtLocation(target.expression);
+    const objectDeclaration = objectType.getSymbol()?.valueDeclaration || objectType.getSymbol()?.declarations?.[0];
+
+    if (!objectDeclaration || !objectDeclaration.getSourceFile().isDeclarationFile) {
+      this.hasDynamicWrites = true;
+    }
+  }
+
+  private isAssignment(kind: ts.SyntaxKind) {
+    return kind >= ts.SyntaxKind.FirstAssignment && kind <= ts.SyntaxKind.LastAssignment;
+  }
+}
@@ -0,0 +1,383 @@
+import * as ts from "typescript";
+import { LLVMGenerator } from "../generator";
+import { NumericLowering } from "../handlers/numericlowering";
+
+const stdlib = require("std/constants");
+
+export type ConstantValue = number | string | boolean;
+
+type NumberFunction = (...args: number[]) => ConstantValue;
+
+// Members of std Math and Number whose results depend on arguments only.
+// Folding must give what the runtime computes, so functions whose std implementation may differ
+// from V8 (sin, exp, pow..., round of large halves) are evaluated at runtime
+const MATH_CONSTANTS = new Map<string, number>([
+  ["E", Math.E],
+  ["LN2", Math.LN2],
+  ["LN10", Math.LN10],
+  ["LOG2E", Math.LOG2E],
+  ["LOG10E", Math.LOG10E],
+  ["PI", Math.PI],
+  ["SQRT1_2", Math.SQRT1_2],
+  ["SQRT2", Math.SQRT2],
+]);
+
+const MATH_FUNCTIONS = new Map<string, NumberFunction>([
+  ["abs", Math.abs],
+  ["ceil", Math.ceil],
+  ["floor", Math.floor],
+  ["sign", Math.sign],
+  ["sqrt", Math.sqrt],
+  ["trunc", Math.trunc],
+  // std::min and std::max pick the first of equal arguments
+  ["min", (a: number, b: number) => (isNaN(a) || isNaN(b) ? NaN : b < a ? b : a)],
+  ["max", (a: number, b: number) => (isNaN(a) || isNaN(b) ? NaN : a < b ? b : a)],
+]);
+
+const NUMBER_CONSTANTS = new Map<string, number>([
+  ["NaN", Number.NaN],
+  ["POSITIVE_INFINITY", Number.POSITIVE_INFINITY],
+  ["NEGATIVE_INFINITY", Number.NEGATIVE_INFINITY],
+  ["EPSILON", Number.EPSILON],
+  ["MAX_VALUE", Number.MAX_VALUE],
+  ["MIN_VALUE", Number.MIN_VALUE],
+  ["MAX_SAFE_INTEGER", Number.MAX_SAFE_INTEGER],
+  ["MIN_SAFE_INTEGER", Number.MIN_SAFE_INTEGER],
+]);
+
+const NUMBER_FUNCTIONS = new Map<string, NumberFunction>([
+  ["isNaN", Number.isNaN],
+  ["isFinite", Number.isFinite],
+  ["isInteger", Number.isInteger],
+  ["isSafeInteger", Number.isSafeInteger],
+]);
+
+// Compile time evaluation of expressions over literals, 'const' variables initialized by such expressions
+// and pure members of std Math and Number. Operators follow ECMAScript as the runtime does,
+// e.g. number to string conversion of std is the one of Number::toString
+export class ConstantFolding {
+  private readonly generator: LLVMGenerator;
+  private readonly cache = new Map<ts.Node, ConstantValue | undefined>();
+  private readonly inProgress = new Set<ts.Node>();
+
+  constructor(generator: LLVMGenerator) {
+    this.generator = generator;
+  }
+
+  // Value of 'expression' if it is known at compile time, undefined otherwise
+  evaluate(expression: ts.Expression): ConstantValue | undefined {
+    if (this.cache.has(expression)) {
+      return this.cache.get(expression);
+    }
+
+    // 'const a = b; const b = a;' does not type check, but let it not hang the compiler either
+    if (this.inProgress.has(expression)) {
+      return undefined;
+    }
+
+    this.inProgress.add(expression);
+    const result = this.evaluateExpression(expression);
+    this.inProgress.delete(expression);
+
+    this.cache.set(expression, result);
+    return result;
+  }
+
+  private evaluateExpression(expression: ts.Expression): ConstantValue | undefined {
+    if (ts.isParenthesizedExpression(expression)) {
+      return this.evaluate(expression.expression);
+    }
+
+    if (ts.isNumericLiteral(expression)) {
+      return Number(expression.text);
+    }
+
+    if (ts.isStringLiteral(expression) || ts.isNoSubstitutionTemplateLiteral(expression)) {
+      return expression.text;
+    }
+
+    if (expression.kind === ts.SyntaxKind.TrueKeyword) {
+      return true;
+    }
+
+    if (expression.kind === ts.SyntaxKind.FalseKeyword) {
+      return false;
+    }
+
+    if (ts.isPrefixUnaryExpression(expression)) {
+      return this.evaluatePrefixUnary(expression);
+    }
+
+    if (ts.isBinaryExpression(expression)) {
+      return this.evaluateBinary(expression);
+    }
+
+    if (ts.isTemplateExpression(expression)) {
+      return this.evaluateTemplate(expression);
+    }
+
+    if (ts.isConditionalExpression(expression)) {
+      const condition = this.evaluate(expression.condition);
+      return condition === undefined
+        ? undefined
+        : this.evaluate(condition ? expression.whenTrue : expression.whenFalse);
+    }
+
+    if (ts.isIdentifier(expression)) {
+      return this.evaluateIdentifier(expression);
+    }
+
+    if (ts.isPropertyAccessExpression(expression)) {
+      return this.evaluatePropertyAccess(expression);
+    }
+
+    if (ts.isCallExpression(expression)) {
+      return this.evaluateCall(expression);
+    }
+
+    return undefined;
+  }
+
+  private evaluatePrefixUnary(expression: ts.PrefixUnaryExpression) {
+    const operand = this.evaluate(expression.operand);
+
+    if (operand === undefined) {
+      return undefined;
+    }
+
+    switch (expression.operator) {
+      case ts.SyntaxKind.ExclamationToken:
+        return !operand;
+      case ts.SyntaxKind.MinusToken:
+        return typeof operand === "number" ? -operand : undefined;
+      case ts.SyntaxKind.PlusToken:
+        return typeof operand === "number" ? operand : undefined;
+      case ts.SyntaxKind.TildeToken:
+        return typeof operand === "number" ? ~operand : undefined;
+      default:
+        return undefined;
+    }
+  }
+
+  private evaluateBinary(expression: ts.BinaryExpression): ConstantValue | undefined {
+    const left = this.evaluate(expression.left);
+    if (left === undefined) {
+      return undefined;
+    }
+
+    const operator = expression.operatorToken.kind;
+
+    // right operand is not evaluated at runtime either
+    if (operator === ts.SyntaxKind.AmpersandAmpersandToken && !left) {
+      return left;
+    }
+
+    if (operator === ts.SyntaxKind.BarBarToken && left) {
+      return left;
+    }
+
+    const right = this.evaluate(expression.right);
+    if (right === undefined) {
+      return undefined;
+    }
+
+    switch (operator) {
+      case ts.SyntaxKind.AmpersandAmpersandToken:
+      case ts.SyntaxKind.BarBarToken:
+        return right;
+      case ts.SyntaxKind.PlusToken:
+        if (typeof left === "string" || typeof right === "string") {
+          return String(left) + String(right);
+        }
+
+        break;
+      case ts.SyntaxKind.EqualsEqualsEqualsToken:
+        return left === right;
+      case ts.SyntaxKind.ExclamationEqualsEqualsToken:
+        return left !== right;
+      case ts.SyntaxKind.EqualsEqualsToken:
+        return typeof left === typeof right ? left === right : undefined;
+      case ts.SyntaxKind.ExclamationEqualsToken:
+        return typeof left === typeof right ? left !== right : undefined;
+      default:
+        break;
+    }
+
+    if (typeof left !== "number" || typeof right !== "number") {
+      return undefined;
+    }
+
+    return ConstantFolding.evaluateNumeric(operator, left, right);
+  }
+
+  private static evaluateNumeric(operator: ts.SyntaxKind, left: number, right: number): ConstantValue | undefined {
+    switch (operator) {
+      case ts.SyntaxKind.PlusToken:
+        return left + right;
+      case ts.SyntaxKind.MinusToken:
+        return left - right;
+      case ts.SyntaxKind.AsteriskToken:
+        return left * right;
+      case ts.SyntaxKind.SlashToken:
+        return left / right;
+      case ts.SyntaxKind.PercentToken:
+        return left % right;
+      case ts.SyntaxKind.AmpersandToken:
+        return left & right;
+      case ts.SyntaxKind.BarToken:
+        return left | right;
+      case ts.SyntaxKind.CaretToken:
+        return left ^ right;
+      case ts.SyntaxKind.LessThanLessThanToken:
+        return left << right;
+      case ts.SyntaxKind.GreaterThanGreaterThanToken:
+        return left >> right;
+      case ts.SyntaxKind.GreaterThanGreaterThanGreaterThanToken:
+        return left >>> right;
+      case ts.SyntaxKind.LessThanToken:
+        return left < right;
+      case ts.SyntaxKind.LessThanEqualsToken:
+        return left <= right;
+      case ts.SyntaxKind.GreaterThanToken:
+        return left > right;
+      case ts.SyntaxKind.GreaterThanEqualsToken:
+        return left >= right;
+      default:
+        return undefined;
+    }
+  }
+
+  private evaluateTemplate(expression: ts.TemplateExpression) {
+    let result = expression.head.text;
+
+    for (const span of expression.templateSpans) {
+      const value = this.evaluate(span.expression);
+      if (value === undefined) {
+        return undefined;
+      }
+
+      result += String(value) + span.literal.text;
+    }
+
+    return result;
+  }
+
+  private evaluateIdentifier(identifier: ts.Identifier) {
+    const checker = this.generator.ts.checker.unwrap();
+
+    let symbol = checker.getSymbolAtLocation(identifier);
+    if (symbol && symbol.flags & ts.SymbolFlags.Alias) {
+      symbol = checker.getAliasedSymbol(symbol);
+    }
+
+    const declaration = symbol?.valueDeclaration;
+    if (
+      !declaration ||
+      !ts.isVariableDeclaration(declaration) ||
+      !ts.isIdentifier(declaration.name) ||
+      !declaration.initializer ||
+      declaration.getSourceFile().isDeclarationFile
+    ) {
+      return undefined;
+    }
+
+    const list = declaration.parent;
+    if (!ts.isVariableDeclarationList(list) || !(list.flags & ts.NodeFlags.Const)) {
+      return undefined;
+    }
+
+    return this.evaluate(declaration.initializer);
+  }
+
+  private evaluatePropertyAccess(expression: ts.PropertyAccessExpression) {
+    const name = expression.name.text;
+
+    if (name === "length") {
+      return this.evaluateLength(expression.expression);
+    }
+
+    const owner = this.getStdOwner(expression);
+
+    if (owner === "Math") {
+      return MATH_CONSTANTS.get(name);
+    }
+
+    if (owner === "Number") {
+      return NUMBER_CONSTANTS.get(name);
+    }
+
+    return undefined;
+  }
+
+  private evaluateLength(expression: ts.Expression) {
+    expression = NumericLowering.skipParentheses(expression);
+
+    if (ts.isArrayLiteralExpression(expression)) {
+      const isConstant = expression.elements.every(
+        (element) => !ts.isSpreadElement(element) && this.evaluate(element) !== undefined
+      );
+      return isConstant ? expression.elements.length : undefined;
+    }
+
+    const value = this.evaluate(expression);
+
+    // std strings are UTF-8, their lengths match the ones of ECMAScript for ASCII only
+    if (typeof value === "string" && /^[\x00-\x7f]*$/.test(value)) {
+      return value.length;
+    }
+
+    return undefined;
+  }
+
+  private evaluateCall(expression: ts.CallExpression) {
+    if (!ts.isPropertyAccessExpression(expression.expression)) {
+      return undefined;
+    }
+
+    const owner = this.getStdOwner(expression.expression);
+    const name = expression.expression.name.text;
+
+    const fn =
+      owner === "Math" ? MATH_FUNCTIONS.get(name) : owner === "Number" ? NUMBER_FUNCTIONS.get(name) : undefined;
+
+    if (!fn || fn.length !== expression.arguments.length) {
+      return undefined;
+    }
+
+    const args: number[] = [];
+
+    for (const argument of expression.arguments) {
+      const value = this.evaluate(argument);
+      if (typeof value !== "number") {
+        return undefined;
+      }
+
+      args.push(value);
+    }
+
+    return fn(...args);
+  }
+
+  // 'Math' or 'Number' if 'expression' refers to a static member of std class of that name
+  private getStdOwner(expression: ts.PropertyAccessExpression) {
+    const symbol = this.generator.ts.checker.unwrap().getSymbolAtLocation(expression);
+    const declaration = symbol?.valueDeclaration;
+    const owner = declaration?.parent;
+
+    if (!owner || !ts.isClassDeclaration(owner) || !owner.name) {
+      return undefined;
+    }
+
+    const fileName = owner.getSourceFile().fileName;
+    const className = owner.name.text;
+
+    if (
+      (className === "Math" && fileName === stdlib.MATH_DEFINITION) ||
+      (className === "Number" && fileName === stdlib.NUMBER_DEFINITION)
+    ) {
+      return className;
+    }
+
+    return undefined;
+  }
+}
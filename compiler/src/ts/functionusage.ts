@@ -0,0 +1,155 @@
+import * as ts from "typescript";
+import { LLVMGenerator } from "../generator";
+
+// Whole program analysis of function declarations usage.
+// Function declaration is called through its closure with arguments stored into the closure's environment.
+// If the function is never used as a value (it is only called by name) nobody but these calls can reach it,
+// so it can get parameters as plain LLVM arguments instead, see FunctionDeclarationHandler.
+export class FunctionUsage {
+  private readonly generator: LLVMGenerator;
+
+  // function declaration -> true while every reference to it is a call with all the arguments provided
+  private readonly calledOnly = new Map<ts.FunctionDeclaration, boolean>();
+
+  private readonly passesArgumentsCache = new Map<ts.FunctionDeclaration, boolean>();
+
+  constructor(generator: LLVMGenerator) {
+    this.generator = generator;
+
+    const sourceFiles = generator.program.getSourceFiles().filter((sourceFile) => !sourceFile.isDeclarationFile);
+
+    for (const sourceFile of sourceFiles) {
+      this.collectDeclarations(sourceFile);
+    }
+
+    if (this.calledOnly.size === 0) {
+      return;
+    }
+
+    const names = new Set(Array.from(this.calledOnly.keys()).map((declaration) => declaration.name!.text));
+
+    for (const sourceFile of sourceFiles) {
+      this.visitReferences(sourceFile, names);
+    }
+  }
+
+  // True if 'declaration' may be compiled with parameters passed as LLVM arguments
+  canPassArgumentsDirectly(declaration: ts.FunctionDeclaration) {
+    if (!this.calledOnly.get(declaration)) {
+      return false;
+    }
+
+    let result = this.passesArgumentsCache.get(declaration);
+
+    if (result === undefined) {
+      result = this.hasSelfContainedParameters(declaration);
+      this.passesArgumentsCache.set(declaration, result);
+    }
+
+    return result;
+  }
+
+  // Parameters live in the function's own frame, so nothing inside the body may capture them (no nested functions
+  // or classes) and body may not depend on the way function is called ('this', 'arguments')
+  private hasSelfContainedParameters(declaration: ts.FunctionDeclaration) {
+    let selfContained = true;
+
+    const visit = (node: ts.Node) => {
+      if (!selfContained) {
+        return;
+      }
+
+      if (
+        ts.isFunctionDeclaration(node) ||
+        ts.isFunctionExpression(node) ||
+        ts.isArrowFunction(node) ||
+        ts.isMethodDeclaration(node) ||
+        ts.isGetAccessorDeclaration(node) ||
+        ts.isSetAccessorDeclaration(node) ||
+        ts.isClassLike(node) ||
+        node.kind === ts.SyntaxKind.ThisKeyword ||
+        node.kind === ts.SyntaxKind.SuperKeyword ||
+        (ts.isIdentifier(node) && node.text === "arguments")
+      ) {
+        selfContained = false;
+        return;
+      }
+
+      ts.forEachChild(node, visit);
+    };
+
+    ts.forEachChild(declaration.body!, visit);
+
+    return selfContained;
+  }
+
+  private collectDeclarations(node: ts.Node) {
+    if (ts.isFunctionDeclaration(node) && this.isCandidate(node)) {
+      this.calledOnly.set(node, true);
+    }
+
+    // declarations nested into functions are compiled as many times as their parents are
+    if (ts.isFunctionLike(node) || ts.isClassLike(node) || ts.isModuleDeclaration(node)) {
+      return;
+    }
+
+    ts.forEachChild(node, (child) => this.collectDeclarations(child));
+  }
+
+  private isCandidate(declaration: ts.FunctionDeclaration) {
+    const flags = ts.getCombinedModifierFlags(declaration);
+
+    if (
+      !declaration.name ||
+      !declaration.body ||
+      declaration.asteriskToken ||
+      declaration.typeParameters ||
+      flags & (ts.ModifierFlags.Ambient | ts.ModifierFlags.Async | ts.ModifierFlags.Export | ts.ModifierFlags.Default)
+    ) {
+      return false;
+    }
+
+    const parametersArePlain = declaration.parameters.every(
+      (p) => ts.isIdentifier(p.name) && !p.dotDotDotToken && !p.initializer && !p.questionToken
+    );
+
+    if (!parametersArePlain) {
+      return false;
+    }
+
+    // overloads
+    const symbol = this.generator.ts.checker.unwrap().getSymbolAtLocation(declaration.name);
+    return Boolean(symbol) && symbol!.declarations.length === 1;
+  }
+
+  private visitReferences(node: ts.Node, names: Set<string>) {
+    if (ts.isIdentifier(node) && names.has(node.text)) {
+      this.registerReference(node);
+    }
+
+    ts.forEachChild(node, (child) => this.visitReferences(child, names));
+  }
+
+  private registerReference(identifier: ts.Identifier) {
+    const declaration = this.generator.ts.checker.unwrap().getSymbolAtLocation(identifier)?.valueDeclaration;
+
+    if (!declaration || !ts.isFunctionDeclaration(declaration) || !this.calledOnly.has(declaration)) {
+      return;
+    }
+
+    if (declaration.name === identifier) {
+      return;
+    }
+
+    const call = identifier.parent;
+    const isPlainCall =
+      ts.isCallExpression(call) &&
+      call.expression === identifier &&
+      call.arguments.length === declaration.parameters.length &&
+      !call.arguments.some(ts.isSpreadElement);
+
+    if (!isPlainCall) {
+      this.calledOnly.set(declaration, false);
+    }
+  }
+}
@@ -0,0 +1,160 @@
+import * as ts from "typescript";
+import { LLVMGenerator } from "../generator";
+import { LLVMValue } from "../llvm/value";
+import { NumericLowering } from "../handlers/numericlowering";
+
+// Counters of counted for-loops: 'for (let i = <number>; <condition>; i++)' where only the incrementor
+// ('i++', '++i', 'i--', '--i', 'i += <number>', 'i -= <number>') changes 'i' and no closure captures it.
+// Such a counter lives in a raw double cell: numeric operations use it as is and the other reads box a fresh Number.
+// Captured counters keep their per-iteration copies, see LoopHandler
+export class InductionVariables {
+  private readonly generator: LLVMGenerator;
+  private readonly cache = new Map<ts.ForStatement, ts.VariableDeclaration | undefined>();
+  private readonly cells = new Map<ts.VariableDeclaration, LLVMValue>();
+
+  constructor(generator: LLVMGenerator) {
+    this.generator = generator;
+  }
+
+  // Counter declaration of 'statement' if it is a counted loop
+  find(statement: ts.ForStatement) {
+    if (!this.cache.has(statement)) {
+      this.cache.set(statement, this.findCounter(statement));
+    }
+
+    return this.cache.get(statement);
+  }
+
+  // Double* cell of counter is valid while its loop is being compiled
+  register(declaration: ts.VariableDeclaration, cell: LLVMValue) {
+    this.cells.set(declaration, cell);
+  }
+
+  unregister(declaration: ts.VariableDeclaration) {
+    this.cells.delete(declaration);
+  }
+
+  // Double* cell if 'identifier' refers to a counter of the loop being compiled
+  getCell(identifier: ts.Identifier) {
+    if (this.cells.size === 0) {
+      return undefined;
+    }
+
+    const declaration = this.generator.ts.checker.unwrap().getSymbolAtLocation(identifier)?.valueDeclaration;
+    return declaration && ts.isVariableDeclaration(declaration) ? this.cells.get(declaration) : undefined;
+  }
+
+  private findCounter(statement: ts.ForStatement) {
+    const list = statement.initializer;
+
+    if (
+      !list ||
+      !ts.isVariableDeclarationList(list) ||
+      !(list.flags & ts.NodeFlags.Let) ||
+      list.declarations.length !== 1 ||
+      !statement.incrementor
+    ) {
+      return undefined;
+    }
+
+    const declaration = list.declarations[0];
+
+    if (!ts.isIdentifier(declaration.name) || !declaration.initializer || !this.isNumber(declaration.name)) {
+      return undefined;
+    }
+
+    const name = declaration.name.text;
+
+    if (!this.isCounterUpdate(statement.incrementor, name)) {
+      return undefined;
+    }
+
+    const isCaptured = !this.generator.ts.variableCapture.getStackVariables(statement).includes(declaration);
+    if (isCaptured) {
+      return undefined;
+    }
+
+    const incrementorOperands = ts.isBinaryExpression(statement.incrementor) ? [statement.incrementor.right] : [];
+    const nodes = [statement.condition, statement.statement, ...incrementorOperands];
+
+    if (nodes.some((node) => node && this.writesTo(node, name))) {
+      return undefined;
+    }
+
+    return declaration;
+  }
+
+  private isCounterUpdate(incrementor: ts.Expression, name: string) {
+    incrementor = NumericLowering.skipParentheses(incrementor);
+
+    if (ts.isPrefixUnaryExpression(incrementor) || ts.isPostfixUnaryExpression(incrementor)) {
+      return (
+        (incrementor.operator === ts.SyntaxKind.PlusPlusToken ||
+          incrementor.operator === ts.SyntaxKind.MinusMinusToken) &&
+        InductionVariables.isNamed(incrementor.operand, name)
+      );
+    }
+
+    return (
+      ts.isBinaryExpression(incrementor) &&
+      (incrementor.operatorToken.kind === ts.SyntaxKind.PlusEqualsToken ||
+        incrementor.operatorToken.kind === ts.SyntaxKind.MinusEqualsToken) &&
+      InductionVariables.isNamed(incrementor.left, name) &&
+      this.isNumber(incrementor.right)
+    );
+  }
+
+  // Conservative: any destructuring assignment mentioning 'name' counts as a write.
+  // Shorthand property '{ i }' is resolved by name later, so it disqualifies the counter as well
+  private writesTo(node: ts.Node, name: string): boolean {
+    if (ts.isPrefixUnaryExpression(node) || ts.isPostfixUnaryExpression(node)) {
+      const isUpdate =
+        node.operator === ts.SyntaxKind.PlusPlusToken || node.operator === ts.SyntaxKind.MinusMinusToken;
+
+      if (isUpdate && InductionVariables.isNamed(node.operand, name)) {
+        return true;
+      }
+    }
+
+    if (ts.isBinaryExpression(node) && InductionVariables.isAssignment(node.operatorToken.kind)) {
+      const target = NumericLowering.skipParentheses(node.left);
+
+      if (InductionVariables.isNamed(target, name)) {
+        return true;
+      }
+
+      const isDestructuring = ts.isArrayLiteralExpression(target) || ts.isObjectLiteralExpression(target);
+      if (isDestructuring && this.mentions(target, name)) {
+        return true;
+      }
+    }
+
+    if (ts.isShorthandPropertyAssignment(node) && node.name.text === name) {
+      return true;
+    }
+
+    return Boolean(ts.forEachChild(node, (child) => this.writesTo(child, name)));
+  }
+
+  private mentions(node: ts.Node, name: string): boolean {
+    if (ts.isIdentifier(node) && node.text === name) {
+      return true;
+    }
+
+    return Boolean(ts.forEachChild(node, (child) => this.mentions(child, name)));
+  }
+
+  private isNumber(expression: ts.Expression) {
+    const type = this.generator.ts.checker.getTypeAtLocation(expression);
+    return type.isNumber() && !type.isEnum();
+  }
+
+  private static isNamed(expression: ts.Expression, name: string) {
+    expression = NumericLowering.skipParentheses(expression);
+    return ts.isIdentifier(expression) && expression.text === name;
+  }
+
+  private static isAssignment(kind: ts.SyntaxKind) {
+    return kind >= ts.SyntaxKind.FirstAssignment && kind <= ts.SyntaxKind.LastAssignment;
+  }
+}
@@ -1,9 +1,10 @@
 import { LLVMGenerator } from "../generator";
 import * as ts from "typescript";
+import * as llvm from "llvm-node";
 import { Declaration } from "./declaration";
 import { FunctionMangler } from "../mangling";
-import { LLVMType } from "../llvm/type";
-import { LLVMValue } from "../llvm/value";
+import { LLVMArrayType, LLVMType } from "../llvm/type";
+import { LLVMConstant, LLVMConstantFP, LLVMGlobalVariable, LLVMValue } from "../llvm/value";
 import { TSType } from "./type";
 
 const stdlib = require("std/constants");
@@ -17,8 +18,12 @@ export class TSString {
   private subscriptFn : LLVMValue | undefined;
   private lengthFn: LLVMValue | undefined;
   private concatFn: LLVMValue | undefined;
-  private cloneFn: LLVMValue | undefined;
+  private concatAllFn: LLVMValue | undefined;
   private negateFn: LLVMValue | undefined;
+  private hashFn: LLVMValue | undefined;
+
+  private readonly literals = new Map<string, LLVMValue>();
+  private literalsInitFn: LLVMValue | undefined;
 
   constructor(generator: LLVMGenerator) {
     this.generator = generator;
@@ -65,6 +70,32 @@ export class TSString {
     return concat;
   }
 
+  private initConcatAllFn() {
+    const declaration = this.getDeclaration();
+    const thisType = declaration.type;
+    const llvmThisType = this.getLLVMType();
+
+    const concatAllDeclaration = declaration.members.find((m) => m.isMethod() && m.name?.getText() === "concatAll")!;
+    const { qualifiedName } = FunctionMangler.mangle(
+      concatAllDeclaration,
+      undefined,
+      thisType,
+      [],
+      this.generator,
+      undefined,
+      ["void**, double"]
+    );
+
+    const llvmArgumentTypes = [
+      LLVMType.getInt8Type(this.generator).getPointer(),
+      LLVMType.getInt8Type(this.generator).getPointer().getPointer(),
+      LLVMType.getDoubleType(this.generator),
+    ];
+    const { fn: concatAll } = this.generator.llvm.function.create(llvmThisType, llvmArgumentTypes, qualifiedName);
+
+    return concatAll;
+  }
+
   private initLengthFn() {
     const declaration = this.getDeclaration();
     const thisType = declaration.type;
@@ -83,12 +114,12 @@ export class TSString {
     return length;
   }
 
-  private initCloneFn() {
+  private initNegateFn() {
     const declaration = this.getDeclaration();
     const thisType = declaration.type;
     const llvmThisType = this.getLLVMType();
 
-    const equalsDeclaration = declaration.members.find((m) => m.isMethod() && m.name?.getText() === "clone")!;
+    const equalsDeclaration = declaration.members.find((m) => m.isMethod() && m.name?.getText() === "negate")!;
 
     const { qualifiedName } = FunctionMangler.mangle(
       equalsDeclaration,
@@ -98,27 +129,21 @@ export class TSString {
       this.generator
     );
 
-    const llvmReturnType = llvmThisType;
+    const llvmReturnType = this.generator.builtinNumber.getLLVMType();
     const llvmArgumentTypes = [llvmThisType];
-    const { fn: clone } = this.generator.llvm.function.create(llvmReturnType, llvmArgumentTypes, qualifiedName);
+    const { fn: result } = this.generator.llvm.function.create(llvmReturnType, llvmArgumentTypes, qualifiedName);
 
-    return clone;
+    return result;
   }
 
-  private initNegateFn() {
+  private initHashFn() {
     const declaration = this.getDeclaration();
     const thisType = declaration.type;
     const llvmThisType = this.getLLVMType();
 
-    const equalsDeclaration = declaration.members.find((m) => m.isMethod() && m.name?.getText() === "negate")!;
+    const hashDeclaration = declaration.members.find((m) => m.isMethod() && m.name?.getText() === "hash")!;
 
-    const { qualifiedName } = FunctionMangler.mangle(
-      equalsDeclaration,
-      undefined,
-      thisType,
-      [thisType],
-      this.generator
-    );
+    const { qualifiedName } = FunctionMangler.mangle(hashDeclaration, undefined, thisType, [thisType], this.generator);
 
     const llvmReturnType = this.generator.builtinNumber.getLLVMType();
     const llvmArgumentTypes = [llvmThisType];
@@ -190,6 +215,52 @@ export class TSString {
     return this.generator.builder.createBitCast(result, this.getLLVMType());
   }
 
+  // 'value' itself if it is a string and result of its 'toString' otherwise
+  coerce(value: LLVMValue) {
+    value = value.derefToPtrLevel1();
+    return value.type.isString() ? value : this.generator.ts.obj.objectToString(value);
+  }
+
+  // Single String of all the 'parts' (String values) with no intermediate strings, see String::concatAll
+  createConcatAll(parts: LLVMValue[]) {
+    if (parts.length === 0) {
+      return this.create("");
+    }
+
+    if (parts.length === 1) {
+      return this.generator.builder.createBitCast(parts[0].derefToPtrLevel1(), this.getLLVMType());
+    }
+
+    if (!this.concatAllFn) {
+      this.concatAllFn = this.initConcatAllFn();
+    }
+
+    const builder = this.generator.builder;
+    const i8PtrType = LLVMType.getInt8Type(this.generator).getPointer();
+
+    // array of the rest of the parts lives on stack just for the call: concatenation may happen in a loop
+    const stackPointer = builder.createStackSave();
+
+    const others = parts.slice(1);
+    const othersArray = builder.createAlloca(LLVMArrayType.get(this.generator, i8PtrType, others.length));
+
+    others.forEach((part, index) => {
+      const slot = builder.createSafeInBoundsGEP(othersArray, [0, index]);
+      builder.createSafeStore(builder.asVoidStar(part.derefToPtrLevel1()), slot);
+    });
+
+    const othersPtr = builder.createBitCast(othersArray, i8PtrType.getPointer());
+    const result = builder.createSafeCall(this.concatAllFn, [
+      builder.asVoidStar(parts[0].derefToPtrLevel1()),
+      othersPtr,
+      LLVMConstantFP.get(this.generator, others.length),
+    ]);
+
+    builder.createStackRestore(stackPointer);
+
+    return builder.createBitCast(result, this.getLLVMType());
+  }
+
   private getLLVMConcat() {
     if (!this.concatFn) {
       this.concatFn = this.initConcatFn();
@@ -206,6 +277,27 @@ export class TSString {
     return this.generator.builder.createSafeCall(this.negateFn, [thisValue.derefToPtrLevel1()]);
   }
 
+  // Returns boxed Number, see String::hash and TSString.hash
+  createHash(thisValue: LLVMValue) {
+    if (!this.hashFn) {
+      this.hashFn = this.initHashFn();
+    }
+
+    return this.generator.builder.createSafeCall(this.hashFn, [thisValue.derefToPtrLevel1()]);
+  }
+
+  // Compile time counterpart of String::hash: 32-bit FNV-1a of UTF-8 bytes
+  static hash(value: string) {
+    const bytes = Buffer.from(value, "utf8");
+    let result = 2166136261;
+
+    for (let i = 0; i < bytes.length; ++i) {
+      result = Math.imul(result ^ bytes[i], 16777619) >>> 0;
+    }
+
+    return result;
+  }
+
   getLLVMLength() {
     if (!this.lengthFn) {
       this.lengthFn = this.initLengthFn();
@@ -214,22 +306,58 @@ export class TSString {
     return this.lengthFn;
   }
 
+  // String literals are immortal String objects created once at module start (see initLiterals),
+  // evaluating a literal is a load of its global. Strings are immutable, so all evaluations share the object
   create(value: string) {
-    const llvmThisType = this.llvmType;
-    const constructor = this.getLLVMConstructor();
-    const ptr = this.generator.builder.createGlobalStringPtr(value);
-    const allocated = this.generator.gc.allocateObject(llvmThisType.getPointerElementType());
-    const thisUntyped = this.generator.builder.asVoidStar(allocated);
-    this.generator.builder.createSafeCall(constructor, [thisUntyped, ptr]); // calling String ctor from char*
-    return allocated;
+    let literal = this.literals.get(value);
+
+    if (!literal) {
+      const nullValue = LLVMConstant.createNullValue(this.llvmType, this.generator);
+      literal = LLVMGlobalVariable.make(this.generator, this.llvmType, false, nullValue, "string_literal");
+      this.literals.set(value, literal);
+    }
+
+    return this.generator.builder.createLoad(literal);
+  }
+
+  // To be called at module start as soon as gc is available: calls the function that creates all the literals.
+  // Its body is emitted by emitLiterals when literals used by the module are known
+  initLiterals() {
+    const { fn } = this.generator.llvm.function.create(
+      LLVMType.getVoidType(this.generator),
+      [],
+      "__ts_string_literals_init"
+    );
+
+    this.literalsInitFn = fn;
+    this.generator.builder.createSafeCall(fn, []);
   }
 
-  clone(value: LLVMValue) {
-    if (!this.cloneFn) {
-      this.cloneFn = this.initCloneFn();
+  emitLiterals() {
+    if (!this.literalsInitFn) {
+      throw new Error("String literals are not initialized. Call TSString.initLiterals first");
     }
 
-    return this.generator.builder.createSafeCall(this.cloneFn, [value]);
+    const entryBlock = llvm.BasicBlock.create(
+      this.generator.context,
+      "entry",
+      this.literalsInitFn.unwrapped as llvm.Function
+    );
+    this.generator.builder.setInsertionPoint(entryBlock);
+    // compiler generated function has no debug info
+    this.generator.emitLocation(undefined);
+
+    const constructor = this.getLLVMConstructor();
+
+    this.literals.forEach((literal, value) => {
+      const ptr = this.generator.builder.createGlobalStringPtr(value);
+      this.generator.gc.initImmortal(literal, this.llvmType, (allocated) => {
+        const thisUntyped = this.generator.builder.asVoidStar(allocated);
+        this.generator.builder.createSafeCall(constructor, [thisUntyped, ptr]); // calling String ctor from char*
+      });
+    });
+
+    this.generator.builder.unwrap().createRetVoid();
   }
 
   createSubscription() {
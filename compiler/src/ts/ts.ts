@@ -10,6 +10,11 @@ import { TSMap } from "./map";
 import { TSObject } from "./object";
 import { TSUnion } from "./union";
 import { TSString } from "./string";
+import { ClassHierarchy } from "./classhierarchy";
+import { FunctionUsage } from "./functionusage";
+import { VariableCapture } from "./variablecapture";
+import { ConstantFolding } from "./constantfolding";
+import { InductionVariables } from "./inductionvariables";
 
 export class TS {
   readonly checker: TypeChecker;
@@ -24,6 +29,11 @@ export class TS {
   private _obj: TSObject | undefined;
   private _union: TSUnion | undefined;
   private _str: TSString | undefined;
+  private _classHierarchy: ClassHierarchy | undefined;
+  private _functionUsage: FunctionUsage | undefined;
+  private _variableCapture: VariableCapture | undefined;
+  private _constants: ConstantFolding | undefined;
+  private _inductionVariables: InductionVariables | undefined;
 
   constructor(generator: LLVMGenerator) {
     this.checker = new TypeChecker(generator.program.getTypeChecker(), generator);
@@ -108,4 +118,44 @@ export class TS {
 
     return this._str!;
   }
+
+  get classHierarchy() {
+    if (!this._classHierarchy) {
+      this._classHierarchy = new ClassHierarchy(this.checker.generator);
+    }
+
+    return this._classHierarchy!;
+  }
+
+  get functionUsage() {
+    if (!this._functionUsage) {
+      this._functionUsage = new FunctionUsage(this.checker.generator);
+    }
+
+    return this._functionUsage!;
+  }
+
+  get variableCapture() {
+    if (!this._variableCapture) {
+      this._variableCapture = new VariableCapture();
+    }
+
+    return this._variableCapture!;
+  }
+
+  get constants() {
+    if (!this._constants) {
+      this._constants = new ConstantFolding(this.checker.generator);
+    }
+
+    return this._constants!;
+  }
+
+  get inductionVariables() {
+    if (!this._inductionVariables) {
+      this._inductionVariables = new InductionVariables(this.checker.generator);
+    }
+
+    return this._inductionVariables!;
+  }
 }
@@ -11,6 +11,7 @@ export class TSUnion {
   private readonly generator: LLVMGenerator;
   private readonly llvmType: LLVMType;
   private readonly declaration: Declaration;
+  private undefinedConstant: LLVMValue | undefined;
 
   constructor(generator: LLVMGenerator) {
     this.generator = generator;
@@ -66,43 +67,15 @@ export class TSUnion {
     return ctor;
   }
 
-  private getGetFn() {
-    const getDeclaration = this.declaration.members.find((m) => m.name?.getText() === "getValue");
+  private getStaticFn(name: string) {
+    const declaration = this.declaration.members.find((m) => m.name?.getText() === name);
 
-    if (!getDeclaration) {
-      throw new Error(`Unable to find 'get' at '${this.declaration.getText()}'`);
+    if (!declaration) {
+      throw new Error(`Unable to find '${name}' at '${this.declaration.getText()}'`);
     }
 
     const { qualifiedName, isExternalSymbol } = FunctionMangler.mangle(
-      getDeclaration,
-      undefined,
-      this.declaration.type,
-      [],
-      this.generator,
-      undefined
-    );
-
-    if (!isExternalSymbol) {
-      throw new Error(`Unable to find cxx 'get' for 'Union'`);
-    }
-
-    const llvmReturnType = this.generator.ts.obj.getLLVMType();
-    const llvmArgumentTypes = [LLVMType.getInt8Type(this.generator).getPointer()];
-
-    const { fn: get } = this.generator.llvm.function.create(llvmReturnType, llvmArgumentTypes, qualifiedName);
-
-    return get;
-  }
-
-  private getSetFn() {
-    const setDeclaration = this.declaration.members.find((m) => m.name?.getText() === "setValue");
-
-    if (!setDeclaration) {
-      throw new Error(`Unable to find 'get' at '${this.declaration.getText()}'`);
-    }
-
-    const { qualifiedName, isExternalSymbol } = FunctionMangler.mangle(
-      setDeclaration,
+      declaration,
       undefined,
       this.declaration.type,
       [],
@@ -112,83 +85,57 @@ export class TSUnion {
     );
 
     if (!isExternalSymbol) {
-      throw new Error(`Unable to find cxx 'set' for 'Union'`);
+      throw new Error(`Unable to find cxx '${name}' for 'Union'`);
     }
 
-    const llvmReturnType = LLVMType.getVoidType(this.generator);
-    const llvmArgumentTypes = [
-      LLVMType.getInt8Type(this.generator).getPointer(),
-      LLVMType.getInt8Type(this.generator).getPointer(),
-    ];
+    const llvmReturnType = name === "wrap" ? this.llvmType : this.generator.ts.obj.getLLVMType();
+    const llvmArgumentTypes = [LLVMType.getInt8Type(this.generator).getPointer()];
 
-    const { fn: set } = this.generator.llvm.function.create(llvmReturnType, llvmArgumentTypes, qualifiedName);
+    const { fn } = this.generator.llvm.function.create(llvmReturnType, llvmArgumentTypes, qualifiedName);
 
-    return set;
+    return fn;
   }
 
-  private getToBoolFn() {
-    const toBoolDeclaration = this.declaration.members.find((m) => m.name?.getText() === "toBool");
+  // Wrapped undefined is immutable as any union, so missing optional arguments of std calls share a single one
+  // created on startup
+  initConstants() {
+    const name = "undefined_union_constant";
+    this.undefinedConstant = this.generator.gc.createImmortal(this.llvmType, name, (allocated) => {
+      const thisUntyped = this.generator.builder.asVoidStar(allocated);
+      const undefinedUntyped = this.generator.builder.asVoidStar(this.generator.ts.undef.get());
 
-    if (!toBoolDeclaration) {
-      throw new Error(`Unable to find constructor at '${this.declaration.getText()}'`);
-    }
-
-    const { qualifiedName, isExternalSymbol } = FunctionMangler.mangle(
-      toBoolDeclaration,
-      undefined,
-      this.declaration.type,
-      [],
-      this.generator
-    );
-
-    if (!isExternalSymbol) {
-      throw new Error(`Unable to find 'toBool' for 'Union'`);
-    }
-
-    const llvmReturnType = this.generator.builtinBoolean.getLLVMType();
-    const llvmArgumentTypes = [LLVMType.getInt8Type(this.generator).getPointer()];
-
-    const { fn: toBool } = this.generator.llvm.function.create(llvmReturnType, llvmArgumentTypes, qualifiedName);
-
-    return toBool;
+      this.generator.builder.createSafeCall(this.getCtorFn(), [thisUntyped, undefinedUntyped]);
+    });
   }
 
+  // Value of a union type is its member itself: no allocation, a typed pointer only.
+  // Readers unwrap it (see 'get'), so it may as well point to a Union that std returned or got
   create(initializer?: LLVMValue) {
-    const ctor = this.getCtorFn();
-
-    const allocated = this.generator.gc.allocateObject(this.llvmType.getPointerElementType());
-    const thisUntyped = this.generator.builder.asVoidStar(allocated);
-    const args = [thisUntyped];
-
     initializer = initializer || this.generator.ts.undef.get();
-    const initializerUntyped = this.generator.builder.asVoidStar(initializer);
-    args.push(initializerUntyped);
-
-    this.generator.builder.createSafeCall(ctor, args);
-
-    return allocated;
+    return this.generator.builder.createBitCast(initializer.derefToPtrLevel1(), this.llvmType);
   }
 
-  get(union: LLVMValue) {
-    const get = this.getGetFn();
-    const thisUntyped = this.generator.builder.asVoidStar(union.derefToPtrLevel1());
+  // Union wrapper for std parameters declared as Union*, e.g. optional ones
+  wrap(value?: LLVMValue) {
+    if (!value) {
+      if (!this.undefinedConstant) {
+        throw new Error("Union constants are not initialized. Call TSUnion.initConstants first");
+      }
 
-    return this.generator.builder.createSafeCall(get, [thisUntyped]);
-  }
+      return this.generator.builder.createLoad(this.undefinedConstant);
+    }
 
-  set(union: LLVMValue, value: LLVMValue) {
-    const set = this.getSetFn();
-    const thisUntyped = this.generator.builder.asVoidStar(union.derefToPtrLevel1());
+    const wrap = this.getStaticFn("wrap");
     const valueUntyped = this.generator.builder.asVoidStar(value.derefToPtrLevel1());
 
-    return this.generator.builder.createSafeCall(set, [thisUntyped, valueUntyped]);
+    return this.generator.builder.createSafeCall(wrap, [valueUntyped]);
   }
 
-  toBool(union: LLVMValue) {
-    const toBool = this.getToBoolFn();
-    const thisUntyped = this.generator.builder.asVoidStar(union);
+  get(union: LLVMValue) {
+    const unwrap = this.getStaticFn("unwrap");
+    const valueUntyped = this.generator.builder.asVoidStar(union.derefToPtrLevel1());
 
-    return this.generator.builder.createSafeCall(toBool, [thisUntyped]);
+    return this.generator.builder.createSafeCall(unwrap, [valueUntyped]);
   }
 
   getLLVMType() {
@@ -0,0 +1,86 @@
+import * as ts from "typescript";
+
+// Capture analysis of function bodies.
+// Variable cell lives on the heap because a closure may keep it longer than the function that declared it runs.
+// Variables no nested function or class refers to never escape, so their cells can live in function's stack frame.
+export class VariableCapture {
+  private readonly cache = new Map<ts.Node, ts.VariableDeclaration[]>();
+  private readonly catchCache = new Map<ts.Node, boolean>();
+
+  // 'let' and 'const' declarations of 'body' (outside of nested functions and classes) that are not captured.
+  // Environments are built by names, so any use of the same name by nested function or class counts as a capture.
+  // 'body' may also be a statement, e.g. a loop for its own counters
+  getStackVariables(body: ts.ConciseBody | ts.Statement): ts.VariableDeclaration[] {
+    let result = this.cache.get(body);
+
+    if (!result) {
+      result = this.collectStackVariables(body);
+      this.cache.set(body, result);
+    }
+
+    return result;
+  }
+
+  // True if 'body' (outside of nested functions and classes) has try..catch
+  hasCatchClause(body: ts.ConciseBody): boolean {
+    let result = this.catchCache.get(body);
+
+    if (result === undefined) {
+      const visit = (node: ts.Node): boolean => {
+        if (ts.isFunctionLike(node) || ts.isClassLike(node)) {
+          return false;
+        }
+
+        return ts.isCatchClause(node) || Boolean(ts.forEachChild(node, visit));
+      };
+
+      result = visit(body);
+      this.catchCache.set(body, result);
+    }
+
+    return result;
+  }
+
+  private collectStackVariables(body: ts.ConciseBody | ts.Statement) {
+    const declarations: ts.VariableDeclaration[] = [];
+    const capturedNames = new Set<string>();
+
+    const collectNames = (node: ts.Node) => {
+      if (ts.isIdentifier(node)) {
+        capturedNames.add(node.text);
+      }
+
+      ts.forEachChild(node, collectNames);
+    };
+
+    const visit = (node: ts.Node) => {
+      if (ts.isFunctionLike(node) || ts.isClassLike(node)) {
+        collectNames(node);
+        return;
+      }
+
+      if (ts.isVariableDeclaration(node) && this.isCandidate(node)) {
+        declarations.push(node);
+      }
+
+      ts.forEachChild(node, visit);
+    };
+
+    visit(body);
+
+    return declarations.filter((declaration) => !capturedNames.has((declaration.name as ts.Identifier).text));
+  }
+
+  private isCandidate(declaration: ts.VariableDeclaration) {
+    const list = declaration.parent;
+
+    // 'var' is function scoped, for..of/for..in variables are handled by LoopHandler
+    return (
+      ts.isIdentifier(declaration.name) &&
+      ts.isVariableDeclarationList(list) &&
+      Boolean(list.flags & ts.NodeFlags.BlockScoped) &&
+      !ts.isForOfStatement(list.parent) &&
+      !ts.isForInStatement(list.parent)
+    );
+  }
+}
@@ -3,7 +3,7 @@ import * as ts from "typescript";
 import { ThisData, Scope, Environment } from "../scope";
 import { FunctionMangler } from "../mangling";
 import { LLVMStructType, LLVMType } from "../llvm/type";
-import { LLVMConstant, LLVMConstantFP, LLVMGlobalVariable, LLVMValue } from "../llvm/value";
+import { LLVMConstant, LLVMConstantFP, LLVMConstantInt, LLVMGlobalVariable, LLVMValue } from "../llvm/value";
 import { Declaration } from "../ts/declaration";
 import { TSType } from "../ts/type";
 import { TSLazyClosure } from "../ts/lazy_closure";
@@ -55,6 +55,7 @@ export class BuiltinTSClosure extends Builtin {
   private readonly callFn: LLVMValue;
   private readonly getEnvFn: LLVMValue;
   private readonly ctorFn: LLVMValue;
+  private readonly inlineEnvironmentCtorFn: LLVMValue;
 
   readonly lazyClosure: TSLazyClosure;
 
@@ -71,6 +72,7 @@ export class BuiltinTSClosure extends Builtin {
     this.callFn = this.initCallFn();
     this.getEnvFn = this.initGetEnvironmentFn();
     this.ctorFn = this.initCtorFn();
+    this.inlineEnvironmentCtorFn = this.initInlineEnvironmentCtorFn();
   }
 
   private initClassDeclaration() {
@@ -157,7 +159,7 @@ export class BuiltinTSClosure extends Builtin {
   private initCtorFn() {
     const thisType = this.declaration.type;
 
-    const constructorDeclaration = this.declaration.members.find((m) => m.isConstructor());
+    const constructorDeclaration = this.declaration.members.find((m) => m.isConstructor() && m.parameters.length === 4);
     if (!constructorDeclaration) {
       throw new Error(`Unable to find constructor declaration at '${this.declaration.getText()}'`);
     }
@@ -169,7 +171,7 @@ export class BuiltinTSClosure extends Builtin {
       [],
       this.generator,
       undefined,
-      ["void*", "void***", "Number*", "Number*", "Number*"]
+      ["void*", "void***", "Number*", "Number*"]
     );
     if (!isExternalSymbol) {
       throw new Error("External symbol TSClosure constructor not found");
@@ -182,6 +184,38 @@ export class BuiltinTSClosure extends Builtin {
       LLVMType.getInt8Type(this.generator).getPointer().getPointer().getPointer(),
       this.generator.builtinNumber.getLLVMType(),
       this.generator.builtinNumber.getLLVMType(),
+    ];
+    const { fn: constructor } = this.generator.llvm.function.create(llvmReturnType, llvmArgumentTypes, qualifiedName);
+
+    return constructor;
+  }
+
+  private initInlineEnvironmentCtorFn() {
+    const thisType = this.declaration.type;
+
+    const constructorDeclaration = this.declaration.members.find((m) => m.isConstructor() && m.parameters.length === 3);
+    if (!constructorDeclaration) {
+      throw new Error(`Unable to find inline environment constructor declaration at '${this.declaration.getText()}'`);
+    }
+
+    const { qualifiedName, isExternalSymbol } = FunctionMangler.mangle(
+      constructorDeclaration,
+      undefined,
+      thisType,
+      [],
+      this.generator,
+      undefined,
+      ["void*", "Number*", "Number*"]
+    );
+    if (!isExternalSymbol) {
+      throw new Error("External symbol TSClosure inline environment constructor not found");
+    }
+
+    const llvmReturnType = LLVMType.getVoidType(this.generator);
+    const llvmArgumentTypes = [
+      this.getLLVMType(),
+      LLVMType.getInt8Type(this.generator).getPointer(),
+      this.generator.builtinNumber.getLLVMType(),
       this.generator.builtinNumber.getLLVMType(),
     ];
     const { fn: constructor } = this.generator.llvm.function.create(llvmReturnType, llvmArgumentTypes, qualifiedName);
@@ -209,6 +243,17 @@ export class BuiltinTSClosure extends Builtin {
     return this.ctorFn;
   }
 
+  // Allocates a closure object followed by its environment; the closure is constructed later by createClosure
+  allocateWithInlineEnvironment(environmentType: LLVMType) {
+    const storageType = LLVMStructType.get(this.generator, [this.getLLVMType().unwrapPointer(), environmentType]);
+    const storage = this.generator.gc.allocateObject(storageType);
+
+    const closure = this.generator.builder.createSafeInBoundsGEP(storage, [0, 0]);
+    const environment = this.generator.builder.createSafeInBoundsGEP(storage, [0, 1]);
+
+    return { closure, environment };
+  }
+
   createClosure(fn: LLVMValue, env: Environment, functionDeclaration: Declaration) {
     if (fn.type.getPointerLevel() !== 1 || !fn.type.unwrapPointer().isFunction()) {
       throw new Error("Malformed function");
@@ -219,9 +264,9 @@ export class BuiltinTSClosure extends Builtin {
 
     const envLength = env.variables.length;
 
-    const thisValue = this.generator.gc.allocateObject(this.getLLVMType().unwrapPointer());
+    const inlineEnvironmentClosure = env.closureStorage;
+    const thisValue = inlineEnvironmentClosure || this.generator.gc.allocateObject(this.getLLVMType().unwrapPointer());
     const untypedFn = this.generator.builder.asVoidStar(fn);
-    const untypedEnv = this.generator.builder.asVoidStarStarStar(env.untyped);
 
     const numArgs = functionDeclaration.parameters.length;
 
@@ -229,23 +274,23 @@ export class BuiltinTSClosure extends Builtin {
       throw new Error(`Parameters limited up to 63. Error at closure creation for '${functionDeclaration.getText()}'`);
     }
 
-    const optionals = functionDeclaration.parameters.reduce((acc, parameter, index) => {
-      if (parameter.questionToken) {
-        acc |= 1 << index;
-      }
+    const closureData = [
+      this.generator.builtinNumber.create(LLVMConstantFP.get(this.generator, envLength)),
+      this.generator.builtinNumber.create(LLVMConstantFP.get(this.generator, numArgs)),
+    ];
 
-      return acc;
-    }, 0);
+    if (inlineEnvironmentClosure) {
+      // Storage is consumed by this closure
+      env.closureStorage = undefined;
+
+      this.generator.builder.createSafeCall(this.inlineEnvironmentCtorFn, [thisValue, untypedFn, ...closureData]);
+      return thisValue;
+    }
+
+    const untypedEnv = this.generator.builder.asVoidStarStarStar(env.untyped);
 
     const constructor = this.getLLVMConstructor();
-    this.generator.builder.createSafeCall(constructor, [
-      thisValue,
-      untypedFn,
-      untypedEnv,
-      this.generator.builtinNumber.create(LLVMConstantFP.get(this.generator, envLength)),
-      this.generator.builtinNumber.create(LLVMConstantFP.get(this.generator, numArgs)),
-      this.generator.builtinNumber.create(LLVMConstantFP.get(this.generator, optionals)),
-    ]);
+    this.generator.builder.createSafeCall(constructor, [thisValue, untypedFn, untypedEnv, ...closureData]);
     return thisValue;
   }
 
@@ -271,7 +316,6 @@ export class BuiltinNumber extends Builtin {
   private readonly nanFn: LLVMValue;
   private readonly infinityFn: LLVMValue;
 
-  private readonly boolFunctions = new Map<string, LLVMValue>();
   private readonly mathFunctions = new Map<string, LLVMValue>();
 
   constructor(generator: LLVMGenerator) {
@@ -469,52 +513,6 @@ export class BuiltinNumber extends Builtin {
     return fn;
   }
 
-  createBooleanFn(name: string, flags: OperationFlags = OperationFlags.Binary) {
-    const id = name + flags;
-
-    if (this.boolFunctions.has(id)) {
-      return this.boolFunctions.get(id)!;
-    }
-
-    const declaration = this.classDeclaration;
-
-    const fnDeclaration = declaration.members.find((m) => m.name?.getText() === name);
-    if (!fnDeclaration) {
-      throw new Error(`Unable to find method '${name}' at '${declaration.getText()}'`);
-    }
-
-    const thisType = this.getTSType();
-
-    const argTypes: TSType[] = [];
-    if (flags === OperationFlags.Binary) {
-      argTypes.push(thisType);
-    }
-
-    const { qualifiedName, isExternalSymbol } = FunctionMangler.mangle(
-      fnDeclaration,
-      undefined,
-      thisType,
-      argTypes,
-      this.generator
-    );
-
-    if (!isExternalSymbol) {
-      throw new Error(`Number method '${name}' for '${thisType.toString()}' not found`);
-    }
-
-    const llvmReturnType = this.generator.builtinBoolean.getLLVMType();
-    const llvmArgumentTypes = [LLVMType.getInt8Type(this.generator).getPointer()];
-    if (flags === OperationFlags.Binary) {
-      llvmArgumentTypes.push(this.llvmType);
-    }
-
-    const { fn } = this.generator.llvm.function.create(llvmReturnType, llvmArgumentTypes, qualifiedName);
-
-    this.boolFunctions.set(id, fn);
-
-    return fn;
-  }
-
   private getNumberGetterFn(functionName: string) {
     const declaration = this.classDeclaration;
 
@@ -608,6 +606,8 @@ export class BuiltinBoolean extends Builtin {
   private readonly cloneFn: LLVMValue;
   private readonly toStringFn: LLVMValue;
 
+  private readonly constants = new Map<boolean, LLVMValue>();
+
   constructor(generator: LLVMGenerator) {
     super("boolean", generator);
 
@@ -815,6 +815,28 @@ export class BuiltinBoolean extends Builtin {
     return allocated;
   }
 
+  // Booleans are immutable, so all the constant ones are two objects created on startup
+  initConstants() {
+    for (const value of [true, false]) {
+      const llvmValue = value ? LLVMConstantInt.getTrue(this.generator) : LLVMConstantInt.getFalse(this.generator);
+      const name = value ? "true_constant" : "false_constant";
+      const global = this.generator.gc.createImmortal(this.llvmType, name, (allocated) => {
+        this.callCtor(allocated, llvmValue);
+      });
+
+      this.constants.set(value, global);
+    }
+  }
+
+  getConstant(value: boolean) {
+    const global = this.constants.get(value);
+    if (!global) {
+      throw new Error("Boolean constants are not initialized. Call BuiltinBoolean.initConstants first");
+    }
+
+    return this.generator.builder.createLoad(global);
+  }
+
   private callCtor(memory: LLVMValue, value: LLVMValue) {
     const thisUntyped = this.generator.builder.asVoidStar(memory);
     this.generator.builder.createSafeCall(this.constructorFn, [thisUntyped, value]);
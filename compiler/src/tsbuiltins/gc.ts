@@ -1,7 +1,7 @@
 import { LLVMGenerator } from "../generator";
 import { FunctionMangler } from "../mangling";
 import { Declaration } from "../ts/declaration";
-import { LLVMConstant, LLVMConstantFP, LLVMValue } from "../llvm/value";
+import { LLVMConstant, LLVMConstantFP, LLVMGlobalVariable, LLVMValue } from "../llvm/value";
 import { LLVMType } from "../llvm/type";
 
 import { Runtime } from "../tsbuiltins/runtime"
@@ -14,11 +14,14 @@ const stdlib = require("std/constants");
 export class GC {
     private readonly allocateFn: LLVMValue;
     private readonly allocateObjectFn: LLVMValue;
+    private readonly allocateTracedFn: LLVMValue;
     private readonly generator: LLVMGenerator;
     private readonly runtime: Runtime;
     private readonly gcType: LLVMType;
     private readonly addRootFn: LLVMValue;
     private readonly removeRootFn: LLVMValue;
+    private readonly pushFrameFn: LLVMValue;
+    private readonly popFrameFn: LLVMValue;
 
     constructor(generator: LLVMGenerator, runtime: Runtime) {
         this.generator = generator;
@@ -28,10 +31,14 @@ export class GC {
 
         this.allocateFn = this.findAllocateFunction(declaration, "allocate");
         this.allocateObjectFn = this.findAllocateFunction(declaration, "allocateObject");
+        this.allocateTracedFn = this.findAllocateFunction(declaration, "allocateTraced");
 
         this.addRootFn = this.findAddRootFunction(declaration, "addRoot");
         this.removeRootFn = this.findRemoveRootFunction(declaration, "removeRoot");
 
+        this.pushFrameFn = this.findPushFrameFunction(declaration, "pushFrame");
+        this.popFrameFn = this.findRemoveRootFunction(declaration, "popFrame");
+
         this.gcType = this.generator.ts.checker.getTypeAtLocation(declaration.unwrapped).getLLVMType();
     }
 
@@ -47,6 +54,27 @@ export class GC {
         return this.doAllocate(this.allocateObjectFn, type, name);
     }
 
+    // Variable cells and environments. GC reclaims them once they are unreachable from roots and closures
+    allocateTraced(type: LLVMType, name?: string) : LLVMValue {
+        return this.doAllocate(this.allocateTracedFn, type, name);
+    }
+
+    // Immortal objects: created once on startup and reached through a global. gc does not track memory from
+    // 'allocate', so they are never collected. 'init' constructs the object in place
+    createImmortal(type: LLVMType, name: string, init: (allocated: LLVMValue) => void): LLVMValue {
+        const nullValue = LLVMConstant.createNullValue(type, this.generator);
+        const global = LLVMGlobalVariable.make(this.generator, type, false, nullValue, name);
+        this.initImmortal(global, type, init);
+        return global;
+    }
+
+    // Same as 'createImmortal' for a global that is already declared, e.g. referenced before its value is known
+    initImmortal(global: LLVMValue, type: LLVMType, init: (allocated: LLVMValue) => void) {
+        const allocated = this.allocate(type.getPointerElementType());
+        init(allocated);
+        this.generator.builder.createSafeStore(allocated, global);
+    }
+
     addRoot(value: LLVMValue, associatedName?: string, scopeName?: string): LLVMValue {
         if (value.type.getPointerLevel() !== 2) {
             return value; // This is not a root, just do nothing
@@ -88,6 +116,28 @@ export class GC {
         return this.generator.builder.createSafeCall(this.removeRootFn, [gcAddress, i8PtrPtr]);
     }
 
+    // 'frame' is an array of 'slotsCount' object pointers on stack, see StackFrame
+    pushFrame(frame: LLVMValue, slotsCount: number): LLVMValue {
+        const i8PtrPtrType = LLVMType.getInt8Type(this.generator).getPointer().getPointer();
+        const i8PtrPtrFrame = this.generator.builder.createBitCast(frame, i8PtrPtrType);
+        const gcAddress = this.runtime.getGCAddress();
+
+        return this.generator.builder.createSafeCall(this.pushFrameFn,
+            [
+                gcAddress,
+                i8PtrPtrFrame,
+                LLVMConstantFP.get(this.generator, slotsCount),
+            ]);
+    }
+
+    popFrame(frame: LLVMValue): LLVMValue {
+        const i8PtrPtrType = LLVMType.getInt8Type(this.generator).getPointer().getPointer();
+        const i8PtrPtrFrame = this.generator.builder.createBitCast(frame, i8PtrPtrType);
+        const gcAddress = this.runtime.getGCAddress();
+
+        return this.generator.builder.createSafeCall(this.popFrameFn, [gcAddress, i8PtrPtrFrame]);
+    }
+
     private doAllocate(callable: LLVMValue, type: LLVMType, name?: string) : LLVMValue {
         const gcAddress = this.runtime.getGCAddress();
         const size = this.getAllocationSize(type);
@@ -158,6 +208,30 @@ export class GC {
         return this.generator.llvm.function.create(llvmReturnType, llvmArgumentTypes, qualifiedName).fn;
     }
 
+    private findPushFrameFunction(declaration: Declaration, name: string) {
+        const frameOpDeclaration = declaration.members.find((m) => m.isMethod() && m.name?.getText() === name);
+        if (!frameOpDeclaration) {
+            throw Error(`Unable to find ${name} function`);
+        }
+
+        const thisType = this.generator.ts.checker.getTypeAtLocation(declaration.unwrapped);
+        const { qualifiedName } = FunctionMangler.mangle(
+            frameOpDeclaration,
+            undefined,
+            thisType,
+            [],
+            this.generator,
+            undefined,
+            ["void**, double"]
+        );
+
+        const llvmReturnType = LLVMType.getVoidType(this.generator);
+        const llvmArgumentTypes = [thisType.getLLVMType(), LLVMType.getInt8Type(this.generator).getPointer().getPointer(),
+            LLVMType.getDoubleType(this.generator)];
+
+        return this.generator.llvm.function.create(llvmReturnType, llvmArgumentTypes, qualifiedName).fn;
+    }
+
     private findAllocateFunction(declaration: Declaration, name: string) {
         const allocateDeclaration = declaration.members.find((m) => m.isMethod() && m.name?.getText() === name);
         if (!allocateDeclaration) {
@@ -59,6 +59,9 @@ export class Runtime {
     const gcAddress = this.callGetGC();
     this.generator.builder.createSafeStore(gcAddress, this.globalGCAddress);
 
+    // names of roots are string literals too, so literals are created before the first root is added
+    this.generator.ts.str.initLiterals();
+
     this.generator.symbolTable.globalScope.set("GlobalGC", this.globalGCAddress);
   }
 
@@ -22,6 +22,7 @@ class TSNativeStdConan(ConanFile):
         "fail_test_on_mem_leak": [True, False],
         "memory_limit_kb": "ANY",
         "validate_gc": [True, False],
+        "build_bitcode": [True, False],
     }
 
     default_options = {
@@ -31,6 +32,7 @@ class TSNativeStdConan(ConanFile):
         "fail_test_on_mem_leak": False,
         "memory_limit_kb": "100000",
         "validate_gc": False,
+        "build_bitcode": False,
     }
 
     def requirements(self):
@@ -62,6 +64,7 @@ class TSNativeStdConan(ConanFile):
         tc.variables["FAIL_TESTS_ON_MEM_LEAK"] = self.options.fail_test_on_mem_leak
         tc.variables["MEMORY_LIMIT_KB"] = self.options.memory_limit_kb
         tc.variables["VALIDATE_GC"] = self.options.validate_gc
+        tc.variables["BUILD_BITCODE"] = self.options.build_bitcode
         # tc.variables["CMAKE_VERBOSE_MAKEFILE"]="ON"
 
         print("TOOLCHAIN VARIABLES:\n\t" +
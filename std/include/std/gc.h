@@ -19,18 +19,27 @@ public:
     // TODO Should be removed. Allocator should allocate, not GC
     TS_METHOD TS_NO_CHECK TS_SIGNATURE("allocate(numBytes: any): void") void* allocate(double numBytes);
     TS_METHOD TS_NO_CHECK TS_SIGNATURE("allocateObject(numBytes: any): void") void* allocateObject(double numBytes);
+    // Variable cells and environments: reclaimed once unreachable from roots and closures
+    TS_METHOD TS_NO_CHECK TS_SIGNATURE("allocateTraced(numBytes: any): void") void* allocateTraced(double numBytes);
     TS_METHOD void collect();
 
     TS_METHOD TS_SIGNATURE("addRoot(root: any, associatedName: Object): void") void addRoot(void** root,
                                                                                             void* associatedName);
     TS_METHOD TS_SIGNATURE("removeRoot(void): void") void removeRoot(void** root);
 
+    // Frame record of compiled function: slots of its variables no closure captures
+    TS_METHOD TS_NO_CHECK TS_SIGNATURE("pushFrame(frame: any, slotsCount: any): void") void pushFrame(void** frame,
+                                                                                                      double slotsCount);
+    TS_METHOD TS_SIGNATURE("popFrame(frame: any): void") void popFrame(void** frame);
+
     TS_METHOD String* toString() const override;
     TS_METHOD Boolean* toBool() const override;
 
     TS_METHOD void saveMemoryGraph() const;
 
     void addRootWithName(Object** root, const char* name);
+    // To be called by C++ code that catches exceptions of compiled code, see StackFrames
+    void dropFramesBelow(const void* stackAddress);
 
 private:
     IGCImpl* _gcImpl;
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+class IEventLoop;
+
+// Buffered console output shared by all console functions.
+// Text is accumulated in a single reusable buffer and written out according to the flush policy:
+//  - Line:     after every line (the default, output appears immediately)
+//  - Size:     once the buffer exceeds sizeThreshold bytes
+//  - Interval: once interval elapsed since the previous flush
+// With Size and Interval policies pending output is also flushed when the current event loop
+// iteration is done, and in any case at exit.
+class ConsoleWriter final
+{
+public:
+    enum class FlushPolicy
+    {
+        Line,
+        Size,
+        Interval
+    };
+
+    struct Options
+    {
+        FlushPolicy policy = FlushPolicy::Line;
+        std::size_t sizeThreshold = 64 * 1024;
+        std::chrono::milliseconds interval{100};
+    };
+
+    static ConsoleWriter& instance();
+
+    // Parses "line", "size[:bytes]" or "interval[:milliseconds]". Falls back to defaults on malformed input
+    static Options parseOptions(const std::string& spec);
+
+    explicit ConsoleWriter(std::ostream& out);
+    ~ConsoleWriter();
+
+    ConsoleWriter(const ConsoleWriter&) = delete;
+    ConsoleWriter& operator=(const ConsoleWriter&) = delete;
+
+    void setOptions(const Options& options);
+    const Options& getOptions() const;
+
+    // Loop used to flush pending output at the end of an iteration. Can be nullptr
+    void attachLoop(IEventLoop* loop);
+
+    // Appenders write to the end of the buffer directly and then call endLine
+    std::string& buffer();
+
+    void endLine();
+
+    void flush();
+
+private:
+    void scheduleFlush();
+
+private:
+    std::ostream& _out;
+    std::string _buffer;
+    Options _options;
+    IEventLoop* _loop = nullptr;
+    bool _flushScheduled = false;
+    std::chrono::steady_clock::time_point _lastFlush;
+};
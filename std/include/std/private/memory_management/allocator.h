@@ -14,6 +14,7 @@ public:
     void* allocate(std::size_t n);
     void* allocateObject(std::size_t n);
     void deallocateObject(Object* ptr) noexcept;
+    void deallocate(void* ptr) noexcept;
 
 private:
     void* doAllocate(std::size_t n);
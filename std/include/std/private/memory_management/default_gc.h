@@ -6,6 +6,8 @@
 #include "std/private/memory_management/gc_names_storage.h"
 #include "std/private/memory_management/gc_object_marker.h"
 #include "std/private/memory_management/gc_types.h"
+#include "std/private/memory_management/raw_memory.h"
+#include "std/private/memory_management/stack_frames.h"
 
 #include <functional>
 #include <unordered_set>
@@ -19,12 +21,18 @@ public:
     struct Callbacks final
     {
         std::function<void(void*)> deleteObject = [](void*) {};
+        std::function<void(void*)> deleteRawMemory = [](void*) {};
     };
 
     DefaultGC(TimerStorage& timers, Callbacks&& gcCallbacks);
     ~DefaultGC();
 
     void addObject(Object* o) override;
+    void addRawMemory(void* block, std::size_t size) override;
+
+    void pushFrame(Object** slots, std::size_t slotsCount) override;
+    void popFrame(Object** slots) override;
+    void dropFramesBelow(const void* stackAddress) override;
 
     std::size_t getAliveObjectsCount() const override;
 
@@ -33,20 +41,26 @@ public:
     void removeRoot(Object** object) override;
 
     void collect() override;
+    void collectIdle() override;
     void print(const std::string& fileName = "") const override;
 
     const UniqueObjects& getHeap() const;
     const Roots& getRoots() const;
     const UniqueConstObjects& getMarked() const;
+    const RawMemory& getRawMemory() const;
+    const StackFrames& getFrames() const;
 
 private:
+    void collect(bool idle);
     void sweep();
     void insertRoot(Object** root);
 
 private:
     UniqueObjects _heap;
     Roots _roots;
+    StackFrames _frames;
     GCNamesStorage _names;
     GCObjectMarker _marker;
+    RawMemory _rawMemory;
     Callbacks _callbacks;
 };
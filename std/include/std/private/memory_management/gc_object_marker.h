@@ -2,11 +2,13 @@
 
 #include "std/private/memory_management/async_object_storage.h"
 #include "std/private/memory_management/gc_types.h"
+#include "std/private/memory_management/stack_frames.h"
 
 class GCObjectMarker
 {
 public:
     GCObjectMarker(const Roots& roots, TimerStorage& timers);
+    GCObjectMarker(const Roots& roots, const StackFrames& frames, TimerStorage& timers);
     ~GCObjectMarker();
 
     void mark();
@@ -20,5 +22,6 @@ public:
 private:
     UniqueConstObjects _marked;
     const Roots& _roots;
+    const StackFrames& _frames;
     TimerStorage& _timers; // TODO remove - TSN-551
 };
\ No newline at end of file
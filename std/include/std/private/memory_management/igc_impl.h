@@ -19,8 +19,18 @@ public:
     virtual void addRootWithName(Object** object, const char* name) = 0;
     virtual void removeRoot(Object** object) = 0;
     virtual void addObject(Object* obj) = 0;
+    virtual void addRawMemory(void* block, std::size_t size) = 0;
 
+    // Frame records of compiled functions, see StackFrames
+    virtual void pushFrame(Object** slots, std::size_t slotsCount) = 0;
+    virtual void popFrame(Object** slots) = 0;
+    // C++ code that catches an exception thrown by compiled code drops frames of the functions it has left
+    virtual void dropFramesBelow(const void* stackAddress) = 0;
+
+    // Compiled code may hold unrooted pointers to raw memory on its stack,
+    // so raw memory is reclaimed only by collections that run between event loop tasks
     virtual void collect() = 0;
+    virtual void collectIdle() = 0;
 
     virtual void print(const std::string& fileName = "") const = 0;
 };
@@ -15,10 +15,21 @@ public:
 
     void onObjectAllocated(const void* el, Size size);
 
+    // Variable cells and environments, see RawMemory
+    void onRawMemoryAllocated(const void* el, Size size);
+    void onRawMemoryDeleted(const void* el);
+
+    // Objects and raw memory
     Size getCurrentAllocatedBytes() const;
+    Size getCurrentRawAllocatedBytes() const;
+
+private:
+    // Returns size of the forgotten allocation
+    Size forget(const void* el);
 
 private:
     Size _deletedObjectsCount = 0u;
     Size _allocatedManagedMemory = 0;
+    Size _allocatedRawMemory = 0;
     std::unordered_map<const void*, std::size_t> _allocatedObjectTable;
 };
@@ -27,6 +27,9 @@ public:
 
     void* allocate(std::size_t n);
 
+    // Raw memory that is traced and reclaimed by gc, see RawMemory
+    void* allocateTraced(std::size_t n);
+
     void onObjectAboutToDelete(void* ptr);
 
     GC* getGC();
@@ -37,6 +40,7 @@ public:
 
 private:
     bool needToFreeMemory() const;
+    void scheduleCollectIfNeeded();
 
     void onAfterMemoryClean();
 
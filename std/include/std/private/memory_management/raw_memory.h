@@ -0,0 +1,38 @@
+#pragma once
+
+#include "std/private/memory_management/gc_types.h"
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+// Raw memory blocks the compiled code allocates for variable cells and environments.
+// They are not objects: a cell holds a pointer to an object, an environment holds pointers to cells.
+// Block is alive if it is a root, if it belongs to environment of a marked closure
+// or if a pointer to it is found in another alive block (environments are scanned word by word).
+class RawMemory final
+{
+public:
+    using DeleteBlock = std::function<void(void*)>;
+
+    void add(void* block, std::size_t size);
+
+    bool contains(const void* block) const;
+    std::size_t getBlocksCount() const;
+
+    void mark(const Roots& roots, const UniqueConstObjects& markedObjects);
+    bool isMarked(const void* block) const;
+    void unmark();
+
+    // Deletes unmarked blocks
+    void sweep(const DeleteBlock& deleteBlock);
+
+private:
+    void markBlock(const void* block);
+    void markEnvironment(const Object* object);
+
+private:
+    std::unordered_map<const void*, std::size_t> _blocks;
+    std::unordered_set<const void*> _marked;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Object;
+
+// Frame records of running compiled functions. Each one is a contiguous array of slots on the function's stack
+// that holds its variables no closure captures. They are gc roots for as long as the function runs.
+// A function left by an exception does not unregister its frame, so frames are also dropped when they are
+// found to be deeper than a frame being pushed or popped (stack grows down), or than a C++ function that
+// caught the exception (see GC::dropFramesBelow).
+class StackFrames final
+{
+public:
+    struct Frame final
+    {
+        Object** slots;
+        std::size_t slotsCount;
+    };
+
+    void push(Object** slots, std::size_t slotsCount);
+    void pop(Object** slots);
+
+    // Drops frames that lie deeper than 'stackAddress', they belong to functions that have returned
+    void dropBelow(const void* stackAddress);
+    void clear();
+
+    const std::vector<Frame>& getFrames() const;
+
+private:
+    void dropFrom(std::uintptr_t address);
+
+private:
+    // ordered from the outermost to the innermost (decreasing addresses)
+    std::vector<Frame> _frames;
+};
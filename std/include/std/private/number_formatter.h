@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Locale-independent Number to string conversion.
+// Produces exactly what ECMAScript Number::toString(10) does:
+// the shortest decimal that round-trips to the same double (Ryu algorithm),
+// laid out in fixed or exponential notation as the specification requires.
+class NumberFormatter final
+{
+public:
+    // Enough for the longest result, e.g. "-0.0000012345678901234567" or "-1.2345678901234567e-308"
+    static constexpr std::size_t MAX_LENGTH = 32;
+
+    // Writes the representation of value into buffer (at least MAX_LENGTH chars).
+    // Returns the number of chars written. The result is not null-terminated.
+    static std::size_t format(double value, char* buffer) noexcept;
+
+    static void appendTo(double value, std::string& out);
+
+    static std::string toString(double value);
+};
@@ -10,11 +10,22 @@ class ToStringConverter
 public:
     static std::string convert(const Object* obj);
 
+    // Streams the representation of obj to the end of out without intermediate strings
+    static void convertTo(const Object* obj, std::string& out);
+
 private:
     using Visited = std::unordered_set<const Object*>;
 
-    static std::string convertWithCheck(const Object* obj, Visited& visited);
+    class Writer;
+
+    static void convertWithCheck(const Object* obj, Visited& visited, Writer& writer);
+
+    static bool convertSpecial(const Object* obj, Visited& visited, Writer& writer);
+
+    static bool writeProps(const Object* obj, Visited& visited, Writer& writer);
+
+    static bool writeParent(const Object* parent, Writer& writer);
 
     template <typename O>
-    static std::string toString(const O*, Visited& visited);
-};
\ No newline at end of file
+    static void toString(const O*, Visited& visited, Writer& writer);
+};
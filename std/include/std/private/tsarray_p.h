@@ -19,6 +19,10 @@ public:
 
     virtual std::size_t push(T v) = 0;
 
+    // Bulk insertions, the storage grows once per call
+    virtual void append(const T* elements, std::size_t count) = 0;
+    virtual void append(const ArrayPrivate<T>& other) = 0;
+
     virtual T pop() = 0;
 
     virtual std::size_t length() const = 0;
@@ -24,6 +24,9 @@ public:
 
     std::size_t push(T v) override;
 
+    void append(const T* elements, std::size_t count) override;
+    void append(const ArrayPrivate<T>& other) override;
+
     template <typename... Ts>
     std::size_t push(T t, Ts... ts);
 
@@ -69,6 +72,28 @@ std::size_t DequeueBackend<T>::push(T t)
     return length();
 }
 
+template <typename T>
+void DequeueBackend<T>::append(const T* elements, std::size_t count)
+{
+    _storage.insert(_storage.end(), elements, elements + count);
+}
+
+template <typename T>
+void DequeueBackend<T>::append(const ArrayPrivate<T>& other)
+{
+    if (&other == this)
+    {
+        // insertion would invalidate the iterators of the range being inserted
+        const std::vector<T> copy{_storage.cbegin(), _storage.cend()};
+        _storage.insert(_storage.end(), copy.cbegin(), copy.cend());
+        return;
+    }
+
+    // DequeueBackend is the only backend
+    const auto& otherStorage = static_cast<const DequeueBackend<T>&>(other)._storage;
+    _storage.insert(_storage.end(), otherStorage.cbegin(), otherStorage.cend());
+}
+
 template <typename T>
 T DequeueBackend<T>::pop()
 {
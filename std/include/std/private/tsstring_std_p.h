@@ -7,6 +7,7 @@ class StdStringBackend : public StringPrivate
 public:
     StdStringBackend() = default;
     StdStringBackend(const std::string& s);
+    StdStringBackend(std::string&& s);
 
     ~StdStringBackend() override = default;
 
@@ -65,6 +65,7 @@ private:
     static void initCmdArgs(int ac, char* av[]);
     static void initLoop(IEventLoop* customEventLoop);
     static void initTimerCreator(ITimerCreator* timerCreator);
+    static void initConsole();
 
     static std::vector<std::string> _cmdArgs;
     static std::unique_ptr<IEventLoop> _loop;
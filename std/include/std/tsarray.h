@@ -12,6 +12,7 @@
 #include "std/tsnumber.h"
 #include "std/tsobject.h"
 #include "std/tsstring.h"
+#include "std/tstuple.h"
 #include "std/tsundefined.h"
 #include "std/tsunion.h"
 
@@ -55,12 +56,18 @@ public:
 
     TS_METHOD TS_SIGNATURE("push(...items: T[]): number") Number* push(Array<T>* other);
 
+    // Appends 'argsCount' elements from 'args' at once, the ones marked in 'spreads' (null if none is) are arrays or
+    // tuples to append the elements of. Compiler lowers rest arguments and array literals to it
+    TS_METHOD TS_NO_CHECK TS_SIGNATURE("pushArguments(args: any, argsCount: any, spreads: any): void") void
+        pushArguments(void** args, double argsCount, const bool* spreads);
+
     void INLINE_ATTR push(T v)
     {
         _d->push(v);
     }
 
-    TS_METHOD TS_RETURN_TYPE("T | undefined") Union* pop();
+    // Returns the element itself or undefined, no Union wrapper: see Union::unwrap
+    TS_METHOD TS_RETURN_TYPE("T | undefined") Object* pop();
 
     TS_METHOD void setElementAtIndex(Number* index, T value);
 
@@ -87,6 +94,24 @@ public:
     TS_METHOD TS_SIGNATURE("map<U>(callbackfn: (value: T, index: number, array: readonly T[]) => U): U[]")
         Array<U>* map(TSClosure* closure);
 
+    TS_METHOD TS_SIGNATURE("filter(predicate: (value: T, index: number, array: readonly T[]) => boolean): T[]")
+        Array<T>* filter(TSClosure* predicate) const;
+
+    TS_METHOD TS_SIGNATURE("some(predicate: (value: T, index: number, array: readonly T[]) => boolean): boolean")
+        Boolean* some(TSClosure* predicate) const;
+
+    TS_METHOD TS_SIGNATURE("every(predicate: (value: T, index: number, array: readonly T[]) => boolean): boolean")
+        Boolean* every(TSClosure* predicate) const;
+
+    TS_METHOD TS_SIGNATURE(
+        "find(predicate: (value: T, index: number, obj: readonly T[]) => boolean): T | undefined") Object*
+        find(TSClosure* predicate) const;
+
+    // @todo: same as `map`, have to be `const`
+    template <typename U>
+    TS_METHOD TS_SIGNATURE("reduce<U>(callbackfn: (previousValue: U, currentValue: T, currentIndex: number, array: "
+                           "readonly T[]) => U, initialValue: U): U") U reduce(TSClosure* closure, U initialValue);
+
     TS_METHOD TS_SIGNATURE("splice(start: number, deleteCount?: number): T[]") Array<T>* splice(
         Number* start, Union* maybeDeleteCount);
 
@@ -104,6 +129,15 @@ public:
 
     std::vector<Object*> getChildObjects() const override;
 
+private:
+    // Passes (value, index, array) to the callback starting from its `firstArg` parameter.
+    // Parameters the callback does not declare are skipped, so the index is boxed only when it is used.
+    void* invokeCallback(TSClosure* closure, std::uint32_t firstArg, T value, std::size_t index) const;
+
+    static bool isTruthy(void* callbackResult);
+
+    void appendSpread(Object* spread);
+
 private:
     ArrayPrivate<T>* _d = nullptr;
 
@@ -162,27 +196,64 @@ Array<T>::~Array()
 template <typename T>
 Number* Array<T>::push(Array<T>* other)
 {
-    auto iterator = other->iterator();
-    auto result = iterator->next();
+    _d->append(*other->_d);
+    return length();
+}
+
+template <typename T>
+void Array<T>::pushArguments(void** args, double argsCount, const bool* spreads)
+{
+    const auto count = static_cast<std::size_t>(argsCount);
+    const auto* elements = reinterpret_cast<const T*>(args);
 
-    while (!result->done()->unboxed())
+    // elements between spreads go in runs
+    std::size_t runStart = 0;
+
+    for (std::size_t i = 0; spreads && i < count; ++i)
     {
-        push(result->value());
-        result = iterator->next();
+        if (spreads[i])
+        {
+            _d->append(elements + runStart, i - runStart);
+            appendSpread(static_cast<Object*>(args[i]));
+            runStart = i + 1;
+        }
     }
 
-    return length();
+    _d->append(elements + runStart, count - runStart);
 }
 
 template <typename T>
-Union* Array<T>::pop()
+void Array<T>::appendSpread(Object* spread)
+{
+    if (spread->isArray())
+    {
+        _d->append(*static_cast<Array<T>*>(spread)->_d);
+    }
+    else if (spread->isTuple())
+    {
+        const auto* tuple = static_cast<Tuple*>(spread);
+        const auto length = tuple->_d->length();
+
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            _d->push(static_cast<T>(static_cast<void*>(tuple->_d->operator[](i))));
+        }
+    }
+    else
+    {
+        throw std::runtime_error("Only arrays and tuples can be spread");
+    }
+}
+
+template <typename T>
+Object* Array<T>::pop()
 {
     if (_d->empty())
     {
-        return new Union(Undefined::instance());
+        return Undefined::instance();
     }
 
-    return new Union(Object::asObjectPtr(_d->pop()));
+    return Object::asObjectPtr(_d->pop());
 }
 
 template <typename T>
@@ -220,30 +291,147 @@ T Array<T>::operator[](size_t index) const
 }
 
 template <typename T>
-void Array<T>::forEach(TSClosure* closure) const
+void* Array<T>::invokeCallback(TSClosure* closure, std::uint32_t firstArg, T value, std::size_t index) const
 {
     const auto numArgs = closure->getNumArgs();
+
+    if (numArgs > firstArg)
+    {
+        closure->setEnvironmentElement(value, firstArg);
+    }
+
+    if (numArgs > firstArg + 1)
+    {
+        closure->setEnvironmentElement(new Number(static_cast<double>(index)), firstArg + 1);
+    }
+
+    if (numArgs > firstArg + 2)
+    {
+        closure->setEnvironmentElement(const_cast<Array<T>*>(this), firstArg + 2);
+    }
+
+    return closure->call();
+}
+
+template <typename T>
+bool Array<T>::isTruthy(void* callbackResult)
+{
+    auto* object = static_cast<Object*>(callbackResult);
+    if (!object)
+    {
+        return false;
+    }
+
+    // Predicates mostly return booleans, do not box another one just to test it
+    if (object->isBoolean())
+    {
+        return static_cast<Boolean*>(object)->unboxed();
+    }
+
+    return object->toBool()->unboxed();
+}
+
+template <typename T>
+void Array<T>::forEach(TSClosure* closure) const
+{
+    const auto length = _d->length();
+
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        invokeCallback(closure, 0, operator[](i), i);
+    }
+}
+
+template <typename T>
+Array<T>* Array<T>::filter(TSClosure* predicate) const
+{
+    auto filteredArray = new Array<T>();
     const auto length = _d->length();
 
     for (std::size_t i = 0; i < length; ++i)
     {
-        if (numArgs > 0)
+        // Keep the element passed to the predicate: it is allowed to modify the array
+        T value = operator[](i);
+
+        if (isTruthy(invokeCallback(predicate, 0, value, i)))
         {
-            closure->setEnvironmentElement(operator[](i), 0);
+            filteredArray->push(value);
         }
+    }
+
+    return filteredArray;
+}
 
-        if (numArgs > 1)
+template <typename T>
+Boolean* Array<T>::some(TSClosure* predicate) const
+{
+    const auto length = _d->length();
+
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        if (isTruthy(invokeCallback(predicate, 0, operator[](i), i)))
         {
-            closure->setEnvironmentElement(new Number(static_cast<double>(i)), 1);
+            return new Boolean(true);
         }
+    }
 
-        if (numArgs > 2)
+    return new Boolean(false);
+}
+
+template <typename T>
+Boolean* Array<T>::every(TSClosure* predicate) const
+{
+    const auto length = _d->length();
+
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        if (!isTruthy(invokeCallback(predicate, 0, operator[](i), i)))
         {
-            closure->setEnvironmentElement(const_cast<Array<T>*>(this), 2);
+            return new Boolean(false);
         }
+    }
 
-        closure->call();
+    return new Boolean(true);
+}
+
+template <typename T>
+Object* Array<T>::find(TSClosure* predicate) const
+{
+    const auto length = _d->length();
+
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        T value = operator[](i);
+
+        if (isTruthy(invokeCallback(predicate, 0, value, i)))
+        {
+            return Object::asObjectPtr(value);
+        }
+    }
+
+    return Undefined::instance();
+}
+
+template <typename T>
+template <typename U>
+U Array<T>::reduce(TSClosure* closure, U initialValue)
+{
+    static_assert(std::is_pointer<U>::value, "TS Array elements expected to be of pointer type");
+
+    U accumulator = initialValue;
+    const auto length = _d->length();
+
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        if (closure->getNumArgs() > 0)
+        {
+            closure->setEnvironmentElement(accumulator, 0);
+        }
+
+        accumulator = reinterpret_cast<U>(invokeCallback(closure, 1, operator[](i), i));
     }
+
+    return accumulator;
 }
 
 template <typename T>
@@ -366,32 +554,14 @@ template <typename T>
 template <typename U>
 Array<U>* Array<T>::map(TSClosure* closure)
 {
-
     static_assert(std::is_pointer<U>::value, "TS Array elements expected to be of pointer type");
 
     auto transformedArray = new Array<U>();
-    const auto numArgs = closure->getNumArgs();
-
     const auto length = _d->length();
 
     for (std::size_t i = 0; i < length; ++i)
     {
-        if (numArgs > 0)
-        {
-            closure->setEnvironmentElement(operator[](i), 0);
-        }
-
-        if (numArgs > 1)
-        {
-            closure->setEnvironmentElement(new Number(static_cast<double>(i)), 1);
-        }
-
-        if (numArgs > 2)
-        {
-            closure->setEnvironmentElement(const_cast<Array<T>*>(this), 2);
-        }
-
-        U transformed = reinterpret_cast<U>(closure->call());
+        U transformed = reinterpret_cast<U>(invokeCallback(closure, 0, operator[](i), i));
         transformedArray->push(transformed);
     }
 
@@ -11,6 +11,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <type_traits>
 
 class Number;
@@ -23,10 +24,15 @@ TS_CODE("// @ts-ignore\n"
 class TS_EXPORT TS_DECLARE TS_IGNORE TSClosure : public Object
 {
 public:
+    using Function = void* (*)(void***);
     using FunctionToCall = std::function<void*(void***)>;
 
 public:
-    TS_METHOD TS_NO_CHECK TSClosure(void* fn, void*** env, Number* envLength, Number* numArgs, Number* optionals);
+    // Environment is allocated separately as gc traced raw memory
+    TS_METHOD TS_NO_CHECK TSClosure(void* fn, void*** env, Number* envLength, Number* numArgs);
+    // Environment of envLength elements is placed right after the closure, in the same allocation
+    TS_METHOD TS_NO_CHECK TSClosure(void* fn, Number* envLength, Number* numArgs);
+    // C++ lambdas, see make_closure_from_lambda.h. Environment is owned by the closure
     TSClosure(FunctionToCall&& fn, void*** env, std::uint32_t envLength, std::uint32_t numArgs);
     ~TSClosure() override;
 
@@ -46,11 +52,15 @@ public:
     std::vector<Object*> getChildObjects() const override;
 
 private:
-    FunctionToCall _fn;
+    void*** inlineEnvironment();
+
+private:
+    Function _fn = nullptr;
+    std::unique_ptr<FunctionToCall> _lambda;
     void*** _env = nullptr;
     std::uint32_t _envLength;
     std::uint32_t _numArgs;
-    std::uint32_t _optionals = 0;
+    bool _ownsEnvironment = true;
 
 private:
     friend class ToStringConverter;
@@ -60,14 +70,7 @@ template <typename T>
 void TSClosure::setEnvironmentElement(T value, int index)
 {
     static_assert(std::is_pointer<T>::value, "Expected value to be of pointer type");
+    // Optional and union parameters are stored as is: compiled code unwraps them on reads, see Union::unwrap
     auto** objectStarAddress = _env[index];
-
-    if ((this->_optionals & (1 << index)) != 0)
-    {
-        Union* optional = static_cast<Union*>(*objectStarAddress);
-        optional->setValue(Object::asObjectPtr(value));
-        return;
-    }
-
     *objectStarAddress = value;
 }
@@ -28,6 +28,7 @@ public:
     TS_METHOD TS_SIGNATURE("constructor(initializer?: any)") String();
     String(Number* d);
     String(const std::string& s);
+    String(std::string&& s);
     String(const char* s);
 
     ~String() override;
@@ -35,6 +36,10 @@ public:
 public:
     TS_METHOD TS_GETTER Number* length() const;
     TS_METHOD String* concat(String* other) const;
+    // Concatenation of this string and 'othersCount' strings from 'others' into one allocation of the total length.
+    // Compiler lowers template literals and chains of '+' on strings to it
+    TS_METHOD TS_NO_CHECK TS_SIGNATURE("concatAll(others: any, othersCount: any): string") String* concatAll(
+        void** others, double othersCount) const;
 
     TS_METHOD TS_SIGNATURE("startsWith(string: string, start?: number): boolean") Boolean* startsWith(
         String* other, Union* maybeStartIndex) const;
@@ -82,6 +87,10 @@ public:
 
     TS_METHOD Number* negate() const;
 
+    // 32-bit FNV-1a of UTF-8 representation. Compiler computes the same hash for string case labels
+    // at compile time and dispatches string switches on it.
+    TS_METHOD Number* hash() const;
+
     Array<String*>* getKeysArray() const override;
 
     bool operator<(const String& other) const noexcept;
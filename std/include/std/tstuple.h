@@ -10,6 +10,9 @@
 template <typename T>
 class ArrayPrivate;
 
+template <typename T>
+class Array;
+
 class String;
 class Number;
 class ToStringConverter;
@@ -37,4 +40,7 @@ private:
 
 private:
     friend class ToStringConverter;
+
+    template <typename T>
+    friend class Array;
 };
@@ -27,6 +27,13 @@ public:
     TS_METHOD Object* getValue() const;
     TS_METHOD void setValue(Object* value);
 
+    // Value of a union type is either a Union or the member itself: compiled code wraps a member only to pass it
+    // to a 'Union*' parameter. Returns the member in both cases
+    TS_METHOD static Object* unwrap(Object* value);
+    // Returns 'value' if it is a Union already, a new Union otherwise.
+    // Compiled code never changes Unions, so they are shared
+    TS_METHOD static Union* wrap(Object* value);
+
     template <typename T>
     T INLINE_ATTR getValue() const
     {
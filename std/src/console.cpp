@@ -1,45 +1,48 @@
 #include "std/console.h"
 #include "std/tsarray.h"
 
-#include <iostream>
+#include "std/private/console_writer.h"
+
+#include <string>
 
 namespace
 {
-void logString(const std::string& str)
-{
-    std::cout << str << " ";
-}
-
-void logArray(Array<Object*>* objects)
+void logArray(Array<Object*>* objects, std::string& out)
 {
-    auto iterator = objects->iterator();
-    auto result = iterator->next();
+    const auto length = static_cast<std::size_t>(objects->length()->unboxed());
 
-    while (!result->done()->unboxed())
+    for (std::size_t i = 0; i < length; ++i)
     {
-        const auto converted = ToStringConverter::convert(Object::asObjectPtr(result->value()));
-        logString(converted);
-        result = iterator->next();
+        ToStringConverter::convertTo(Object::asObjectPtr((*objects)[i]), out);
+        out.push_back(' ');
     }
 }
 } // anonymous namespace
 
 void console::log(Array<Object*>* objects)
 {
-    logArray(objects);
-    std::cout << std::endl;
+    auto& writer = ConsoleWriter::instance();
+
+    logArray(objects, writer.buffer());
+    writer.endLine();
 }
 
 void console::assert(Union* condition, Array<Object*>* objects)
 {
-    static const std::string failureMsg{"Assertion failed:"};
+    static const std::string failureMsg{"Assertion failed: "};
 
     if (!condition->hasValue() || condition->toBool()->unboxed())
     {
         return;
     }
 
-    logString(failureMsg);
-    logArray(objects);
+    auto& writer = ConsoleWriter::instance();
+
+    writer.buffer() += failureMsg;
+    logArray(objects, writer.buffer());
+    writer.endLine();
+
+    // Nothing is going to flush it after terminate
+    writer.flush();
     std::terminate();
-}
\ No newline at end of file
+}
@@ -45,6 +45,16 @@ void* GC::allocateObject(double numBytes)
     return _memManager->allocateMemoryForObject(static_cast<std::size_t>(numBytes));
 }
 
+void* GC::allocateTraced(double numBytes)
+{
+    if (!_memManager)
+    {
+        throw std::runtime_error("Allocator cannot be nullptr");
+    }
+
+    return _memManager->allocateTraced(static_cast<std::size_t>(numBytes));
+}
+
 void GC::collect()
 {
     if (!_gcImpl)
@@ -92,6 +102,36 @@ void GC::removeRoot(void** root)
     _gcImpl->removeRoot(Object::asObjectPtrPtr(root));
 }
 
+void GC::pushFrame(void** frame, double slotsCount)
+{
+    if (!_gcImpl)
+    {
+        throw std::runtime_error("GCImpl cannot be nullptr");
+    }
+
+    _gcImpl->pushFrame(Object::asObjectPtrPtr(frame), static_cast<std::size_t>(slotsCount));
+}
+
+void GC::popFrame(void** frame)
+{
+    if (!_gcImpl)
+    {
+        throw std::runtime_error("GCImpl cannot be nullptr");
+    }
+
+    _gcImpl->popFrame(Object::asObjectPtrPtr(frame));
+}
+
+void GC::dropFramesBelow(const void* stackAddress)
+{
+    if (!_gcImpl)
+    {
+        throw std::runtime_error("GCImpl cannot be nullptr");
+    }
+
+    _gcImpl->dropFramesBelow(stackAddress);
+}
+
 String* GC::toString() const
 {
     return new String("Global GC object");
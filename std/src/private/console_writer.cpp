@@ -0,0 +1,162 @@
+#include "std/private/console_writer.h"
+
+#include "std/ievent_loop.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+constexpr std::size_t g_InitialCapacity = 4 * 1024;
+
+constexpr const char g_LinePolicy[] = "line";
+constexpr const char g_SizePolicy[] = "size";
+constexpr const char g_IntervalPolicy[] = "interval";
+
+bool parseCount(const std::string& str, unsigned long long& result)
+{
+    if (str.empty())
+    {
+        return false;
+    }
+
+    char* end = nullptr;
+    result = std::strtoull(str.c_str(), &end, 10);
+    return end == str.c_str() + str.size() && result > 0;
+}
+} // namespace
+
+ConsoleWriter& ConsoleWriter::instance()
+{
+    static ConsoleWriter writer(std::cout);
+    return writer;
+}
+
+ConsoleWriter::Options ConsoleWriter::parseOptions(const std::string& spec)
+{
+    Options options;
+
+    const auto delimiter = spec.find(':');
+    const auto policy = spec.substr(0, delimiter);
+    const auto argument = delimiter == std::string::npos ? std::string{} : spec.substr(delimiter + 1);
+
+    unsigned long long count = 0;
+
+    if (policy == g_SizePolicy)
+    {
+        options.policy = FlushPolicy::Size;
+        if (parseCount(argument, count))
+        {
+            options.sizeThreshold = static_cast<std::size_t>(count);
+        }
+    }
+    else if (policy == g_IntervalPolicy)
+    {
+        options.policy = FlushPolicy::Interval;
+        if (parseCount(argument, count))
+        {
+            options.interval = std::chrono::milliseconds(count);
+        }
+    }
+    else if (policy != g_LinePolicy)
+    {
+        return Options{};
+    }
+
+    return options;
+}
+
+ConsoleWriter::ConsoleWriter(std::ostream& out)
+    : _out(out)
+    , _lastFlush(std::chrono::steady_clock::now())
+{
+    _buffer.reserve(g_InitialCapacity);
+}
+
+ConsoleWriter::~ConsoleWriter()
+{
+    flush();
+}
+
+void ConsoleWriter::setOptions(const Options& options)
+{
+    flush();
+    _options = options;
+}
+
+const ConsoleWriter::Options& ConsoleWriter::getOptions() const
+{
+    return _options;
+}
+
+void ConsoleWriter::attachLoop(IEventLoop* loop)
+{
+    flush();
+    _loop = loop;
+    _flushScheduled = false;
+}
+
+std::string& ConsoleWriter::buffer()
+{
+    return _buffer;
+}
+
+void ConsoleWriter::endLine()
+{
+    _buffer.push_back('\n');
+
+    switch (_options.policy)
+    {
+        case FlushPolicy::Line:
+            flush();
+            return;
+        case FlushPolicy::Size:
+            if (_buffer.size() >= _options.sizeThreshold)
+            {
+                flush();
+                return;
+            }
+            break;
+        case FlushPolicy::Interval:
+            if (std::chrono::steady_clock::now() - _lastFlush >= _options.interval)
+            {
+                flush();
+                return;
+            }
+            break;
+    }
+
+    scheduleFlush();
+}
+
+void ConsoleWriter::flush()
+{
+    _lastFlush = std::chrono::steady_clock::now();
+
+    if (_buffer.empty())
+    {
+        return;
+    }
+
+    _out.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+    _out.flush();
+
+    // Keeps the capacity, so the buffer is reused by the next lines
+    _buffer.clear();
+}
+
+void ConsoleWriter::scheduleFlush()
+{
+    if (!_loop || _flushScheduled)
+    {
+        return;
+    }
+
+    _flushScheduled = true;
+    _loop->enqueue(
+        [this]
+        {
+            _flushScheduled = false;
+            flush();
+        });
+}
@@ -34,3 +34,9 @@ void Allocator::deallocateObject(Object* ptr) noexcept
     LOG_METHOD_CALL;
     delete ptr;
 }
+
+void Allocator::deallocate(void* ptr) noexcept
+{
+    LOG_METHOD_CALL;
+    ::operator delete(ptr);
+}
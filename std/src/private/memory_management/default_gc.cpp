@@ -8,16 +8,17 @@
 DefaultGC::DefaultGC(TimerStorage& timers, Callbacks&& gcCallbacks)
     : _heap{}
     , _roots{}
+    , _frames{}
     , _names{}
     , _callbacks(std::move(gcCallbacks))
-    , _marker{_roots, timers}
+    , _marker{_roots, _frames, timers}
 {
 }
 
 DefaultGC::~DefaultGC()
 {
     _roots.clear();
-    collect();
+    collectIdle();
 }
 
 void DefaultGC::addObject(Object* o)
@@ -31,6 +32,36 @@ void DefaultGC::addObject(Object* o)
     _heap.insert(o);
 }
 
+void DefaultGC::addRawMemory(void* block, std::size_t size)
+{
+    if (!block)
+    {
+        throw std::runtime_error("GC: cannot add nullptr as raw memory");
+    }
+
+    _rawMemory.add(block, size);
+}
+
+void DefaultGC::pushFrame(Object** slots, std::size_t slotsCount)
+{
+    if (!slots)
+    {
+        throw std::runtime_error("GC: stack frame cannot be nullptr");
+    }
+
+    _frames.push(slots, slotsCount);
+}
+
+void DefaultGC::popFrame(Object** slots)
+{
+    _frames.pop(slots);
+}
+
+void DefaultGC::dropFramesBelow(const void* stackAddress)
+{
+    _frames.dropBelow(stackAddress);
+}
+
 std::size_t DefaultGC::getAliveObjectsCount() const
 {
     return _heap.size();
@@ -69,6 +100,16 @@ const UniqueConstObjects& DefaultGC::getMarked() const
     return _marker.getMarked();
 }
 
+const RawMemory& DefaultGC::getRawMemory() const
+{
+    return _rawMemory;
+}
+
+const StackFrames& DefaultGC::getFrames() const
+{
+    return _frames;
+}
+
 void DefaultGC::insertRoot(Object** o)
 {
     LOG_METHOD_CALL;
@@ -100,16 +141,47 @@ void DefaultGC::removeRoot(Object** o)
 }
 
 void DefaultGC::collect()
+{
+    collect(false);
+}
+
+void DefaultGC::collectIdle()
+{
+    collect(true);
+}
+
+void DefaultGC::collect(bool idle)
 {
     LOG_METHOD_CALL;
     LOG_GC("Alive objects count before collect " + std::to_string(_heap.size()));
 
+    if (idle)
+    {
+        // no compiled function is running between event loop tasks
+        _frames.clear();
+    }
+    else
+    {
+        // frames of functions left by exceptions
+        const char stackTop = 0;
+        _frames.dropBelow(&stackTop);
+    }
+
     LOG_INFO("Calling mark");
     _marker.mark();
 
     LOG_INFO("Calling sweep");
     sweep();
 
+    if (idle)
+    {
+        // environments of closures that survived the sweep are alive
+        LOG_INFO("Calling raw memory mark and sweep");
+        _rawMemory.mark(_roots, _marker.getMarked());
+        _rawMemory.sweep(_callbacks.deleteRawMemory);
+        _rawMemory.unmark();
+    }
+
     LOG_INFO("Calling unmark");
     _marker.unmark();
 
@@ -25,8 +25,19 @@ void markStorage(AsyncObjectStorage<Element>& storage,
     }
 }
 
+namespace
+{
+const StackFrames g_noFrames;
+} // namespace
+
 GCObjectMarker::GCObjectMarker(const Roots& roots, TimerStorage& timers)
+    : GCObjectMarker(roots, g_noFrames, timers)
+{
+}
+
+GCObjectMarker::GCObjectMarker(const Roots& roots, const StackFrames& frames, TimerStorage& timers)
     : _roots(roots)
+    , _frames(frames)
     , _timers(timers)
 {
 }
@@ -49,6 +60,18 @@ void GCObjectMarker::mark()
             utils::visit(rootVal, visited, [this](const Object* obj) { _marked.insert(obj); });
         }
     }
+
+    for (const auto& frame : _frames.getFrames())
+    {
+        LOG_ADDRESS("Marking stack frame: ", frame.slots);
+        for (std::size_t i = 0; i < frame.slotsCount; ++i)
+        {
+            if (const Object* slotVal = frame.slots[i])
+            {
+                utils::visit(slotVal, visited, [this](const Object* obj) { _marked.insert(obj); });
+            }
+        }
+    }
 }
 
 const UniqueConstObjects& GCObjectMarker::getMarked() const
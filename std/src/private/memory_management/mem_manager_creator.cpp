@@ -17,6 +17,11 @@ std::unique_ptr<MemoryManager> createMemoryManager(TimerStorage& storage, IEvent
         storage->onDeleted(o);
         alloc->deallocateObject(Object::asObjectPtr(o));
     };
+    gcCallbacks.deleteRawMemory = [alloc = allocator.get(), storage = memStorage.get()](void* block)
+    {
+        storage->onRawMemoryDeleted(block);
+        alloc->deallocate(block);
+    };
 
     auto gc = std::make_unique<DefaultGC>(storage, std::move(gcCallbacks));
 
@@ -33,7 +33,7 @@ void MemoryCleaner::asyncClear(const std::function<void()> afterClear)
     _eventLoop.enqueue(
         [this, fn = afterClear]()
         {
-            _gc.collect();
+            _gc.collectIdle();
 
             if (_gcValidator)
             {
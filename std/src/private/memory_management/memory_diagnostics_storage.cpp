@@ -8,13 +8,7 @@ MemoryDiagnosticsStorage::Size MemoryDiagnosticsStorage::getDeletedObjectsCount(
 void MemoryDiagnosticsStorage::onDeleted(const void* el)
 {
     ++_deletedObjectsCount;
-
-    auto it = _allocatedObjectTable.find(el);
-    if (it != _allocatedObjectTable.end())
-    {
-        _allocatedManagedMemory -= it->second;
-        _allocatedObjectTable.erase(it);
-    }
+    forget(el);
 }
 
 MemoryDiagnosticsStorage::Size MemoryDiagnosticsStorage::getCurrentAllocatedBytes() const
@@ -22,8 +16,39 @@ MemoryDiagnosticsStorage::Size MemoryDiagnosticsStorage::getCurrentAllocatedByte
     return _allocatedManagedMemory;
 }
 
+MemoryDiagnosticsStorage::Size MemoryDiagnosticsStorage::getCurrentRawAllocatedBytes() const
+{
+    return _allocatedRawMemory;
+}
+
 void MemoryDiagnosticsStorage::onObjectAllocated(const void* el, Size size)
 {
     _allocatedObjectTable[el] = size;
     _allocatedManagedMemory += size;
-}
\ No newline at end of file
+}
+
+void MemoryDiagnosticsStorage::onRawMemoryAllocated(const void* el, Size size)
+{
+    onObjectAllocated(el, size);
+    _allocatedRawMemory += size;
+}
+
+void MemoryDiagnosticsStorage::onRawMemoryDeleted(const void* el)
+{
+    _allocatedRawMemory -= forget(el);
+}
+
+MemoryDiagnosticsStorage::Size MemoryDiagnosticsStorage::forget(const void* el)
+{
+    auto it = _allocatedObjectTable.find(el);
+    if (it == _allocatedObjectTable.end())
+    {
+        return 0;
+    }
+
+    const auto size = it->second;
+    _allocatedManagedMemory -= size;
+    _allocatedObjectTable.erase(it);
+
+    return size;
+}
@@ -40,15 +40,7 @@ void* MemoryManager::allocateMemoryForObject(std::size_t size)
     _memoryDiagnosticPimpl->onObjectAllocated(ptr, size);
     _gc->addObject(Object::asObjectPtr(ptr));
 
-    if (needToFreeMemory())
-    {
-        if (!_memoryCleaner->isCollectScheduled())
-            LOG_INFO("Need to free memory. Memory threshold " + std::to_string(_memoryThreshold) +
-                     ", currently memory consumption " +
-                     std::to_string(_memoryDiagnosticPimpl->getCurrentAllocatedBytes()) + " bytes");
-
-        _memoryCleaner->asyncClear([this]() { onAfterMemoryClean(); });
-    }
+    scheduleCollectIfNeeded();
 
     return ptr;
 }
@@ -58,6 +50,32 @@ void* MemoryManager::allocate(std::size_t n)
     return _allocator->allocate(n);
 }
 
+void* MemoryManager::allocateTraced(std::size_t n)
+{
+    auto* ptr = _allocator->allocate(n);
+    _memoryDiagnosticPimpl->onRawMemoryAllocated(ptr, n);
+    _gc->addRawMemory(ptr, n);
+
+    scheduleCollectIfNeeded();
+
+    return ptr;
+}
+
+void MemoryManager::scheduleCollectIfNeeded()
+{
+    if (!needToFreeMemory())
+    {
+        return;
+    }
+
+    if (!_memoryCleaner->isCollectScheduled())
+        LOG_INFO("Need to free memory. Memory threshold " + std::to_string(_memoryThreshold) +
+                 ", currently memory consumption " +
+                 std::to_string(_memoryDiagnosticPimpl->getCurrentAllocatedBytes()) + " bytes");
+
+    _memoryCleaner->asyncClear([this]() { onAfterMemoryClean(); });
+}
+
 MemoryDiagnostics* MemoryManager::getMemoryDiagnostics() const
 {
     return new MemoryDiagnostics(*_memoryDiagnosticPimpl.get(), *_gc.get());
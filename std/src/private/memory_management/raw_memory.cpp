@@ -0,0 +1,118 @@
+#include "std/private/memory_management/raw_memory.h"
+
+#include "std/private/logger.h"
+
+#include "std/tsclosure.h"
+#include "std/tslazy_closure.h"
+
+#include <vector>
+
+void RawMemory::add(void* block, std::size_t size)
+{
+    LOG_ADDRESS("Adding raw memory block: ", block);
+    _blocks[block] = size;
+}
+
+bool RawMemory::contains(const void* block) const
+{
+    return _blocks.count(block) > 0;
+}
+
+std::size_t RawMemory::getBlocksCount() const
+{
+    return _blocks.size();
+}
+
+void RawMemory::mark(const Roots& roots, const UniqueConstObjects& markedObjects)
+{
+    for (Object** root : roots)
+    {
+        markBlock(root);
+    }
+
+    for (const Object* object : markedObjects)
+    {
+        markEnvironment(object);
+    }
+}
+
+bool RawMemory::isMarked(const void* block) const
+{
+    return _marked.count(block) > 0;
+}
+
+void RawMemory::unmark()
+{
+    _marked.clear();
+}
+
+void RawMemory::sweep(const DeleteBlock& deleteBlock)
+{
+    auto it = _blocks.begin();
+    while (it != _blocks.end())
+    {
+        const void* block = it->first;
+
+        if (isMarked(block))
+        {
+            ++it;
+            continue;
+        }
+
+        LOG_ADDRESS("Deleting raw memory block ", block);
+        deleteBlock(const_cast<void*>(block));
+
+        it = _blocks.erase(it);
+    }
+}
+
+void RawMemory::markBlock(const void* block)
+{
+    // environments are nested up to the depth of the closures, but keep the stack flat anyway
+    std::vector<const void*> pending{block};
+
+    while (!pending.empty())
+    {
+        const void* current = pending.back();
+        pending.pop_back();
+
+        auto it = _blocks.find(current);
+        if (it == _blocks.end() || !_marked.insert(current).second)
+        {
+            continue;
+        }
+
+        const auto* words = static_cast<const void* const*>(current);
+        const auto wordsCount = it->second / sizeof(void*);
+
+        for (std::size_t i = 0; i < wordsCount; ++i)
+        {
+            if (words[i] && _blocks.count(words[i]) > 0)
+            {
+                pending.push_back(words[i]);
+            }
+        }
+    }
+}
+
+void RawMemory::markEnvironment(const Object* object)
+{
+    if (object->isClosure())
+    {
+        const auto* closure = static_cast<const TSClosure*>(object);
+        void*** env = closure->getEnvironment();
+
+        // inline environment is a part of the closure object, its cells are not
+        markBlock(env);
+
+        for (std::uint32_t i = 0; env && i < closure->getEnvironmentLength(); ++i)
+        {
+            markBlock(env[i]);
+        }
+    }
+    else if (object->isLazyClosure())
+    {
+        auto* lazyClosure = const_cast<TSLazyClosure*>(static_cast<const TSLazyClosure*>(object));
+        markBlock(lazyClosure->getEnvironment());
+    }
+}
@@ -0,0 +1,54 @@
+#include "std/private/memory_management/stack_frames.h"
+
+#include "std/private/logger.h"
+
+namespace
+{
+std::uintptr_t toAddress(const void* ptr)
+{
+    return reinterpret_cast<std::uintptr_t>(ptr);
+}
+} // namespace
+
+void StackFrames::push(Object** slots, std::size_t slotsCount)
+{
+    LOG_ADDRESS("Pushing stack frame: ", slots);
+
+    // previous call at the same depth (or deeper) is over
+    dropFrom(toAddress(slots));
+    _frames.push_back({slots, slotsCount});
+}
+
+void StackFrames::pop(Object** slots)
+{
+    LOG_ADDRESS("Popping stack frame: ", slots);
+    dropFrom(toAddress(slots));
+}
+
+void StackFrames::dropBelow(const void* stackAddress)
+{
+    const auto address = toAddress(stackAddress);
+
+    if (address > 0)
+    {
+        dropFrom(address - 1);
+    }
+}
+
+void StackFrames::clear()
+{
+    _frames.clear();
+}
+
+const std::vector<StackFrames::Frame>& StackFrames::getFrames() const
+{
+    return _frames;
+}
+
+void StackFrames::dropFrom(std::uintptr_t address)
+{
+    while (!_frames.empty() && toAddress(_frames.back().slots) <= address)
+    {
+        _frames.pop_back();
+    }
+}
@@ -0,0 +1,445 @@
+#include "std/private/number_formatter.h"
+
+#include "number_formatter_tables.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+constexpr std::size_t NumberFormatter::MAX_LENGTH;
+
+namespace
+{
+constexpr int g_DoubleMantissaBits = 52;
+constexpr int g_DoubleExponentBits = 11;
+constexpr int g_DoubleBias = 1023;
+
+constexpr int g_Pow5InvBitCount = 125;
+constexpr int g_Pow5BitCount = 125;
+
+// Largest integer such that every smaller integral double is printed by the integer fast path
+constexpr double g_MaxFastPathInteger = 9007199254740992.0; // 2^53
+
+constexpr char g_DigitPairs[] = "00010203040506070809"
+                                "10111213141516171819"
+                                "20212223242526272829"
+                                "30313233343536373839"
+                                "40414243444546474849"
+                                "50515253545556575859"
+                                "60616263646566676869"
+                                "70717273747576777879"
+                                "80818283848586878889"
+                                "90919293949596979899";
+
+struct Decimal
+{
+    std::uint64_t digits = 0;
+    std::int32_t exponent = 0;
+};
+
+std::uint32_t decimalLength(std::uint64_t v)
+{
+    std::uint32_t length = 1;
+    while (v >= 10)
+    {
+        v /= 10;
+        ++length;
+    }
+    return length;
+}
+
+// Writes exactly `length` digits of v into out
+void writeDigits(std::uint64_t v, std::uint32_t length, char* out)
+{
+    char* p = out + length;
+    while (v >= 100)
+    {
+        const auto pair = static_cast<std::uint32_t>(v % 100) * 2;
+        v /= 100;
+        *--p = g_DigitPairs[pair + 1];
+        *--p = g_DigitPairs[pair];
+    }
+    if (v >= 10)
+    {
+        const auto pair = static_cast<std::uint32_t>(v) * 2;
+        *--p = g_DigitPairs[pair + 1];
+        *--p = g_DigitPairs[pair];
+    }
+    else
+    {
+        *--p = static_cast<char>('0' + v);
+    }
+}
+
+// floor(log2(5^e)) + 1 for 0 <= e <= 3528
+std::int32_t pow5bits(std::int32_t e)
+{
+    return static_cast<std::int32_t>((static_cast<std::uint32_t>(e) * 1217359) >> 19) + 1;
+}
+
+// floor(log10(2^e)) for 0 <= e <= 1650
+std::uint32_t log10Pow2(std::int32_t e)
+{
+    return (static_cast<std::uint32_t>(e) * 78913) >> 18;
+}
+
+// floor(log10(5^e)) for 0 <= e <= 2620
+std::uint32_t log10Pow5(std::int32_t e)
+{
+    return (static_cast<std::uint32_t>(e) * 732923) >> 20;
+}
+
+std::uint32_t pow5Factor(std::uint64_t value)
+{
+    std::uint32_t count = 0;
+    while (value % 5 == 0)
+    {
+        value /= 5;
+        ++count;
+    }
+    return count;
+}
+
+bool multipleOfPowerOf5(std::uint64_t value, std::uint32_t p)
+{
+    return pow5Factor(value) >= p;
+}
+
+bool multipleOfPowerOf2(std::uint64_t value, std::uint32_t p)
+{
+    return (value & ((1ull << p) - 1)) == 0;
+}
+
+// (m * mul) >> j, where mul is a 128-bit {low, high} value and j >= 64
+std::uint64_t mulShift64(std::uint64_t m, const std::uint64_t* mul, std::int32_t j)
+{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 b0 = static_cast<unsigned __int128>(m) * mul[0];
+    const unsigned __int128 b2 = static_cast<unsigned __int128>(m) * mul[1];
+    return static_cast<std::uint64_t>(((b0 >> 64) + b2) >> (j - 64));
+#else
+    auto umul128 = [](std::uint64_t a, std::uint64_t b, std::uint64_t& high) -> std::uint64_t
+    {
+#if defined(_MSC_VER) && defined(_M_X64)
+        return _umul128(a, b, &high);
+#else
+        const std::uint64_t aLo = static_cast<std::uint32_t>(a);
+        const std::uint64_t aHi = a >> 32;
+        const std::uint64_t bLo = static_cast<std::uint32_t>(b);
+        const std::uint64_t bHi = b >> 32;
+
+        const std::uint64_t loLo = aLo * bLo;
+        const std::uint64_t hiLo = aHi * bLo;
+        const std::uint64_t loHi = aLo * bHi;
+        const std::uint64_t hiHi = aHi * bHi;
+
+        const std::uint64_t mid = (loLo >> 32) + static_cast<std::uint32_t>(hiLo) + static_cast<std::uint32_t>(loHi);
+        high = hiHi + (hiLo >> 32) + (loHi >> 32) + (mid >> 32);
+        return (mid << 32) | static_cast<std::uint32_t>(loLo);
+#endif
+    };
+
+    std::uint64_t high1 = 0;
+    const std::uint64_t low1 = umul128(m, mul[1], high1);
+    std::uint64_t high0 = 0;
+    umul128(m, mul[0], high0);
+
+    const std::uint64_t sum = high0 + low1;
+    if (sum < high0)
+    {
+        ++high1;
+    }
+
+    const auto shift = static_cast<std::uint32_t>(j - 64);
+    return shift == 0 ? sum : (high1 << (64 - shift)) | (sum >> shift);
+#endif
+}
+
+// Shortest decimal in the rounding interval of the double given by its IEEE fields
+Decimal shortestDecimal(std::uint64_t ieeeMantissa, std::uint32_t ieeeExponent)
+{
+    std::int32_t e2 = 0;
+    std::uint64_t m2 = 0;
+    if (ieeeExponent == 0)
+    {
+        e2 = 1 - g_DoubleBias - g_DoubleMantissaBits - 2;
+        m2 = ieeeMantissa;
+    }
+    else
+    {
+        e2 = static_cast<std::int32_t>(ieeeExponent) - g_DoubleBias - g_DoubleMantissaBits - 2;
+        m2 = (1ull << g_DoubleMantissaBits) | ieeeMantissa;
+    }
+
+    const bool acceptBounds = (m2 & 1) == 0;
+
+    // Interval bounds are scaled by 4 to keep them integral: [mv - 2 + mmShift, mv + 2]
+    const std::uint64_t mv = 4 * m2;
+    const std::uint32_t mmShift = ieeeMantissa != 0 || ieeeExponent <= 1;
+
+    std::uint64_t vr = 0;
+    std::uint64_t vp = 0;
+    std::uint64_t vm = 0;
+    std::int32_t e10 = 0;
+    bool vmIsTrailingZeros = false;
+    bool vrIsTrailingZeros = false;
+
+    if (e2 >= 0)
+    {
+        const std::uint32_t q = log10Pow2(e2) - (e2 > 3);
+        e10 = static_cast<std::int32_t>(q);
+        const std::int32_t k = g_Pow5InvBitCount + pow5bits(static_cast<std::int32_t>(q)) - 1;
+        const std::int32_t i = -e2 + static_cast<std::int32_t>(q) + k;
+
+        vr = mulShift64(4 * m2, ryu::g_Pow5InvSplit[q], i);
+        vp = mulShift64(4 * m2 + 2, ryu::g_Pow5InvSplit[q], i);
+        vm = mulShift64(4 * m2 - 1 - mmShift, ryu::g_Pow5InvSplit[q], i);
+
+        if (q <= 21)
+        {
+            if (mv % 5 == 0)
+            {
+                vrIsTrailingZeros = multipleOfPowerOf5(mv, q);
+            }
+            else if (acceptBounds)
+            {
+                vmIsTrailingZeros = multipleOfPowerOf5(mv - 1 - mmShift, q);
+            }
+            else
+            {
+                vp -= multipleOfPowerOf5(mv + 2, q);
+            }
+        }
+    }
+    else
+    {
+        const std::uint32_t q = log10Pow5(-e2) - (-e2 > 1);
+        e10 = static_cast<std::int32_t>(q) + e2;
+        const std::int32_t i = -e2 - static_cast<std::int32_t>(q);
+        const std::int32_t k = pow5bits(i) - g_Pow5BitCount;
+        const std::int32_t j = static_cast<std::int32_t>(q) - k;
+
+        vr = mulShift64(4 * m2, ryu::g_Pow5Split[i], j);
+        vp = mulShift64(4 * m2 + 2, ryu::g_Pow5Split[i], j);
+        vm = mulShift64(4 * m2 - 1 - mmShift, ryu::g_Pow5Split[i], j);
+
+        if (q <= 1)
+        {
+            // mv has at least q trailing zero bits, so vr is exact
+            vrIsTrailingZeros = true;
+            if (acceptBounds)
+            {
+                vmIsTrailingZeros = mmShift == 1;
+            }
+            else
+            {
+                --vp;
+            }
+        }
+        else if (q < 63)
+        {
+            vrIsTrailingZeros = multipleOfPowerOf2(mv, q);
+        }
+    }
+
+    std::int32_t removed = 0;
+    std::uint8_t lastRemovedDigit = 0;
+    std::uint64_t output = 0;
+
+    if (vmIsTrailingZeros || vrIsTrailingZeros)
+    {
+        // Rare path: exact ties have to be rounded to even
+        while (vp / 10 > vm / 10)
+        {
+            vmIsTrailingZeros &= vm % 10 == 0;
+            vrIsTrailingZeros &= lastRemovedDigit == 0;
+            lastRemovedDigit = static_cast<std::uint8_t>(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+
+        if (vmIsTrailingZeros)
+        {
+            while (vm % 10 == 0)
+            {
+                vrIsTrailingZeros &= lastRemovedDigit == 0;
+                lastRemovedDigit = static_cast<std::uint8_t>(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                ++removed;
+            }
+        }
+
+        if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0)
+        {
+            lastRemovedDigit = 4;
+        }
+
+        output = vr + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+    }
+    else
+    {
+        bool roundUp = false;
+
+        if (vp / 100 > vm / 100)
+        {
+            roundUp = vr % 100 >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+
+        while (vp / 10 > vm / 10)
+        {
+            roundUp = vr % 10 >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+
+        output = vr + (vr == vm || roundUp);
+    }
+
+    Decimal result;
+    result.digits = output;
+    result.exponent = e10 + removed;
+    return result;
+}
+
+std::size_t writeString(const char* str, char* out)
+{
+    const auto length = std::strlen(str);
+    std::memcpy(out, str, length);
+    return length;
+}
+
+// Lays out value = digits * 10^exponent following Number::toString(10):
+// https://tc39.es/ecma262/multipage/ecmascript-data-types-and-values.html#sec-numeric-types-number-tostring
+std::size_t writeDecimal(const Decimal& decimal, char* out)
+{
+    const auto k = static_cast<std::int32_t>(decimalLength(decimal.digits));
+    const std::int32_t n = decimal.exponent + k;
+
+    char* p = out;
+
+    if (k <= n && n <= 21)
+    {
+        writeDigits(decimal.digits, k, p);
+        p += k;
+        std::memset(p, '0', n - k);
+        p += n - k;
+    }
+    else if (0 < n && n <= 21)
+    {
+        writeDigits(decimal.digits, k, p);
+        std::memmove(p + n + 1, p + n, k - n);
+        p[n] = '.';
+        p += k + 1;
+    }
+    else if (-6 < n && n <= 0)
+    {
+        *p++ = '0';
+        *p++ = '.';
+        std::memset(p, '0', -n);
+        p += -n;
+        writeDigits(decimal.digits, k, p);
+        p += k;
+    }
+    else
+    {
+        writeDigits(decimal.digits, k, p + 1);
+        p[0] = p[1];
+        if (k > 1)
+        {
+            p[1] = '.';
+            p += k + 1;
+        }
+        else
+        {
+            p += 1;
+        }
+
+        *p++ = 'e';
+        const std::int32_t e = n - 1;
+        *p++ = e < 0 ? '-' : '+';
+
+        const auto absExponent = static_cast<std::uint64_t>(e < 0 ? -e : e);
+        const auto exponentLength = decimalLength(absExponent);
+        writeDigits(absExponent, exponentLength, p);
+        p += exponentLength;
+    }
+
+    return static_cast<std::size_t>(p - out);
+}
+} // namespace
+
+std::size_t NumberFormatter::format(double value, char* buffer) noexcept
+{
+    if (std::isnan(value))
+    {
+        return writeString("NaN", buffer);
+    }
+
+    // Covers -0 as well
+    if (value == 0.0)
+    {
+        buffer[0] = '0';
+        return 1;
+    }
+
+    char* p = buffer;
+    if (value < 0)
+    {
+        *p++ = '-';
+        value = -value;
+    }
+
+    if (std::isinf(value))
+    {
+        return static_cast<std::size_t>(p - buffer) + writeString("Infinity", p);
+    }
+
+    Decimal decimal;
+
+    // Integers are the most common case and their digits are exact
+    if (value < g_MaxFastPathInteger && std::floor(value) == value)
+    {
+        decimal.digits = static_cast<std::uint64_t>(value);
+    }
+    else
+    {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(double));
+
+        const std::uint64_t ieeeMantissa = bits & ((1ull << g_DoubleMantissaBits) - 1);
+        const auto ieeeExponent =
+            static_cast<std::uint32_t>((bits >> g_DoubleMantissaBits) & ((1u << g_DoubleExponentBits) - 1));
+
+        decimal = shortestDecimal(ieeeMantissa, ieeeExponent);
+    }
+
+    return static_cast<std::size_t>(p - buffer) + writeDecimal(decimal, p);
+}
+
+void NumberFormatter::appendTo(double value, std::string& out)
+{
+    char buffer[MAX_LENGTH];
+    const auto length = format(value, buffer);
+    out.append(buffer, length);
+}
+
+std::string NumberFormatter::toString(double value)
+{
+    char buffer[MAX_LENGTH];
+    const auto length = format(value, buffer);
+    return std::string(buffer, length);
+}
@@ -5,11 +5,21 @@
 #include "std/tsstring.h"
 #include "std/tsunion.h"
 
+#include <absl/strings/charconv.h>
+
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <system_error>
+
 namespace
 {
 constexpr static const int g_MinRadix = 2;
 constexpr static const int g_MaxRadix = 36;
 
+constexpr static const char g_Infinity[] = "Infinity";
+
 int digitVal(char ch, int radix)
 {
     if (radix < g_MinRadix || radix > g_MaxRadix)
@@ -31,140 +41,178 @@ int digitVal(char ch, int radix)
     return -1;
 }
 
-size_t trimBegin(const std::string& s, size_t currentPos)
+const char* trimBegin(const char* first, const char* last)
 {
-    while (isspace(s[currentPos]))
+    while (first != last && std::isspace(static_cast<unsigned char>(*first)))
     {
-        ++currentPos;
+        ++first;
     }
-    return currentPos;
+    return first;
 }
 
-bool hasPrefix(const std::string& s, std::size_t idx)
+bool hasPrefix(const char* first, const char* last)
 {
-    if ((s.size() - idx >= 2) && s[idx] == '0')
+    if (last - first >= 2 && first[0] == '0')
     {
-        return (s[idx + 1] == 'X' || s[idx + 1] == 'x');
+        return (first[1] == 'X' || first[1] == 'x');
     }
     return false;
 }
 
-double parseIntImpl(const std::string& s, int radix)
+bool startsWith(const char* first, const char* last, const char* prefix)
+{
+    const auto length = std::strlen(prefix);
+    return static_cast<std::size_t>(last - first) >= length && std::memcmp(first, prefix, length) == 0;
+}
+
+// Correctly rounded conversion of a decimal literal prefix. Never matches a sign, "inf" or "nan".
+// Returns false if there is no decimal literal at the beginning of [first, last)
+bool parseDecimal(const char* first, const char* last, absl::chars_format format, double& result)
 {
-    if (s.empty())
+    if (first == last || !(std::isdigit(static_cast<unsigned char>(*first)) || *first == '.'))
+    {
+        return false;
+    }
+
+    const auto parsed = absl::from_chars(first, last, result, format);
+    if (parsed.ec == std::errc::invalid_argument)
+    {
+        return false;
+    }
+    if (parsed.ec == std::errc::result_out_of_range)
+    {
+        // absl leaves either the closest finite value or zero there
+        result = result == 0.0 ? 0.0 : NumberPrivate::POSITIVE_INFINITY();
+    }
+    return true;
+}
+
+double parseIntImpl(const char* first, const char* last, int radix)
+{
+    first = trimBegin(first, last);
+    if (first == last)
     {
         return NumberPrivate::NaN();
     }
-    bool negative{false};
-    size_t left = trimBegin(s, 0);
-    double limit = -NumberPrivate::MAX_VALUE();
 
-    if (s[left] == '-')
+    bool negative{false};
+    if (*first == '-')
     {
         negative = true;
-        limit = constants::DoubleTraits::lowest();
-        ++left;
+        ++first;
     }
-    else if (s[left] == '+')
+    else if (*first == '+')
     {
-        ++left;
+        ++first;
     }
-    if (hasPrefix(s, left))
+    if (hasPrefix(first, last))
     {
         if (radix == 0 || radix == 16)
         {
             radix = 16;
-            left += 2;
+            first += 2;
         }
     }
     if (radix == 0)
     {
         radix = 10;
     }
-    if (left >= s.size())
+    if (first == last || digitVal(*first, radix) < 0)
     {
         return NumberPrivate::NaN();
     }
-    if (digitVal(s[left], radix) < 0)
+
+    const char* digitsEnd = first;
+    while (digitsEnd != last && digitVal(*digitsEnd, radix) >= 0)
     {
-        return NumberPrivate::NaN();
+        ++digitsEnd;
     }
 
     double result{0};
-    double mulLimit = MathPrivate::toInteger(limit / radix);
-    int digit{0};
 
-    while (left < s.size())
+    if (radix == 10)
     {
-        digit = digitVal(s[left++], radix);
-        if (digit < 0)
-        {
-            break;
-        }
-        if (result < mulLimit)
+        // Digits-only span, so it is always a valid fixed decimal
+        parseDecimal(first, digitsEnd, absl::chars_format::fixed, result);
+    }
+    else
+    {
+        // Exact while the value fits into 64 bits, approximated by doubles after that
+        constexpr auto maxExact = std::numeric_limits<std::uint64_t>::max();
+
+        std::uint64_t exact{0};
+        const char* it = first;
+        for (; it != digitsEnd; ++it)
         {
-            break;
+            const auto digit = static_cast<std::uint64_t>(digitVal(*it, radix));
+            if (exact > (maxExact - digit) / static_cast<std::uint64_t>(radix))
+            {
+                break;
+            }
+            exact = exact * radix + digit;
         }
-        result *= radix;
-        if (result < limit + digit)
+
+        result = static_cast<double>(exact);
+        for (; it != digitsEnd; ++it)
         {
-            break;
+            result = result * radix + digitVal(*it, radix);
         }
-        result -= digit;
     }
-    return negative ? result : -result;
+
+    return negative ? -result : result;
 }
 } // namespace
 
 Number* NumberParser::parseInt(String* str, Union* radix) noexcept
 {
-    int32_t base{10};
+    // Absent radix means "detect": hexadecimal for 0x-prefixed strings, decimal otherwise
+    int32_t base{0};
     if (radix->hasValue())
     {
         auto unboxed = static_cast<Number*>(radix->getValue())->unboxed();
         base = MathPrivate::toInt32(unboxed);
     }
-    double parsed = parseIntImpl(str->cpp_str(), base);
+
+    const auto& s = str->cpp_str();
+    double parsed = parseIntImpl(s.data(), s.data() + s.size(), base);
 
     return new Number{parsed};
 }
 
 double NumberParser::parseFloat(const std::string& str) noexcept
 {
-    if (str.empty())
-    {
-        return NumberPrivate::NaN();
-    }
-    size_t left = trimBegin(str, 0);
+    const char* first = trimBegin(str.data(), str.data() + str.size());
+    const char* last = str.data() + str.size();
 
     bool negate = false;
-    if (str[left] == '-')
+    if (first != last && (*first == '-' || *first == '+'))
     {
-        negate = true;
+        negate = *first == '-';
+        ++first;
     }
 
-    if (hasPrefix(str, left))
+    if (startsWith(first, last, g_Infinity))
     {
-        return 0.0;
+        return negate ? NumberPrivate::NEGATIVE_INFINITY() : NumberPrivate::POSITIVE_INFINITY();
     }
 
-    try
+    // Hexadecimal literals are not a part of StrDecimalLiteral, only the leading zero is
+    if (hasPrefix(first, last))
     {
-        return std::stod(str.substr(left));
+        return negate ? -0.0 : 0.0;
     }
-    catch (const std::invalid_argument&)
+
+    double result{0};
+    if (!parseDecimal(first, last, absl::chars_format::general, result))
     {
         return NumberPrivate::NaN();
     }
-    catch (std::out_of_range&)
-    {
-        return negate ? NumberPrivate::NEGATIVE_INFINITY() : NumberPrivate::POSITIVE_INFINITY();
-    }
+
+    return negate ? -result : result;
 }
 
 Number* NumberParser::parseFloat(String* str) noexcept
 {
-    auto s = str->cpp_str();
-    const auto result = parseFloat(s);
+    const auto result = parseFloat(str->cpp_str());
     return new Number(result);
 }
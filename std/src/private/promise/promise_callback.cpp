@@ -1,10 +1,25 @@
 #include "std/private/promise/promise_callback.h"
+#include "std/gc.h"
+#include "std/runtime.h"
 #include "std/tsclosure.h"
 #include "std/tsobject.h"
 #include "std/tsundefined.h"
 
 #include <cassert>
 
+namespace
+{
+// Compiled functions left by the exception have not unregistered their frames: they lie deeper than 'catcher'.
+// Otherwise a later gc.collect() in the same task reads their dead slots as roots
+void dropFramesBelow(const void* catcher)
+{
+    if (Runtime::isInitialized() && Runtime::getMemoryManager())
+    {
+        Runtime::getGC()->dropFramesBelow(catcher);
+    }
+}
+} // namespace
+
 PromiseCallback::PromiseCallback(Object* onFulfilled, Object* onRejected, PromisePrivate nextPromise)
     : _onFulfilled{onFulfilled}
     , _onRejected{onRejected}
@@ -36,6 +51,8 @@ void PromiseCallback::invoke(Object* object, Result&& arg) noexcept
 
 void PromiseCallback::callClosure(TSClosure* closure, Result&& arg) noexcept
 {
+    const char catcher = 0;
+
     try
     {
         bool hasArguments = closure->getNumArgs() != 0;
@@ -53,11 +70,13 @@ void PromiseCallback::callClosure(TSClosure* closure, Result&& arg) noexcept
     }
     catch (void* e) // On TS side exception has type a void *
     {
+        dropFramesBelow(&catcher);
         auto* reason = Object::asObjectPtr(e);
         _nextPromise.reject(reason);
     }
     catch (...)
     {
+        dropFramesBelow(&catcher);
         _nextPromise.reject(Undefined::instance());
     }
 }
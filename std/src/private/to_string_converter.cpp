@@ -39,81 +39,175 @@
 #include "std/runtime.h"
 #include "std/tsmath.h"
 
-#include "std/private/algorithms.h"
+#include "std/private/number_formatter.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
 
 constexpr int8_t PADDING_WIDTH = 2;
 constexpr auto FOUND_RECURSIVE = "<Error! Found circular structure>\n";
 
-static std::string shiftLines(std::string&& str)
+// Appends text to the output. Every line break of a nested value is followed by
+// the indentation of its enclosing objects, so the value needs no reformatting afterwards.
+class ToStringConverter::Writer
 {
-    const auto newLineWithShift = "\n" + std::string(PADDING_WIDTH, ' ');
-    utils::replaceAll(str, "\n", newLineWithShift);
-    return str;
-}
+public:
+    explicit Writer(std::string& out)
+        : _out(out)
+    {
+    }
 
-static std::string removeEnclosingBrackets(std::string&& str)
-{
-    if (str.empty())
+    Writer& operator<<(const char* str)
     {
-        return str;
+        return write(str, std::strlen(str));
     }
 
-    if (str[0] == '{' && str[str.size() - 1] == '}')
+    Writer& operator<<(const std::string& str)
     {
-        return str.substr(1, str.size() - 2);
+        return write(str.data(), str.size());
     }
 
-    assert("Cannot remove enclosing brackets to format string.");
-    return str;
-}
+    Writer& operator<<(char c)
+    {
+        return write(&c, 1);
+    }
 
-static std::string removeNewLineAtEnd(std::string&& str)
-{
-    if (str.size() > 0 && str[str.size() - 1] == '\n')
+    Writer& writeNumber(double value)
     {
-        return str.substr(0, str.size() - 1);
+        NumberFormatter::appendTo(value, _out);
+        return *this;
     }
 
-    return str;
-}
+    // Exact for the whole range of the type, unlike writeNumber above 2^53
+    template <typename T>
+    Writer& writeInteger(T value)
+    {
+        static_assert(std::is_integral<T>::value, "Expected integral type");
 
-static std::string formatParent(std::string&& parentData)
-{
-    return removeNewLineAtEnd(removeEnclosingBrackets(std::move(parentData)));
-}
+        const absl::AlphaNum formatted{value};
+        return write(formatted.data(), formatted.size());
+    }
 
-static std::string convertTSClosureEnvironment(const TSClosure& closure)
-{
-    std::stringstream ss;
+    // Same notation as std::ostream uses for void*
+    Writer& writePointer(const void* ptr)
+    {
+        auto value = reinterpret_cast<std::uintptr_t>(ptr);
+        if (value == 0)
+        {
+            return *this << '0';
+        }
+
+        char buffer[2 + 2 * sizeof(std::uintptr_t)];
+        char* p = buffer + sizeof(buffer);
+        while (value != 0)
+        {
+            *--p = "0123456789abcdef"[value & 0xF];
+            value >>= 4;
+        }
+        *--p = 'x';
+        *--p = '0';
 
-    ss << "Env address: " << closure.getEnvironment() << std::endl;
+        return write(p, static_cast<std::size_t>(buffer + sizeof(buffer) - p));
+    }
+
+    Writer& newLine()
+    {
+        return *this << '\n';
+    }
+
+    void indent()
+    {
+        _indent += PADDING_WIDTH;
+    }
+
+    void unindent()
+    {
+        _indent -= PADDING_WIDTH;
+    }
+
+    std::size_t size() const
+    {
+        return _out.size();
+    }
+
+private:
+    Writer& write(const char* data, std::size_t size)
+    {
+        if (_indent == 0)
+        {
+            _out.append(data, size);
+            return *this;
+        }
+
+        const char* end = data + size;
+        while (data != end)
+        {
+            const auto* lineEnd = static_cast<const char*>(std::memchr(data, '\n', end - data));
+            if (!lineEnd)
+            {
+                _out.append(data, end);
+                break;
+            }
+
+            _out.append(data, lineEnd + 1);
+            _out.append(_indent, ' ');
+            data = lineEnd + 1;
+        }
+
+        return *this;
+    }
+
+private:
+    std::string& _out;
+    std::size_t _indent = 0;
+};
+
+template <typename Writer>
+static void convertTSClosureEnvironment(const TSClosure& closure, Writer& writer)
+{
+    writer << "Env address: ";
+    writer.writePointer(closure.getEnvironment()).newLine();
 
     const auto nArgs = closure.getNumArgs();
     const auto env = closure.getEnvironment();
     const auto envLen = closure.getEnvironmentLength();
-    auto printAddress = [&ss](auto msg, auto& value) { ss << msg << std::hex << ((void*)value) << std::endl; };
 
     for (std::uint32_t i = 0; i < nArgs; ++i)
     {
-        printAddress("Arg void** ", env[i]);
+        writer << "Arg void** ";
+        writer.writePointer(env[i]).newLine();
     }
 
     for (std::uint32_t i = nArgs; i < envLen; ++i)
     {
-        printAddress("Captured void** ", env[i]);
+        writer << "Captured void** ";
+        writer.writePointer(env[i]).newLine();
     }
-
-    return ss.str();
 }
 
 template <>
-std::string ToStringConverter::toString(const Object* obj, Visited& visited)
+void ToStringConverter::toString(const Object* obj, Visited& visited, Writer& writer)
 {
-    std::ostringstream oss;
+    writer << '{';
 
-    const auto& keys = obj->getKeys();
+    if (writeProps(obj, visited, writer))
+    {
+        writer.newLine();
+    }
+
+    writer << '}';
+}
 
-    oss << "{";
+// Writes own props and then parent props of obj, each one on a new line.
+// Returns whether the enclosing brackets have to be separated by a line break.
+bool ToStringConverter::writeProps(const Object* obj, Visited& visited, Writer& writer)
+{
+    const auto& keys = obj->getKeys();
 
     bool parentPropsEmpty = false;
 
@@ -121,164 +215,173 @@ std::string ToStringConverter::toString(const Object* obj, Visited& visited)
     {
         auto value = obj->get(key);
 
-        oss << std::endl;
-        oss << std::string(PADDING_WIDTH, ' ') << "\"" << key << "\""
-            << ": ";
+        writer.newLine();
+        writer << "  \"" << key->cpp_str() << "\": ";
 
-        oss << shiftLines(ToStringConverter::convertWithCheck(value, visited));
+        writer.indent();
+        ToStringConverter::convertWithCheck(value, visited, writer);
+        writer.unindent();
     }
 
     String parentKey("parent");
     const auto* parent = obj->get(&parentKey);
     if (parent && parent != Undefined::instance())
     {
-        auto data = formatParent(ToStringConverter::convert(parent));
-        parentPropsEmpty = data.empty();
-        oss << data;
+        parentPropsEmpty = !writeParent(parent, writer);
     }
 
-    if (!keys.empty())
+    return !keys.empty() && !(keys.size() == 1 && parentPropsEmpty);
+}
+
+// Parent props are printed inline, as if they were own props of the derived object.
+// Returns false if nothing was written.
+bool ToStringConverter::writeParent(const Object* parent, Writer& writer)
+{
+    const auto sizeBefore = writer.size();
+
+    // Parent chain is checked for circularity on its own
+    Visited visited;
+    visited.insert(parent);
+
+    if (!convertSpecial(parent, visited, writer))
     {
-        if (!(keys.size() == 1 && parentPropsEmpty))
-        {
-            oss << std::endl;
-        }
+        writeProps(parent, visited, writer);
     }
 
-    oss << "}";
-
-    return oss.str();
+    return writer.size() != sizeBefore;
 }
 
 template <>
-std::string ToStringConverter::toString(const NumberPrivate* np, Visited& visited)
+void ToStringConverter::toString(const NumberPrivate* np, Visited& visited, Writer& writer)
 {
-    return np->toString();
+    writer.writeNumber(np->unboxed());
 }
 
 template <>
-std::string ToStringConverter::toString(const DatePrivate* date, Visited& visited)
+void ToStringConverter::toString(const DatePrivate* date, Visited& visited, Writer& writer)
 {
-    return "Date: " + date->toString();
+    writer << "Date: " << date->toString();
 }
 
 template <>
-std::string ToStringConverter::toString(const StringPrivate* str, Visited& visited)
+void ToStringConverter::toString(const StringPrivate* str, Visited& visited, Writer& writer)
 {
-    return "\"" + str->cpp_str() + "\"";
+    writer << '"' << str->cpp_str() << '"';
 }
 
 template <>
-std::string ToStringConverter::toString(const MapPrivate<Object*, Object*>* map, Visited& visited)
+void ToStringConverter::toString(const MapPrivate<Object*, Object*>* map, Visited& visited, Writer& writer)
 {
-    std::ostringstream ss;
-
-    ss << "Map (" << map->orderedKeys().size() << ") {";
+    writer << "Map (";
+    writer.writeInteger(map->orderedKeys().size()) << ") {";
 
     bool isFirst = true;
     for (auto* key : map->orderedKeys())
     {
         const auto* value = map->get(key);
 
-        ss << (isFirst ? "" : ", ") << ToStringConverter::convertWithCheck(key, visited) << "=>"
-           << ToStringConverter::convertWithCheck(value, visited);
+        writer << (isFirst ? "" : ", ");
+        ToStringConverter::convertWithCheck(key, visited, writer);
+        writer << "=>";
+        ToStringConverter::convertWithCheck(value, visited, writer);
         isFirst = false;
     }
 
-    ss << "}";
-
-    return ss.str();
+    writer << '}';
 }
 
 template <>
-std::string ToStringConverter::toString(const ArrayPrivate<Object*>* array, Visited& visited)
+void ToStringConverter::toString(const ArrayPrivate<Object*>* array, Visited& visited, Writer& writer)
 {
-    std::ostringstream oss;
+    writer << '[';
 
     for (size_t i = 0; i < array->length(); ++i)
     {
         auto data = (*array)[i];
         if (data)
         {
-            oss << ToStringConverter::convertWithCheck(data, visited);
+            ToStringConverter::convertWithCheck(data, visited, writer);
         }
         else
         {
-            oss << "null";
+            writer << "null";
         }
 
         if (i != array->length() - 1)
         {
-            oss << ",";
+            writer << ',';
         }
     }
 
-    return "[" + oss.str() + "]";
+    writer << ']';
 }
 
 template <>
-std::string ToStringConverter::toString(const BooleanPrivate* b, Visited& visited)
+void ToStringConverter::toString(const BooleanPrivate* b, Visited& visited, Writer& writer)
 {
-    return b->toString();
+    writer << (b->value() ? "true" : "false");
 }
 
 template <>
-std::string ToStringConverter::toString(const Promise* p, Visited& visited)
+void ToStringConverter::toString(const Promise* p, Visited& visited, Writer& writer)
 {
-    std::ostringstream ss;
-    ss << "Promise. ";
+    writer << "Promise. ";
     if (p->ready())
     {
         const auto* pResult = p->getResult();
-        ss << "Result: " << ToStringConverter::convertWithCheck(pResult, visited);
+        writer << "Result: ";
+        ToStringConverter::convertWithCheck(pResult, visited, writer);
     }
     else
     {
-        ss << "Not ready";
+        writer << "Not ready";
     }
-
-    return ss.str();
 }
 
 template <>
-std::string ToStringConverter::toString(const SetPrivate<Object*>* set, Visited& visited)
+void ToStringConverter::toString(const SetPrivate<Object*>* set, Visited& visited, Writer& writer)
 {
-    std::ostringstream ss;
-    ss << "Set (" << set->ordered().size() << ") {";
+    writer << "Set (";
+    writer.writeInteger(set->ordered().size()) << ") {";
 
     bool isFirst = true;
     for (const auto value : set->ordered())
     {
-        ss << (isFirst ? "" : ",") << ToStringConverter::convertWithCheck(value, visited);
+        writer << (isFirst ? "" : ",");
+        ToStringConverter::convertWithCheck(value, visited, writer);
         isFirst = false;
     }
 
-    ss << "}";
-
-    return ss.str();
+    writer << '}';
 }
 
 template <>
-std::string ToStringConverter::toString(const Union* u, Visited& visited)
+void ToStringConverter::toString(const Union* u, Visited& visited, Writer& writer)
 {
-    std::ostringstream oss;
-    oss << "Union: " << ToStringConverter::convertWithCheck(u->getValue(), visited);
-    return oss.str();
+    writer << "Union: ";
+    ToStringConverter::convertWithCheck(u->getValue(), visited, writer);
 }
 
 std::string ToStringConverter::convert(const Object* obj)
 {
-    std::unordered_set<const Object*> visited;
-    return convertWithCheck(obj, visited);
+    std::string result;
+    convertTo(obj, result);
+    return result;
+}
+
+void ToStringConverter::convertTo(const Object* obj, std::string& out)
+{
+    Visited visited;
+    Writer writer(out);
+    convertWithCheck(obj, visited, writer);
 }
 
-std::string ToStringConverter::convertWithCheck(const Object* obj, Visited& visited)
+void ToStringConverter::convertWithCheck(const Object* obj, Visited& visited, Writer& writer)
 {
     if (visited.count(obj) > 0)
     {
-        std::ostringstream oss;
-        oss << FOUND_RECURSIVE;
-        return oss.str();
+        writer << FOUND_RECURSIVE;
+        return;
     }
     visited.insert(obj);
 
@@ -286,123 +389,157 @@ std::string ToStringConverter::convertWithCheck(const Object* obj, Visited& visi
 
     std::unique_ptr<const Object, decltype(clean)> cleaner(obj, clean);
 
+    if (convertSpecial(obj, visited, writer))
+    {
+        return;
+    }
+
+    if (obj->isObject())
+    {
+        toString(obj, visited, writer);
+        return;
+    }
+
+    throw std::runtime_error("Unsupported object type");
+}
+
+// Handles everything but plain objects. Returns false if obj is a plain object.
+bool ToStringConverter::convertSpecial(const Object* obj, Visited& visited, Writer& writer)
+{
     if (obj->isNumber())
     {
         const auto* number = static_cast<const Number*>(obj);
-        return toString(number->_d, visited);
+        toString(number->_d, visited, writer);
+        return true;
     }
 
     if (obj->isDate())
     {
         const auto* date = static_cast<const Date*>(obj);
-        return toString(date->_d, visited);
+        toString(date->_d, visited, writer);
+        return true;
     }
 
     if (obj->isString())
     {
         const auto* str = static_cast<const String*>(obj);
-        return toString(str->_d, visited);
+        toString(str->_d, visited, writer);
+        return true;
     }
 
     if (obj->isBoolean())
     {
         const auto* boolean = static_cast<const Boolean*>(obj);
-        return toString(boolean->_d, visited);
+        toString(boolean->_d, visited, writer);
+        return true;
     }
 
     if (obj->isPromise())
     {
         const auto* promise = static_cast<const Promise*>(obj);
-        return toString(promise, visited);
+        toString(promise, visited, writer);
+        return true;
     }
 
     if (obj->isNull())
     {
-        return "null";
+        writer << "null";
+        return true;
     }
 
     if (obj->isUndefined())
     {
-        return "undefined";
+        writer << "undefined";
+        return true;
     }
 
     if (obj->isClosure())
     {
         const auto* closure = static_cast<const TSClosure*>(obj);
-        return "Closure. " + std::string("ArgsCount: ") + std::to_string(closure->getNumArgs()) +
-               convertTSClosureEnvironment(*closure);
+        writer << "Closure. ArgsCount: ";
+        writer.writeInteger(closure->getNumArgs());
+        convertTSClosureEnvironment(*closure, writer);
+        return true;
     }
 
     if (obj->isLazyClosure())
     {
-        return "Lazy closure";
+        writer << "Lazy closure";
+        return true;
     }
 
     if (obj->isTimer())
     {
         const auto* timer = static_cast<const TimerObject*>(obj);
-        return "Timer:\n" + std::to_string(timer->due().count());
+        writer << "Timer:\n";
+        writer.writeInteger(timer->due().count());
+        return true;
     }
 
     if (dynamic_cast<const Math*>(obj))
     {
-        return "Math";
+        writer << "Math";
+        return true;
     }
 
     if (dynamic_cast<const Runtime*>(obj))
     {
-        return "Runtime";
+        writer << "Runtime";
+        return true;
     }
 
     if (dynamic_cast<const MemoryDiagnostics*>(obj))
     {
-        return "Memory Diagnostics";
+        writer << "Memory Diagnostics";
+        return true;
     }
 
     if (dynamic_cast<const EventLoop*>(obj))
     {
-        return "Event loop wrapper";
+        writer << "Event loop wrapper";
+        return true;
     }
 
     if (dynamic_cast<const GC*>(obj))
     {
-        return "GC Wrapper";
+        writer << "GC Wrapper";
+        return true;
     }
 
     if (obj->isArray())
     {
         const auto* arr = static_cast<const Array<Object*>*>(obj);
-        return toString(arr->_d, visited);
+        toString(arr->_d, visited, writer);
+        return true;
     }
 
     if (obj->isMap())
     {
         const auto* mapping = static_cast<const Map<Object*, Object*>*>(obj);
-        return toString(mapping->_d, visited);
+        toString(mapping->_d, visited, writer);
+        return true;
     }
 
     if (obj->isSet())
     {
         const auto* set = static_cast<const Set<Object*>*>(obj);
-        return toString(set->_d, visited);
+        toString(set->_d, visited, writer);
+        return true;
     }
 
     if (obj->isUnion())
     {
         const auto* u = static_cast<const Union*>(obj);
-        return toString(u, visited);
+        toString(u, visited, writer);
+        return true;
     }
 
     if (obj->isTuple())
     {
         const auto* t = static_cast<const Tuple*>(obj);
-        return toString(t->_d, visited);
-    }
-
-    if (obj->isObject())
-    {
-        return toString(obj, visited);
+        toString(t->_d, visited, writer);
+        return true;
     }
 
-    throw std::runtime_error("Unsupported object type");
-}
\ No newline at end of file
+    return false;
+}
@@ -1,6 +1,6 @@
 #include "std/private/tsboolean_cxx_builtin_p.h"
 
-#include <sstream>
+#include <string>
 
 BooleanCXXBuiltinPrivate::BooleanCXXBuiltinPrivate(bool value)
     : _value(value)
@@ -19,7 +19,5 @@ void BooleanCXXBuiltinPrivate::setValue(bool value)
 
 std::string BooleanCXXBuiltinPrivate::toString() const
 {
-    std::ostringstream oss;
-    oss << std::boolalpha << _value;
-    return oss.str();
+    return _value ? "true" : "false";
 }
\ No newline at end of file
@@ -4,17 +4,199 @@
 #include "absl/types/optional.h"
 
 #include <cmath>
-#include <vector>
+
+namespace
+{
+
+bool readDigits(const char*& it, const char* end, int count, int& value) noexcept
+{
+    if (end - it < count)
+    {
+        return false;
+    }
+
+    value = 0;
+    for (int i = 0; i < count; ++i, ++it)
+    {
+        if (*it < '0' || *it > '9')
+        {
+            return false;
+        }
+
+        value = value * 10 + (*it - '0');
+    }
+
+    return true;
+}
+
+bool isLeapYear(int year) noexcept
+{
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+int daysInMonth(int year, int month) noexcept
+{
+    static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return month == 2 && isLeapYear(year) ? 29 : days[month - 1];
+}
+
+// Hand-written matcher for the ISO 8601/RFC 3339 shapes of the format list in AbslDatePrivate::parse:
+// YYYY, YYYY-MM, YYYY-MM-DD, YYYY-MM-DDTHH:MM and YYYY-MM-DDTHH:MM[:SS[.fff]] followed by an optional Z or +hh:mm.
+// Interprets each shape exactly like the corresponding absl::ParseTime format does.
+// Anything unusual (extra whitespace, short fields, leap seconds, out of range values) is rejected
+// and left to absl::ParseTime, so this is only ever a shortcut.
+bool parseIsoDateTime(const std::string& date_string, const absl::TimeZone& local, double& result) noexcept
+{
+    const char* it = date_string.data();
+    const char* end = it + date_string.size();
+
+    int year = 0;
+    int month = 1;
+    int day = 1;
+    int hour = 0;
+    int minute = 0;
+    int second = 0;
+    int milliseconds = 0;
+
+    if (!readDigits(it, end, 4, year))
+    {
+        return false;
+    }
+
+    auto fromUtc = [&]()
+    {
+        auto time = absl::FromCivil(absl::CivilSecond(year, month, day, hour, minute, second), absl::UTCTimeZone());
+        result = static_cast<double>(absl::ToUnixMillis(time));
+        return true;
+    };
+
+    if (it == end)
+    {
+        return fromUtc();
+    }
+
+    if (*it++ != '-' || !readDigits(it, end, 2, month) || month < 1 || month > 12)
+    {
+        return false;
+    }
+
+    if (it == end)
+    {
+        return fromUtc();
+    }
+
+    if (*it++ != '-' || !readDigits(it, end, 2, day) || day < 1 || day > daysInMonth(year, month))
+    {
+        return false;
+    }
+
+    if (it == end)
+    {
+        return fromUtc();
+    }
+
+    const char separator = *it++;
+    if (separator != 'T' && separator != 't')
+    {
+        return false;
+    }
+
+    if (!readDigits(it, end, 2, hour) || hour > 23 || it == end || *it++ != ':' || !readDigits(it, end, 2, minute) ||
+        minute > 59)
+    {
+        return false;
+    }
+
+    const bool hasSeconds = it != end && *it == ':';
+    if (hasSeconds)
+    {
+        ++it;
+        if (!readDigits(it, end, 2, second) || second > 59)
+        {
+            return false;
+        }
+
+        if (it != end && *it == '.')
+        {
+            ++it;
+
+            const char* fractionBegin = it;
+            int scale = 100;
+            while (it != end && *it >= '0' && *it <= '9')
+            {
+                // Digits past milliseconds are truncated, matching absl::ToUnixMillis rounding towards -inf
+                milliseconds += (*it - '0') * scale;
+                scale /= 10;
+                ++it;
+            }
+
+            if (it == fractionBegin)
+            {
+                return false;
+            }
+        }
+    }
+
+    if (it == end)
+    {
+        if (hasSeconds)
+        {
+            // "%Y-%m-%d%ET%H:%M:%E*S" is the only local time shape of the list
+            auto time = absl::FromCivil(absl::CivilSecond(year, month, day, hour, minute, second), local);
+            result = static_cast<double>(absl::ToUnixMillis(time + absl::Milliseconds(milliseconds)));
+            return true;
+        }
+
+        // "%Y-%m-%dT%H:%M" wants the upper case separator
+        return separator == 'T' && fromUtc();
+    }
+
+    int offset = 0;
+    if (*it == 'Z' || *it == 'z')
+    {
+        ++it;
+    }
+    else if (*it == '+' || *it == '-')
+    {
+        const int sign = *it++ == '-' ? -1 : 1;
+
+        int offsetHours = 0;
+        int offsetMinutes = 0;
+        if (!readDigits(it, end, 2, offsetHours) || offsetHours > 23 || it == end || *it++ != ':' ||
+            !readDigits(it, end, 2, offsetMinutes) || offsetMinutes > 59)
+        {
+            return false;
+        }
+
+        offset = sign * (offsetHours * 60 + offsetMinutes) * 60;
+    }
+    else
+    {
+        return false;
+    }
+
+    if (it != end)
+    {
+        return false;
+    }
+
+    auto time = absl::FromCivil(absl::CivilSecond(year, month, day, hour, minute, second), absl::UTCTimeZone());
+    time -= absl::Seconds(offset);
+    result = static_cast<double>(absl::ToUnixMillis(time + absl::Milliseconds(milliseconds)));
+    return true;
+}
+
+} // namespace
 
 AbslDatePrivate::AbslDatePrivate()
 {
-    _time = absl::Now();
+    assign(absl::Now());
 }
 
 AbslDatePrivate::AbslDatePrivate(const std::string& date_string)
 {
     double parsed = parse(date_string);
-    _time = absl::FromUnixMillis(static_cast<long>(parsed));
+    assign(absl::FromUnixMillis(static_cast<long>(parsed)));
 
     if (std::isnan(parsed))
     {
@@ -30,20 +212,20 @@ AbslDatePrivate::AbslDatePrivate(
         year += 1900;
     }
 
-    _time = absl::FromDateTime(static_cast<int64_t>(year),
-                               static_cast<int>(month_index) + 1,
-                               static_cast<int>(day),
-                               static_cast<int>(hours),
-                               static_cast<int>(minutes),
-                               static_cast<int>(seconds),
-                               absl::LocalTimeZone());
+    auto time = absl::FromDateTime(static_cast<int64_t>(year),
+                                   static_cast<int>(month_index) + 1,
+                                   static_cast<int>(day),
+                                   static_cast<int>(hours),
+                                   static_cast<int>(minutes),
+                                   static_cast<int>(seconds),
+                                   localTimeZone());
 
-    _time += absl::FromChrono(std::chrono::milliseconds{static_cast<long>(milliseconds)});
+    assign(time + absl::FromChrono(std::chrono::milliseconds{static_cast<long>(milliseconds)}));
 }
 
 AbslDatePrivate::AbslDatePrivate(double since_epoch_milliseconds)
 {
-    _time = absl::FromUnixMillis(static_cast<long>(since_epoch_milliseconds));
+    assign(absl::FromUnixMillis(static_cast<long>(since_epoch_milliseconds)));
 
     if (std::isnan(since_epoch_milliseconds))
     {
@@ -53,24 +235,20 @@ AbslDatePrivate::AbslDatePrivate(double since_epoch_milliseconds)
 
 double AbslDatePrivate::parse(const std::string& date_string)
 {
+    double result = 0;
+    if (parseIsoDateTime(date_string, localTimeZone(), result))
+    {
+        return result;
+    }
+
     enum Repr
     {
         Local,
         Utc
     };
-    using format_t = std::pair<std::string, Repr>;
-
-    auto t = absl::Time{};
-    auto err = std::string{};
-
-    auto parse = [&t, &err, &date_string](const format_t& fmt) -> bool
-    {
-        if (fmt.second == Repr::Local)
-            return absl::ParseTime(fmt.first, date_string, absl::LocalTimeZone(), &t, &err);
-        return absl::ParseTime(fmt.first, date_string, absl::UTCTimeZone(), &t, &err);
-    };
+    using format_t = std::pair<const char*, Repr>;
 
-    static const std::vector<format_t> formats = {
+    static const format_t formats[] = {
         /*ISO 8601*/
         {"%Y", Repr::Utc},
         {"%Y-%m", Repr::Utc},
@@ -100,9 +278,14 @@ double AbslDatePrivate::parse(const std::string& date_string)
         /* RFC 2822 */
     };
 
+    const auto& local = localTimeZone();
+    const auto utc = absl::UTCTimeZone();
+
+    auto t = absl::Time{};
     for (const auto& fmt : formats)
     {
-        if (parse(fmt))
+        // Error details are of no use here, so let absl skip building them
+        if (absl::ParseTime(fmt.first, date_string, fmt.second == Repr::Local ? local : utc, &t, nullptr))
         {
             return static_cast<double>(absl::ToUnixMillis(t));
         }
@@ -145,7 +328,7 @@ double AbslDatePrivate::getDate() const noexcept
         return NaN;
     }
 
-    return static_cast<double>(absl::ToCivilDay(_time, absl::LocalTimeZone()).day());
+    return static_cast<double>(localInfo().cs.day());
 }
 
 double AbslDatePrivate::getDay() const noexcept
@@ -155,7 +338,7 @@ double AbslDatePrivate::getDay() const noexcept
         return NaN;
     }
 
-    auto weekday = absl::GetWeekday(ToCivilSecond(_time, absl::LocalTimeZone()));
+    auto weekday = absl::GetWeekday(localInfo().cs);
     return static_cast<double>(static_cast<int>(weekday) + 1);
 }
 
@@ -166,8 +349,7 @@ double AbslDatePrivate::getFullYear() const noexcept
         return NaN;
     }
 
-    auto year_instance = ToCivilYear(_time, absl::LocalTimeZone());
-    return static_cast<double>(year_instance.year());
+    return static_cast<double>(localInfo().cs.year());
 }
 
 double AbslDatePrivate::getHours() const noexcept
@@ -177,7 +359,7 @@ double AbslDatePrivate::getHours() const noexcept
         return NaN;
     }
 
-    return static_cast<double>(absl::ToCivilHour(_time, absl::LocalTimeZone()).hour());
+    return static_cast<double>(localInfo().cs.hour());
 }
 
 double AbslDatePrivate::getMilliseconds() const noexcept
@@ -198,7 +380,7 @@ double AbslDatePrivate::getMinutes() const noexcept
         return NaN;
     }
 
-    return static_cast<double>(absl::ToCivilMinute(_time, absl::LocalTimeZone()).minute());
+    return static_cast<double>(localInfo().cs.minute());
 }
 
 double AbslDatePrivate::getMonth() const noexcept
@@ -208,7 +390,7 @@ double AbslDatePrivate::getMonth() const noexcept
         return NaN;
     }
 
-    return static_cast<double>(absl::ToCivilMonth(_time, absl::LocalTimeZone()).month() - 1);
+    return static_cast<double>(localInfo().cs.month() - 1);
 }
 
 double AbslDatePrivate::getSeconds() const noexcept
@@ -219,7 +401,7 @@ double AbslDatePrivate::getSeconds() const noexcept
         return NaN;
     }
 
-    return static_cast<double>(absl::ToCivilSecond(_time, absl::LocalTimeZone()).second());
+    return static_cast<double>(localInfo().cs.second());
 }
 
 double AbslDatePrivate::getTime() const noexcept
@@ -239,8 +421,7 @@ double AbslDatePrivate::getTimezoneOffset() const noexcept
         return NaN;
     }
 
-    auto bd = _time.In(absl::LocalTimeZone());
-    return static_cast<double>(-bd.offset) / 60;
+    return static_cast<double>(-localInfo().offset) / 60;
 }
 
 double AbslDatePrivate::getUTCDate() const noexcept
@@ -250,7 +431,7 @@ double AbslDatePrivate::getUTCDate() const noexcept
         return NaN;
     }
 
-    return static_cast<double>(absl::ToCivilDay(_time, absl::UTCTimeZone()).day());
+    return static_cast<double>(utcInfo().cs.day());
 }
 
 double AbslDatePrivate::getUTCDay() const noexcept
@@ -260,7 +441,7 @@ double AbslDatePrivate::getUTCDay() const noexcept
         return NaN;
     }
 
-    auto weekday = absl::GetWeekday(ToCivilSecond(_time, absl::UTCTimeZone()));
+    auto weekday = absl::GetWeekday(utcInfo().cs);
     return static_cast<double>(static_cast<int>(weekday) + 1);
 }
 
@@ -271,8 +452,7 @@ double AbslDatePrivate::getUTCFullYear() const noexcept
         return NaN;
     }
 
-    auto year_instance = ToCivilYear(_time, absl::UTCTimeZone());
-    return static_cast<double>(year_instance.year());
+    return static_cast<double>(utcInfo().cs.year());
 }
 
 double AbslDatePrivate::getUTCHours() const noexcept
@@ -282,7 +462,7 @@ double AbslDatePrivate::getUTCHours() const noexcept
         return NaN;
     }
 
-    return getMilliseconds();
+    return static_cast<double>(utcInfo().cs.hour());
 }
 
 double AbslDatePrivate::getUTCMilliseconds() const noexcept
@@ -292,7 +472,7 @@ double AbslDatePrivate::getUTCMilliseconds() const noexcept
         return NaN;
     }
 
-    return static_cast<double>(absl::ToCivilHour(_time, absl::UTCTimeZone()).hour());
+    return getMilliseconds();
 }
 
 double AbslDatePrivate::getUTCMinutes() const noexcept
@@ -302,7 +482,7 @@ double AbslDatePrivate::getUTCMinutes() const noexcept
         return NaN;
     }
 
-    return static_cast<double>(absl::ToCivilMinute(_time, absl::UTCTimeZone()).minute());
+    return static_cast<double>(utcInfo().cs.minute());
 }
 
 double AbslDatePrivate::getUTCMonth() const noexcept
@@ -312,7 +492,7 @@ double AbslDatePrivate::getUTCMonth() const noexcept
         return NaN;
     }
 
-    return static_cast<double>(absl::ToCivilMonth(_time, absl::UTCTimeZone()).month() - 1);
+    return static_cast<double>(utcInfo().cs.month() - 1);
 }
 
 double AbslDatePrivate::getUTCSeconds() const noexcept
@@ -322,18 +502,18 @@ double AbslDatePrivate::getUTCSeconds() const noexcept
         return NaN;
     }
 
-    return static_cast<double>(absl::ToCivilSecond(_time, absl::UTCTimeZone()).second());
+    return static_cast<double>(utcInfo().cs.second());
 }
 // end getters
 
 // setters
 double AbslDatePrivate::setFullYear(double new_year, double new_month, double new_day)
 {
-    auto tm = absl::ToTM(_time, absl::LocalTimeZone());
+    auto tm = absl::ToTM(_time, localTimeZone());
     tm.tm_year = static_cast<int64_t>(new_year) >= 1900 ? static_cast<int>(new_year - 1900)
                                                         : static_cast<int>(-(1900 - new_year));
 
-    _time = absl::FromTM(tm, absl::LocalTimeZone());
+    assign(absl::FromTM(tm, localTimeZone()));
 
     if (new_month != NaN)
     {
@@ -345,10 +525,10 @@ double AbslDatePrivate::setFullYear(double new_year, double new_month, double ne
 
 double AbslDatePrivate::setMonth(double new_month, double new_day)
 {
-    auto tm = absl::ToTM(_time, absl::LocalTimeZone());
+    auto tm = absl::ToTM(_time, localTimeZone());
     tm.tm_mon = static_cast<int>(new_month) + 1;
 
-    _time = absl::FromTM(tm, absl::LocalTimeZone());
+    assign(absl::FromTM(tm, localTimeZone()));
 
     if (new_day != NaN)
     {
@@ -360,20 +540,20 @@ double AbslDatePrivate::setMonth(double new_month, double new_day)
 
 double AbslDatePrivate::setDate(double new_date)
 {
-    auto tm = absl::ToTM(_time, absl::LocalTimeZone());
+    auto tm = absl::ToTM(_time, localTimeZone());
     tm.tm_mday = static_cast<int>(new_date);
 
-    _time = absl::FromTM(tm, absl::LocalTimeZone());
+    assign(absl::FromTM(tm, localTimeZone()));
 
     return getTime();
 }
 
 double AbslDatePrivate::setHours(double new_hours, double new_minutes, double new_seconds, double new_milliseconds)
 {
-    auto tm = absl::ToTM(_time, absl::LocalTimeZone());
+    auto tm = absl::ToTM(_time, localTimeZone());
     tm.tm_hour = static_cast<int>(new_hours);
 
-    _time = absl::FromTM(tm, absl::LocalTimeZone());
+    assign(absl::FromTM(tm, localTimeZone()));
 
     if (new_minutes != NaN)
     {
@@ -385,10 +565,10 @@ double AbslDatePrivate::setHours(double new_hours, double new_minutes, double ne
 
 double AbslDatePrivate::setMinutes(double new_minutes, double new_seconds, double new_milliseconds)
 {
-    auto tm = absl::ToTM(_time, absl::LocalTimeZone());
+    auto tm = absl::ToTM(_time, localTimeZone());
     tm.tm_min = static_cast<int>(new_minutes);
 
-    _time = absl::FromTM(tm, absl::LocalTimeZone());
+    assign(absl::FromTM(tm, localTimeZone()));
 
     if (new_seconds != NaN)
     {
@@ -400,10 +580,10 @@ double AbslDatePrivate::setMinutes(double new_minutes, double new_seconds, doubl
 
 double AbslDatePrivate::setSeconds(double new_seconds, double new_milliseconds)
 {
-    auto tm = absl::ToTM(_time, absl::LocalTimeZone());
+    auto tm = absl::ToTM(_time, localTimeZone());
     tm.tm_sec = static_cast<int>(new_seconds);
 
-    _time = absl::FromTM(tm, absl::LocalTimeZone());
+    assign(absl::FromTM(tm, localTimeZone()));
 
     if (new_milliseconds != NaN)
     {
@@ -415,16 +595,16 @@ double AbslDatePrivate::setSeconds(double new_seconds, double new_milliseconds)
 
 double AbslDatePrivate::setMilliseconds(double new_milliseconds)
 {
-    _time -= absl::FromChrono(std::chrono::milliseconds{static_cast<long>(getMilliseconds())});
-    _time += absl::FromChrono(std::chrono::milliseconds{static_cast<long>(new_milliseconds)});
+    auto time = _time - absl::FromChrono(std::chrono::milliseconds{static_cast<long>(getMilliseconds())});
+    assign(time + absl::FromChrono(std::chrono::milliseconds{static_cast<long>(new_milliseconds)}));
 
     return getTime();
 }
 
 double AbslDatePrivate::setTime(double milliseconds_epoch_time)
 {
-    _time -= absl::FromChrono(std::chrono::milliseconds{static_cast<long>(getTime())});
-    _time += absl::FromChrono(std::chrono::milliseconds{static_cast<long>(milliseconds_epoch_time)});
+    auto time = _time - absl::FromChrono(std::chrono::milliseconds{static_cast<long>(getTime())});
+    assign(time + absl::FromChrono(std::chrono::milliseconds{static_cast<long>(milliseconds_epoch_time)}));
 
     return getTime();
 }
@@ -435,7 +615,7 @@ double AbslDatePrivate::setUTCFullYear(double new_utc_year, double new_utc_month
     tm.tm_year = static_cast<int64_t>(new_utc_year) >= 1900 ? static_cast<int>(new_utc_year - 1900)
                                                             : static_cast<int>(-(1900 - new_utc_year));
 
-    _time = absl::FromTM(tm, absl::UTCTimeZone());
+    assign(absl::FromTM(tm, absl::UTCTimeZone()));
 
     if (new_utc_month != NaN)
     {
@@ -450,7 +630,7 @@ double AbslDatePrivate::setUTCMonth(double new_utc_month, double new_utc_day)
     auto tm = absl::ToTM(_time, absl::UTCTimeZone());
     tm.tm_mon = static_cast<int>(new_utc_month);
 
-    _time = absl::FromTM(tm, absl::UTCTimeZone());
+    assign(absl::FromTM(tm, absl::UTCTimeZone()));
 
     if (new_utc_day != NaN)
     {
@@ -465,7 +645,7 @@ double AbslDatePrivate::setUTCDate(double new_utc_date)
     auto tm = absl::ToTM(_time, absl::UTCTimeZone());
     tm.tm_mday = static_cast<int>(new_utc_date);
 
-    _time = absl::FromTM(tm, absl::UTCTimeZone());
+    assign(absl::FromTM(tm, absl::UTCTimeZone()));
 
     return getTime();
 }
@@ -478,7 +658,7 @@ double AbslDatePrivate::setUTCHours(double new_utc_hours,
     auto tm = absl::ToTM(_time, absl::UTCTimeZone());
     tm.tm_hour = static_cast<int>(new_utc_hours);
 
-    _time = absl::FromTM(tm, absl::UTCTimeZone());
+    assign(absl::FromTM(tm, absl::UTCTimeZone()));
 
     if (new_utc_minutes != NaN)
     {
@@ -493,7 +673,7 @@ double AbslDatePrivate::setUTCMinutes(double new_utc_minutes, double new_utc_sec
     auto tm = absl::ToTM(_time, absl::UTCTimeZone());
     tm.tm_min = static_cast<int>(new_utc_minutes);
 
-    _time = absl::FromTM(tm, absl::UTCTimeZone());
+    assign(absl::FromTM(tm, absl::UTCTimeZone()));
 
     if (new_utc_seconds != NaN)
     {
@@ -508,7 +688,7 @@ double AbslDatePrivate::setUTCSeconds(double new_utc_seconds, double new_utc_mil
     auto tm = absl::ToTM(_time, absl::UTCTimeZone());
     tm.tm_sec = static_cast<int>(new_utc_seconds);
 
-    _time = absl::FromTM(tm, absl::UTCTimeZone());
+    assign(absl::FromTM(tm, absl::UTCTimeZone()));
 
     if (new_utc_milliseconds != NaN)
     {
@@ -527,13 +707,13 @@ double AbslDatePrivate::setUTCMilliseconds(double new_utc_milliseconds)
 std::string AbslDatePrivate::toString() const noexcept
 {
     constexpr auto fmt = "%a %b %d %4Y %H:%M:%S GMT%z (%Z)";
-    return isValid() ? FormatTime(fmt, _time, absl::LocalTimeZone()) : "Invalid Date";
+    return isValid() ? FormatTime(fmt, _time, localTimeZone()) : "Invalid Date";
 }
 
 std::string AbslDatePrivate::toDateString() const noexcept
 {
     constexpr auto fmt = "%a %b %d %Y";
-    return isValid() ? FormatTime(fmt, _time, absl::LocalTimeZone()) : "Invalid Date";
+    return isValid() ? FormatTime(fmt, _time, localTimeZone()) : "Invalid Date";
 }
 
 std::string AbslDatePrivate::toUTCString() const noexcept
@@ -556,10 +736,45 @@ std::string AbslDatePrivate::toJSON() const noexcept
 std::string AbslDatePrivate::toTimeString() const noexcept
 {
     constexpr auto fmt = "%H:%M:%S GMT%z (%Z)";
-    return isValid() ? FormatTime(fmt, _time, absl::LocalTimeZone()) : "Invalid Date";
+    return isValid() ? FormatTime(fmt, _time, localTimeZone()) : "Invalid Date";
 }
 
 double AbslDatePrivate::valueOf() const noexcept
 {
     return getTime();
 }
+
+void AbslDatePrivate::assign(absl::Time time) noexcept
+{
+    _time = time;
+    _hasLocalInfo = false;
+    _hasUtcInfo = false;
+}
+
+const absl::TimeZone::CivilInfo& AbslDatePrivate::localInfo() const noexcept
+{
+    if (!_hasLocalInfo)
+    {
+        _localInfo = localTimeZone().At(_time);
+        _hasLocalInfo = true;
+    }
+
+    return _localInfo;
+}
+
+const absl::TimeZone::CivilInfo& AbslDatePrivate::utcInfo() const noexcept
+{
+    if (!_hasUtcInfo)
+    {
+        _utcInfo = absl::UTCTimeZone().At(_time);
+        _hasUtcInfo = true;
+    }
+
+    return _utcInfo;
+}
+
+const absl::TimeZone& AbslDatePrivate::localTimeZone() noexcept
+{
+    static const absl::TimeZone tz = absl::LocalTimeZone();
+    return tz;
+}
@@ -74,6 +74,21 @@ public:
 
     double valueOf() const noexcept override;
 
+private:
+    void assign(absl::Time time) noexcept;
+
+    const absl::TimeZone::CivilInfo& localInfo() const noexcept;
+    const absl::TimeZone::CivilInfo& utcInfo() const noexcept;
+
+    // Local time zone resolved once per process: absl::LocalTimeZone() does a locked lookup on every call
+    static const absl::TimeZone& localTimeZone() noexcept;
+
 private:
     absl::Time _time;
+
+    // Broken down fields of _time, computed on first access and dropped by assign()
+    mutable absl::TimeZone::CivilInfo _localInfo;
+    mutable absl::TimeZone::CivilInfo _utcInfo;
+    mutable bool _hasLocalInfo = false;
+    mutable bool _hasUtcInfo = false;
 };
@@ -1,7 +1,7 @@
 #include "std/private/tsnumber_cxx_builtin_p.h"
+#include "std/private/number_formatter.h"
 
 #include <cmath>
-#include <sstream>
 #include <string>
 
 NumberCXXBuiltinPrivate::NumberCXXBuiltinPrivate(double v)
@@ -177,22 +177,7 @@ double NumberCXXBuiltinPrivate::unboxed() const
 
 std::string NumberCXXBuiltinPrivate::toString() const
 {
-    std::ostringstream oss;
-
-    const double unboxedValue = this->unboxed();
-    if (NumberPrivate::isNaN(unboxedValue))
-    {
-        oss << "NaN";
-    }
-    else if (!NumberPrivate::isFinite(unboxedValue))
-    {
-        oss << (NumberPrivate::POSITIVE_INFINITY() == unboxedValue ? "Infinity" : "-Infinity");
-    }
-    else
-    {
-        oss << this->unboxed();
-    }
-    return oss.str();
+    return NumberFormatter::toString(_value);
 }
 
 bool NumberCXXBuiltinPrivate::operator==(const NumberPrivate& other) const noexcept
@@ -8,6 +8,11 @@ StdStringBackend::StdStringBackend(const std::string& s)
 {
 }
 
+StdStringBackend::StdStringBackend(std::string&& s)
+    : _string(std::move(s))
+{
+}
+
 int StdStringBackend::length() const
 {
     return static_cast<int>(_string.size());
@@ -4,6 +4,7 @@
 #include "std/tsarray.h"
 #include "std/tsstring.h"
 
+#include "std/private/console_writer.h"
 #include "std/private/default_executor.h"
 #include "std/private/logger.h"
 #include "std/private/memory_management/mem_manager_creator.h"
@@ -24,6 +25,9 @@ TimerStorage Runtime::_timers{};
 
 namespace
 {
+// Console flush policy, see ConsoleWriter::parseOptions for the format
+constexpr const char g_ConsoleFlushEnvVariable[] = "TSNATIVE_CONSOLE_FLUSH";
+
 void exitHandler()
 {
     Runtime::destroy();
@@ -92,6 +96,18 @@ void Runtime::initLoop(IEventLoop* customEventLoop)
     }
 }
 
+void Runtime::initConsole()
+{
+    auto& console = ConsoleWriter::instance();
+
+    if (const char* spec = std::getenv(g_ConsoleFlushEnvVariable))
+    {
+        console.setOptions(ConsoleWriter::parseOptions(spec));
+    }
+
+    console.attachLoop(_loop.get());
+}
+
 void Runtime::initTimerCreator(ITimerCreator* customTimerCreator)
 {
     if (customTimerCreator)
@@ -152,6 +168,7 @@ int Runtime::init(int ac, char* av[], IEventLoop* customEventLoop, ITimerCreator
     initLoop(customEventLoop);
     initTimerCreator(customTimerCreator);
     initCmdArgs(ac, av);
+    initConsole();
 
     _memoryManager = createMemoryManager(_timers, _loop.get());
 
@@ -197,6 +214,7 @@ void Runtime::destroy()
     LOG_INFO("Calling destroy");
 
     _cmdArgs.clear();
+    ConsoleWriter::instance().attachLoop(nullptr);
     _timerCreator = nullptr;
     _loop = nullptr;
     _memoryManager = nullptr;
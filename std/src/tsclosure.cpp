@@ -5,13 +5,25 @@
 
 #include "std/private/logger.h"
 
-TSClosure::TSClosure(void* fn, void*** env, Number* envLength, Number* numArgs, Number* optionals)
+TSClosure::TSClosure(void* fn, void*** env, Number* envLength, Number* numArgs)
     : Object(TSTypeID::Closure)
-    , _fn{reinterpret_cast<void* (*)(void***)>(fn)}
+    , _fn{reinterpret_cast<Function>(fn)}
     , _env(env)
     , _envLength(envLength->unboxed())
     , _numArgs(numArgs->unboxed())
-    , _optionals(optionals->unboxed())
+    , _ownsEnvironment{false}
+{
+    LOG_METHOD_CALL;
+    LOG_ADDRESS("Calling closure ctor ", this);
+}
+
+TSClosure::TSClosure(void* fn, Number* envLength, Number* numArgs)
+    : Object(TSTypeID::Closure)
+    , _fn{reinterpret_cast<Function>(fn)}
+    , _env(inlineEnvironment())
+    , _envLength(envLength->unboxed())
+    , _numArgs(numArgs->unboxed())
+    , _ownsEnvironment{false}
 {
     LOG_METHOD_CALL;
     LOG_ADDRESS("Calling closure ctor ", this);
@@ -19,11 +31,10 @@ TSClosure::TSClosure(void* fn, void*** env, Number* envLength, Number* numArgs,
 
 TSClosure::TSClosure(FunctionToCall&& fn, void*** env, std::uint32_t envLength, std::uint32_t numArgs)
     : Object(TSTypeID::Closure)
-    , _fn{std::move(fn)}
+    , _lambda{std::make_unique<FunctionToCall>(std::move(fn))}
     , _env{env}
     , _envLength{envLength}
     , _numArgs{numArgs}
-    , _optionals{0}
 {
     LOG_METHOD_CALL;
     LOG_ADDRESS("Calling closure ctor ", this);
@@ -32,8 +43,20 @@ TSClosure::TSClosure(FunctionToCall&& fn, void*** env, std::uint32_t envLength,
 TSClosure::~TSClosure()
 {
     LOG_ADDRESS("Calling closure dtor ", this);
-    LOG_ADDRESS("Freeing env ", _env);
-    free(_env);
+
+    if (_ownsEnvironment)
+    {
+        LOG_ADDRESS("Freeing env ", _env);
+        free(_env);
+    }
+}
+
+void*** TSClosure::inlineEnvironment()
+{
+    // Compiler allocates { TSClosure, environment } as a single object,
+    // the environment starts right at the end of the closure
+    static_assert(sizeof(TSClosure) % sizeof(void**) == 0, "Environment expected to follow the closure unpadded");
+    return reinterpret_cast<void***>(reinterpret_cast<char*>(this) + sizeof(TSClosure));
 }
 
 void*** TSClosure::getEnvironment() const
@@ -53,7 +76,12 @@ std::uint32_t TSClosure::getEnvironmentLength() const
 
 void* TSClosure::call() const
 {
-    return _fn(_env);
+    if (_fn)
+    {
+        return _fn(_env);
+    }
+
+    return (*_lambda)(_env);
 }
 
 String* TSClosure::toString() const
@@ -66,6 +94,8 @@ std::vector<Object*> TSClosure::getChildObjects() const
     auto result = Object::getChildObjects();
 
     const auto envLength = _envLength;
+    result.reserve(result.size() + envLength);
+
     for (std::size_t i = 0; i < envLength; ++i)
     {
         auto voidStarStar = _env[i];
@@ -77,4 +107,4 @@ std::vector<Object*> TSClosure::getChildObjects() const
     }
 
     return result;
-}
\ No newline at end of file
+}
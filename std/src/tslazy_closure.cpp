@@ -13,9 +13,8 @@ TSLazyClosure::TSLazyClosure(Enviroment env)
 
 TSLazyClosure::~TSLazyClosure()
 {
+    // environment is gc traced raw memory, it is reclaimed by gc
     LOG_ADDRESS("Calling lazy closure dtor ", this);
-    LOG_ADDRESS("Freeing env ", _env);
-    free(_env);
 }
 
 TSLazyClosure::Enviroment TSLazyClosure::getEnvironment()
@@ -10,11 +10,12 @@
 #endif
 
 #include "std/private/logger.h"
+#include "std/private/number_formatter.h"
 #include "std/private/number_parser.h"
 #include "std/private/tsnumber_p.h"
 
 #include <algorithm>
-#include <iomanip>
+#include <cstdint>
 #include <limits>
 
 String::String()
@@ -29,11 +30,8 @@ String::String()
 String::String(Number* d)
     : Iterable<String*>(TSTypeID::String)
 {
-    std::ostringstream oss;
-    oss << std::setprecision(std::numeric_limits<double>::max_digits10) << std::noshowpoint << d->unboxed();
-
 #ifdef USE_STD_STRING_BACKEND
-    this->_d = new StdStringBackend(oss.str());
+    this->_d = new StdStringBackend(NumberFormatter::toString(d->unboxed()));
 #endif
 
     LOG_INFO("Calling string ctor from number " + std::to_string(d->unboxed()));
@@ -50,6 +48,15 @@ String::String(const std::string& s)
     LOG_ADDRESS("This address: ", this);
 }
 
+String::String(std::string&& s)
+    : Iterable<String*>(TSTypeID::String)
+#ifdef USE_STD_STRING_BACKEND
+    , _d(new StdStringBackend(std::move(s)))
+#endif
+{
+    LOG_ADDRESS("Calling string ctor from string&& ", this);
+}
+
 String::String(const char* s)
     : Iterable<String*>(TSTypeID::String)
 #ifdef USE_STD_STRING_BACKEND
@@ -78,8 +85,30 @@ Number* String::length() const
 
 String* String::concat(String* other) const
 {
-    std::string concatenated = _d->concat(other->cpp_str());
-    return new String(concatenated);
+    return new String(_d->concat(other->cpp_str()));
+}
+
+String* String::concatAll(void** others, double othersCount) const
+{
+    const auto count = static_cast<std::size_t>(othersCount);
+    const auto& head = cpp_str();
+
+    std::size_t totalLength = head.size();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        totalLength += static_cast<const String*>(others[i])->cpp_str().size();
+    }
+
+    std::string result;
+    result.reserve(totalLength);
+    result += head;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        result += static_cast<const String*>(others[i])->cpp_str();
+    }
+
+    return new String(std::move(result));
 }
 
 Boolean* String::startsWith(String* other, Union* maybeStartIndex) const
@@ -307,8 +336,7 @@ Array<String*>* String::getKeysArray() const
     auto result = new Array<String*>();
     for (std::size_t i = 0; i < length()->unboxed(); ++i)
     {
-        auto n = new Number(i);
-        result->push(n->toString());
+        result->push(new String(NumberFormatter::toString(static_cast<double>(i))));
     }
 
     return result;
@@ -331,6 +359,19 @@ TS_METHOD Number* String::negate() const
     return new Number{-parsed};
 }
 
+TS_METHOD Number* String::hash() const
+{
+    uint32_t result = 2166136261u;
+
+    for (const unsigned char c : cpp_str())
+    {
+        result ^= c;
+        result *= 16777619u;
+    }
+
+    return new Number(static_cast<double>(result));
+}
+
 bool String::operator<(const String& other) const noexcept
 {
     return this->toString()->cpp_str() < other.toString()->cpp_str();
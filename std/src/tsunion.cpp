@@ -30,6 +30,26 @@ void Union::setValue(Object* value)
     _value = value;
 }
 
+Object* Union::unwrap(Object* value)
+{
+    while (value->isUnion())
+    {
+        value = static_cast<Union*>(value)->_value;
+    }
+
+    return value;
+}
+
+Union* Union::wrap(Object* value)
+{
+    if (value->isUnion())
+    {
+        return static_cast<Union*>(value);
+    }
+
+    return new Union(value);
+}
+
 bool Union::hasValue()
 {
     return _value && !_value->isNull() && !_value->isUndefined();
@@ -0,0 +1,121 @@
+#include "../infrastructure/array_fixture.h"
+
+#include "std/make_closure_from_lambda.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+TEST_F(ArrayFixture, filter)
+{
+    auto numbers = getFilledNumberArray();
+
+    auto predicate = makeClosure<test::Closure>([](test::Number** n)
+                                                { return new test::Boolean((*n)->unboxed() > 15); });
+
+    auto* filtered = numbers->filter(predicate);
+
+    const auto left = Serializer<int, ::Array>::toVector(filtered);
+    EXPECT_THAT(left, ::testing::ElementsAreArray({20, 30, 40}));
+    EXPECT_THAT(IntArray::toVector(numbers), ::testing::ElementsAreArray({10, 20, 30, 40}));
+}
+
+TEST_F(ArrayFixture, filterWithIndex)
+{
+    auto numbers = getFilledNumberArray();
+
+    auto predicate = makeClosure<test::Closure>(
+        [](test::Number**, test::Number** i)
+        { return new test::Boolean(static_cast<int>((*i)->unboxed()) % 2 == 0); });
+
+    auto* filtered = numbers->filter(predicate);
+
+    const auto left = Serializer<int, ::Array>::toVector(filtered);
+    EXPECT_THAT(left, ::testing::ElementsAreArray({10, 30}));
+}
+
+TEST_F(ArrayFixture, someEvery)
+{
+    auto numbers = getFilledNumberArray();
+
+    std::size_t calls = 0;
+    auto greaterThan15 = makeClosure<test::Closure>(
+        [&calls](test::Number** n)
+        {
+            ++calls;
+            return new test::Boolean((*n)->unboxed() > 15);
+        });
+
+    EXPECT_TRUE(numbers->some(greaterThan15)->unboxed());
+    EXPECT_EQ(calls, 2u);
+
+    calls = 0;
+    EXPECT_FALSE(numbers->every(greaterThan15)->unboxed());
+    EXPECT_EQ(calls, 1u);
+
+    auto positive = makeClosure<test::Closure>([](test::Number** n) { return new test::Boolean((*n)->unboxed() > 0); });
+
+    EXPECT_TRUE(numbers->every(positive)->unboxed());
+    EXPECT_TRUE(getEmptyNumberArray()->every(positive)->unboxed());
+    EXPECT_FALSE(getEmptyNumberArray()->some(positive)->unboxed());
+}
+
+TEST_F(ArrayFixture, find)
+{
+    auto numbers = getFilledNumberArray();
+
+    auto equals30 = makeClosure<test::Closure>([](test::Number** n)
+                                               { return new test::Boolean((*n)->unboxed() == 30); });
+
+    auto* found = numbers->find(equals30);
+    ASSERT_FALSE(found->isUndefined());
+    EXPECT_EQ(static_cast<test::Number*>(found)->unboxed(), 30);
+
+    auto equals50 = makeClosure<test::Closure>([](test::Number** n)
+                                               { return new test::Boolean((*n)->unboxed() == 50); });
+
+    EXPECT_TRUE(numbers->find(equals50)->isUndefined());
+}
+
+TEST_F(ArrayFixture, truthyPredicateResult)
+{
+    auto numbers = getFilledNumberArray();
+
+    // Non-boolean results are tested for truthiness: 0 is falsy
+    auto modulo20 = makeClosure<test::Closure>([](test::Number** n)
+                                               { return new test::Number(static_cast<int>((*n)->unboxed()) % 20); });
+
+    auto* filtered = numbers->filter(modulo20);
+
+    const auto left = Serializer<int, ::Array>::toVector(filtered);
+    EXPECT_THAT(left, ::testing::ElementsAreArray({10, 30}));
+}
+
+TEST_F(ArrayFixture, reduce)
+{
+    auto numbers = getFilledNumberArray();
+
+    auto sum = makeClosure<test::Closure>([](test::Number** acc, test::Number** n)
+                                          { return new test::Number((*acc)->unboxed() + (*n)->unboxed()); });
+
+    auto* result = numbers->reduce<test::Number*>(sum, new test::Number(5));
+    EXPECT_EQ(result->unboxed(), 105);
+
+    auto* initial = new test::Number(7);
+    EXPECT_EQ(getEmptyNumberArray()->reduce<test::Number*>(sum, initial), initial);
+}
+
+TEST_F(ArrayFixture, reduceWithIndex)
+{
+    auto numbers = getFilledNumberArray();
+
+    auto weightedSum = makeClosure<test::Closure>(
+        [](test::Number** acc, test::Number** n, test::Number** i)
+        { return new test::Number((*acc)->unboxed() + (*n)->unboxed() * (*i)->unboxed()); });
+
+    auto* result = numbers->reduce<test::Number*>(weightedSum, new test::Number(0.0));
+    EXPECT_EQ(result->unboxed(), 200);
+}
+
+} // namespace
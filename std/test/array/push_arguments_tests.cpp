@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include "std/tsarray.h"
+#include "std/tsnumber.h"
+#include "std/tstuple.h"
+
+#include <array>
+
+TEST(PushArgumentsFixture, NoArguments)
+{
+    Array<Object*> aggregator;
+    aggregator.pushArguments(nullptr, 0, nullptr);
+
+    EXPECT_EQ(*(aggregator.length()), 0.0);
+}
+
+TEST(PushArgumentsFixture, NonSpreadObjects)
+{
+    Array<Object*> aggregator;
+
+    Object obj1;
+    Object obj2;
+    std::array<void*, 2> args{&obj1, &obj2};
+    aggregator.pushArguments(args.data(), args.size(), nullptr);
+
+    const std::size_t zero = 0u;
+    const std::size_t one = 1u;
+
+    EXPECT_EQ(*(aggregator.length()), 2.0);
+    EXPECT_TRUE(aggregator[zero]->equals(&obj1)->unboxed());
+    EXPECT_TRUE(aggregator[one]->equals(&obj2)->unboxed());
+}
+
+TEST(PushArgumentsFixture, SpreadArray)
+{
+    Array<Object*> aggregator;
+
+    Array<Object*> arr;
+    Object obj1;
+    Object obj2;
+    Object obj3;
+    arr.push(&obj1);
+    arr.push(&obj2);
+    arr.push(&obj3);
+
+    std::array<void*, 1> args{&arr};
+    std::array<bool, 1> spreads{true};
+    aggregator.pushArguments(args.data(), args.size(), spreads.data());
+
+    const std::size_t zero = 0u;
+    const std::size_t one = 1u;
+    const std::size_t two = 2u;
+
+    EXPECT_EQ(*(aggregator.length()), 3.0);
+    EXPECT_TRUE(aggregator[zero]->equals(&obj1)->unboxed());
+    EXPECT_TRUE(aggregator[one]->equals(&obj2)->unboxed());
+    EXPECT_TRUE(aggregator[two]->equals(&obj3)->unboxed());
+}
+
+TEST(PushArgumentsFixture, SpreadTuple)
+{
+    Array<Object*> aggregator;
+
+    Tuple tpl;
+    Object obj1;
+    Object obj2;
+    tpl.push(&obj1);
+    tpl.push(&obj2);
+
+    std::array<void*, 1> args{&tpl};
+    std::array<bool, 1> spreads{true};
+    aggregator.pushArguments(args.data(), args.size(), spreads.data());
+
+    const std::size_t zero = 0u;
+    const std::size_t one = 1u;
+
+    EXPECT_EQ(*(aggregator.length()), 2.0);
+    EXPECT_TRUE(aggregator[zero]->equals(&obj1)->unboxed());
+    EXPECT_TRUE(aggregator[one]->equals(&obj2)->unboxed());
+}
+
+TEST(PushArgumentsFixture, SpreadsBetweenObjectsKeepOrder)
+{
+    Array<Object*> aggregator;
+
+    Array<Object*> arr;
+    Object obj1;
+    Object obj2;
+    Object obj3;
+    arr.push(&obj2);
+
+    // (obj1, ...arr, obj3, ...arr)
+    std::array<void*, 4> args{&obj1, &arr, &obj3, &arr};
+    std::array<bool, 4> spreads{false, true, false, true};
+    aggregator.pushArguments(args.data(), args.size(), spreads.data());
+
+    const auto elements = aggregator.toStdVector();
+    EXPECT_EQ(elements, (std::vector<Object*>{&obj1, &obj2, &obj3, &obj2}));
+}
+
+TEST(PushArgumentsFixture, MultidimensionalArray)
+{
+    Array<Object*> aggregator;
+
+    Array<Object*> arr;
+    Object obj;
+    arr.push(&obj);
+
+    std::array<void*, 1> args{&arr};
+    std::array<bool, 1> spreads{false};
+    aggregator.pushArguments(args.data(), args.size(), spreads.data());
+
+    const std::size_t zero = 0u;
+
+    EXPECT_EQ(*(aggregator.length()), 1.0);
+    EXPECT_TRUE(aggregator[zero]->equals(&arr)->unboxed());
+}
+
+TEST(PushArgumentsFixture, SpreadItself)
+{
+    Array<Object*> arr;
+    Object obj1;
+    Object obj2;
+    arr.push(&obj1);
+    arr.push(&obj2);
+
+    std::array<void*, 1> args{&arr};
+    std::array<bool, 1> spreads{true};
+    arr.pushArguments(args.data(), args.size(), spreads.data());
+
+    const auto elements = arr.toStdVector();
+    EXPECT_EQ(elements, (std::vector<Object*>{&obj1, &obj2, &obj1, &obj2}));
+}
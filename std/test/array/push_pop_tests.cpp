@@ -28,7 +28,7 @@ TEST_F(ArrayFixture, pop)
     EXPECT_THAT(left1, ::testing::ElementsAreArray({10, 20, 30, 40}));
 
     auto* popedValue = numbers->pop();
-    EXPECT_FLOAT_EQ(popedValue->getValue<test::Number*>()->unboxed(), 40.);
+    EXPECT_FLOAT_EQ(static_cast<test::Number*>(popedValue)->unboxed(), 40.);
 
     numbers->push(new test::Number(50));
 
@@ -36,16 +36,16 @@ TEST_F(ArrayFixture, pop)
     EXPECT_THAT(left2, ::testing::ElementsAreArray({10, 20, 30, 50}));
 
     popedValue = numbers->pop();
-    EXPECT_FLOAT_EQ(popedValue->getValue<test::Number*>()->unboxed(), 50.);
+    EXPECT_FLOAT_EQ(static_cast<test::Number*>(popedValue)->unboxed(), 50.);
 
     popedValue = numbers->pop();
-    EXPECT_FLOAT_EQ(popedValue->getValue<test::Number*>()->unboxed(), 30.);
+    EXPECT_FLOAT_EQ(static_cast<test::Number*>(popedValue)->unboxed(), 30.);
 
     popedValue = numbers->pop();
-    EXPECT_FLOAT_EQ(popedValue->getValue<test::Number*>()->unboxed(), 20.);
+    EXPECT_FLOAT_EQ(static_cast<test::Number*>(popedValue)->unboxed(), 20.);
 
     popedValue = numbers->pop();
-    EXPECT_FLOAT_EQ(popedValue->getValue<test::Number*>()->unboxed(), 10.);
+    EXPECT_FLOAT_EQ(static_cast<test::Number*>(popedValue)->unboxed(), 10.);
 
     EXPECT_FLOAT_EQ(numbers->length()->unboxed(), 0.);
 }
@@ -55,7 +55,7 @@ TEST_F(ArrayFixture, pop_empty)
     auto numbers = new test::Array<test::Number*>();
 
     auto* popedValue = numbers->pop();
-    EXPECT_FALSE(static_cast<Union*>(popedValue)->hasValue());
+    EXPECT_TRUE(popedValue->isUndefined());
 }
 
 } // namespace
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include "../infrastructure/object_wrappers.h"
+
+#include <absl/time/time.h>
+
+#include <cmath>
+
+namespace
+{
+class DateTest : public test::GlobalTestAllocatorFixture
+{
+public:
+    double parse(const std::string& str) const
+    {
+        return ::Date::parse(new test::String(str))->unboxed();
+    }
+
+    double localMillis(int year, int month, int day, int hour, int minute, int second, int ms) const
+    {
+        auto time = absl::FromCivil(absl::CivilSecond(year, month, day, hour, minute, second), absl::LocalTimeZone());
+        return static_cast<double>(absl::ToUnixMillis(time + absl::Milliseconds(ms)));
+    }
+};
+} // namespace
+
+TEST_F(DateTest, ParseIsoUtc)
+{
+    EXPECT_EQ(parse("2021"), 1609459200000.0);
+    EXPECT_EQ(parse("2021-03"), 1614556800000.0);
+    EXPECT_EQ(parse("2021-03-04"), 1614816000000.0);
+    EXPECT_EQ(parse("2021-03-04T05:06"), 1614834360000.0);
+    EXPECT_EQ(parse("1995-12-17T00:24:00.035Z"), 819159840035.0);
+    EXPECT_EQ(parse("1995-12-17T00:24:00Z"), 819159840000.0);
+    EXPECT_EQ(parse("1995-12-17t00:24:00.0359999z"), 819159840035.0);
+    EXPECT_EQ(parse("1969-12-31T23:59:59.999Z"), -1.0);
+    EXPECT_EQ(parse("2024-02-29T00:00Z"), 1709164800000.0);
+}
+
+TEST_F(DateTest, ParseIsoWithOffset)
+{
+    EXPECT_EQ(parse("1995-12-17T03:24:00+03:00"), 819159840000.0);
+    EXPECT_EQ(parse("1995-12-16T21:24:00.035-03:00"), 819159840035.0);
+    EXPECT_EQ(parse("1995-12-17T05:54+05:30"), 819159840000.0);
+}
+
+TEST_F(DateTest, ParseIsoLocal)
+{
+    EXPECT_EQ(parse("1995-12-17T04:24:00"), localMillis(1995, 12, 17, 4, 24, 0, 0));
+    EXPECT_EQ(parse("1995-12-17t04:24:00.5"), localMillis(1995, 12, 17, 4, 24, 0, 500));
+}
+
+TEST_F(DateTest, ParseFallsBackToFormatList)
+{
+    // Not the ISO shapes: handled by absl::ParseTime
+    EXPECT_EQ(parse(" 2021-03-04"), 1614816000000.0);
+    EXPECT_EQ(parse("2021-3-4"), 1614816000000.0);
+    EXPECT_EQ(parse("1995-12-17T00:24:00+0300"), 819149040000.0);
+    EXPECT_EQ(parse("Mon, 04 Mar 2021 00:00:00 GMT"), 1614816000000.0);
+    EXPECT_EQ(parse("December 17, 1995 03:24:00"), localMillis(1995, 12, 17, 3, 24, 0, 0));
+}
+
+TEST_F(DateTest, ParseInvalid)
+{
+    EXPECT_TRUE(std::isnan(parse("")));
+    EXPECT_TRUE(std::isnan(parse("2021-01-01 GG WP")));
+    EXPECT_TRUE(std::isnan(parse("2021-02-29")));
+    EXPECT_TRUE(std::isnan(parse("2021-13-01")));
+    EXPECT_TRUE(std::isnan(parse("2021-01-01T24:00")));
+    EXPECT_TRUE(std::isnan(parse("2021-01-01t10:00")));
+    EXPECT_TRUE(std::isnan(parse("2021-01-01T10:00:00.")));
+}
+
+TEST_F(DateTest, GettersFollowSetters)
+{
+    auto* date = new test::Date(new test::String("1995-12-17T03:24:00.035Z"));
+
+    EXPECT_EQ(date->getUTCFullYear()->unboxed(), 1995);
+    EXPECT_EQ(date->getUTCMonth()->unboxed(), 11);
+    EXPECT_EQ(date->getUTCDate()->unboxed(), 17);
+    EXPECT_EQ(date->getUTCHours()->unboxed(), 3);
+    EXPECT_EQ(date->getUTCMinutes()->unboxed(), 24);
+    EXPECT_EQ(date->getUTCSeconds()->unboxed(), 0);
+    EXPECT_EQ(date->getUTCMilliseconds()->unboxed(), 35);
+
+    date->setDate(new test::Number(4.0));
+    EXPECT_EQ(date->getDate()->unboxed(), 4);
+
+    date->setTime(new test::Number(0.0));
+    EXPECT_EQ(date->getUTCFullYear()->unboxed(), 1970);
+    EXPECT_EQ(date->getUTCHours()->unboxed(), 0);
+    EXPECT_EQ(date->getFullYear()->unboxed(),
+              static_cast<double>(absl::ToCivilYear(absl::UnixEpoch(), absl::LocalTimeZone()).year()));
+}
@@ -170,10 +170,9 @@ TEST_F(MarkingTestFixture, closure)
 
     auto* numArgs = new test::Number(0.f);   // should be marked
     auto* envLength = new test::Number(2.f); // should be marked
-    ::Number optionals(0.f);                 // should NOT be marked
 
     void* closureBodyVoidStar = (void*)(&closureBody);
-    auto closure = new test::Closure(closureBodyVoidStar, env, envLength, numArgs, &optionals);
+    auto closure = new test::Closure(closureBodyVoidStar, env, envLength, numArgs);
 
     Roots roots{reinterpret_cast<Object**>(&closure)};
     TimerStorage timers;
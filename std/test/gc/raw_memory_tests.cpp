@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include "../infrastructure/global_test_allocator_fixture.h"
+#include "../infrastructure/object_wrappers.h"
+
+#include "std/private/memory_management/raw_memory.h"
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+namespace
+{
+class RawMemoryTest : public test::GlobalTestAllocatorFixture
+{
+public:
+    void TearDown() override
+    {
+        _rawMemory.sweep([](void* block) { ::operator delete(block); });
+        test::GlobalTestAllocatorFixture::TearDown();
+    }
+
+    void** allocateBlock(std::size_t wordsCount)
+    {
+        auto** block = static_cast<void**>(::operator new(wordsCount * sizeof(void*)));
+        std::fill(block, block + wordsCount, nullptr);
+
+        _rawMemory.add(block, wordsCount * sizeof(void*));
+        return block;
+    }
+
+    std::vector<void*> sweep()
+    {
+        std::vector<void*> deleted;
+        _rawMemory.sweep(
+            [&deleted](void* block)
+            {
+                deleted.push_back(block);
+                ::operator delete(block);
+            });
+        _rawMemory.unmark();
+
+        return deleted;
+    }
+
+protected:
+    RawMemory _rawMemory;
+};
+
+void* identity(void*** env)
+{
+    return *env[0];
+}
+} // namespace
+
+TEST_F(RawMemoryTest, UnreachableBlocksAreSwept)
+{
+    allocateBlock(1);
+    allocateBlock(2);
+    EXPECT_EQ(_rawMemory.getBlocksCount(), 2u);
+
+    _rawMemory.mark({}, {});
+
+    EXPECT_EQ(sweep().size(), 2u);
+    EXPECT_EQ(_rawMemory.getBlocksCount(), 0u);
+}
+
+TEST_F(RawMemoryTest, RootCellIsKept)
+{
+    auto** cell = allocateBlock(1);
+    auto** unreachable = allocateBlock(1);
+
+    *cell = new test::Number(1.0);
+
+    _rawMemory.mark(Roots{reinterpret_cast<Object**>(cell)}, {});
+    EXPECT_TRUE(_rawMemory.isMarked(cell));
+
+    const auto deleted = sweep();
+    ASSERT_EQ(deleted.size(), 1u);
+    EXPECT_EQ(deleted[0], unreachable);
+    EXPECT_TRUE(_rawMemory.contains(cell));
+}
+
+TEST_F(RawMemoryTest, BlocksReferencedFromAliveBlocksAreKept)
+{
+    // root -> environment -> { cell, environment of enclosing function -> cell }
+    auto** outerCell = allocateBlock(1);
+    auto** outerEnvironment = allocateBlock(1);
+    auto** cell = allocateBlock(1);
+    auto** environment = allocateBlock(3);
+    auto** root = allocateBlock(1);
+
+    outerEnvironment[0] = outerCell;
+    environment[0] = cell;
+    environment[1] = outerEnvironment;
+    environment[2] = new test::Number(2.0); // not a block
+    root[0] = environment;
+
+    _rawMemory.mark(Roots{reinterpret_cast<Object**>(root)}, {});
+
+    EXPECT_TRUE(sweep().empty());
+    EXPECT_EQ(_rawMemory.getBlocksCount(), 5u);
+}
+
+TEST_F(RawMemoryTest, ClosureKeepsEnvironment)
+{
+    auto** cell = allocateBlock(1);
+    auto** environment = allocateBlock(1);
+    environment[0] = cell;
+    *cell = new test::Number(3.0);
+
+    auto* closure = new test::Closure(reinterpret_cast<void*>(&identity),
+                                     reinterpret_cast<void***>(environment),
+                                     new test::Number(1.0),
+                                     new test::Number(0.0));
+
+    _rawMemory.mark({}, UniqueConstObjects{closure});
+    EXPECT_TRUE(sweep().empty());
+
+    EXPECT_EQ(static_cast<Number*>(closure->call())->unboxed(), 3.0);
+
+    // closure is not alive anymore
+    _rawMemory.mark({}, {});
+    EXPECT_EQ(sweep().size(), 2u);
+}
+
+TEST_F(RawMemoryTest, LazyClosureKeepsEnvironment)
+{
+    auto** cell = allocateBlock(1);
+    auto** environment = allocateBlock(1);
+    environment[0] = cell;
+
+    auto* lazyClosure = new test::LazyClosure(reinterpret_cast<void***>(environment));
+
+    _rawMemory.mark({}, UniqueConstObjects{lazyClosure});
+    EXPECT_TRUE(sweep().empty());
+}
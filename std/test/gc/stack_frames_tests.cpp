@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include "../infrastructure/global_test_allocator_fixture.h"
+#include "../infrastructure/object_wrappers.h"
+
+#include "std/private/memory_management/gc_object_marker.h"
+#include "std/private/memory_management/stack_frames.h"
+
+#include <array>
+
+namespace
+{
+class StackFramesTest : public test::GlobalTestAllocatorFixture
+{
+};
+} // namespace
+
+TEST_F(StackFramesTest, PushPop)
+{
+    // one array to get the addresses ordered like nested calls' frames: the outer one is higher
+    std::array<Object*, 4> stack{};
+    Object** outer = &stack[2];
+    Object** inner = &stack[0];
+
+    StackFrames frames;
+    frames.push(outer, 2);
+    frames.push(inner, 2);
+    EXPECT_EQ(frames.getFrames().size(), 2u);
+
+    frames.pop(inner);
+    ASSERT_EQ(frames.getFrames().size(), 1u);
+    EXPECT_EQ(frames.getFrames()[0].slots, outer);
+
+    frames.pop(outer);
+    EXPECT_TRUE(frames.getFrames().empty());
+}
+
+TEST_F(StackFramesTest, FramesLeftByExceptionAreDropped)
+{
+    std::array<Object*, 6> stack{};
+    Object** outer = &stack[4];
+    Object** thrower = &stack[0];
+    Object** next = &stack[2];
+
+    StackFrames frames;
+    frames.push(outer, 2);
+    frames.push(thrower, 2);
+
+    // 'thrower' never pops its frame, next call from 'outer' overlaps it
+    frames.push(next, 2);
+    ASSERT_EQ(frames.getFrames().size(), 2u);
+    EXPECT_EQ(frames.getFrames()[0].slots, outer);
+    EXPECT_EQ(frames.getFrames()[1].slots, next);
+
+    frames.push(thrower, 2);
+    frames.pop(outer);
+    EXPECT_TRUE(frames.getFrames().empty());
+}
+
+TEST_F(StackFramesTest, DropBelow)
+{
+    std::array<Object*, 4> stack{};
+
+    StackFrames frames;
+    frames.push(&stack[2], 2);
+    frames.push(&stack[0], 2);
+
+    frames.dropBelow(&stack[1]);
+    ASSERT_EQ(frames.getFrames().size(), 1u);
+    EXPECT_EQ(frames.getFrames()[0].slots, &stack[2]);
+
+    frames.clear();
+    EXPECT_TRUE(frames.getFrames().empty());
+}
+
+TEST_F(StackFramesTest, SlotsAreMarked)
+{
+    std::array<Object*, 3> slots{};
+    slots[0] = new test::Number(1.0);
+    slots[2] = new test::Number(2.0);
+    auto* unreachable = new test::Number(3.0);
+
+    Roots roots;
+    TimerStorage timers;
+    StackFrames frames;
+    frames.push(slots.data(), slots.size());
+
+    GCObjectMarker marker(roots, frames, timers);
+    marker.mark();
+
+    EXPECT_TRUE(marker.isMarked(slots[0]));
+    EXPECT_TRUE(marker.isMarked(slots[2]));
+    EXPECT_FALSE(marker.isMarked(unreachable));
+
+    marker.unmark();
+    frames.pop(slots.data());
+    marker.mark();
+
+    EXPECT_FALSE(marker.isMarked(slots[0]));
+}
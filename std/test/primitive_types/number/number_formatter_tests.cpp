@@ -0,0 +1,125 @@
+#include "std/private/number_formatter.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace
+{
+double fromBits(std::uint64_t bits)
+{
+    double result = 0;
+    std::memcpy(&result, &bits, sizeof(double));
+    return result;
+}
+} // namespace
+
+TEST(NumberFormatter, specialValues)
+{
+    EXPECT_EQ(NumberFormatter::toString(std::numeric_limits<double>::quiet_NaN()), "NaN");
+    EXPECT_EQ(NumberFormatter::toString(std::numeric_limits<double>::infinity()), "Infinity");
+    EXPECT_EQ(NumberFormatter::toString(-std::numeric_limits<double>::infinity()), "-Infinity");
+    EXPECT_EQ(NumberFormatter::toString(0.0), "0");
+    EXPECT_EQ(NumberFormatter::toString(-0.0), "0");
+}
+
+TEST(NumberFormatter, integers)
+{
+    EXPECT_EQ(NumberFormatter::toString(1), "1");
+    EXPECT_EQ(NumberFormatter::toString(-100500), "-100500");
+    EXPECT_EQ(NumberFormatter::toString(1234567), "1234567");
+    EXPECT_EQ(NumberFormatter::toString(9007199254740991.0), "9007199254740991");
+    EXPECT_EQ(NumberFormatter::toString(9007199254740992.0), "9007199254740992");
+    EXPECT_EQ(NumberFormatter::toString(18014398509481984.0), "18014398509481984");
+    EXPECT_EQ(NumberFormatter::toString(1e20), "100000000000000000000");
+    EXPECT_EQ(NumberFormatter::toString(123456789012345680000.0), "123456789012345680000");
+}
+
+TEST(NumberFormatter, shortestRoundTrip)
+{
+    EXPECT_EQ(NumberFormatter::toString(5.4), "5.4");
+    EXPECT_EQ(NumberFormatter::toString(0.1), "0.1");
+    EXPECT_EQ(NumberFormatter::toString(0.1 + 0.2), "0.30000000000000004");
+    EXPECT_EQ(NumberFormatter::toString(1.0 / 3.0), "0.3333333333333333");
+    EXPECT_EQ(NumberFormatter::toString(2.0 / 3.0), "0.6666666666666666");
+    EXPECT_EQ(NumberFormatter::toString(4.35), "4.35");
+    EXPECT_EQ(NumberFormatter::toString(-1.5), "-1.5");
+    EXPECT_EQ(NumberFormatter::toString(123.456), "123.456");
+    EXPECT_EQ(NumberFormatter::toString(9007199254740993.5), "9007199254740994");
+}
+
+TEST(NumberFormatter, smallFractions)
+{
+    EXPECT_EQ(NumberFormatter::toString(0.000001), "0.000001");
+    EXPECT_EQ(NumberFormatter::toString(0.0000015), "0.0000015");
+    EXPECT_EQ(NumberFormatter::toString(-0.000001234), "-0.000001234");
+    EXPECT_EQ(NumberFormatter::toString(1e-7), "1e-7");
+    EXPECT_EQ(NumberFormatter::toString(1.5e-7), "1.5e-7");
+    EXPECT_EQ(NumberFormatter::toString(123e-20), "1.23e-18");
+}
+
+TEST(NumberFormatter, exponentialNotation)
+{
+    EXPECT_EQ(NumberFormatter::toString(1e21), "1e+21");
+    EXPECT_EQ(NumberFormatter::toString(-1.5e21), "-1.5e+21");
+    EXPECT_EQ(NumberFormatter::toString(1e100), "1e+100");
+    EXPECT_EQ(NumberFormatter::toString(std::numeric_limits<double>::max()), "1.7976931348623157e+308");
+    EXPECT_EQ(NumberFormatter::toString(std::numeric_limits<double>::min()), "2.2250738585072014e-308");
+    EXPECT_EQ(NumberFormatter::toString(std::numeric_limits<double>::denorm_min()), "5e-324");
+    EXPECT_EQ(NumberFormatter::toString(-std::numeric_limits<double>::denorm_min()), "-5e-324");
+}
+
+TEST(NumberFormatter, roundingBoundaries)
+{
+    // Powers of two have an asymmetric rounding interval
+    EXPECT_EQ(NumberFormatter::toString(fromBits(0x4340000000000000ull)), "9007199254740992");
+    EXPECT_EQ(NumberFormatter::toString(fromBits(0x0010000000000000ull)), "2.2250738585072014e-308");
+    EXPECT_EQ(NumberFormatter::toString(fromBits(0x000fffffffffffffull)), "2.225073858507201e-308");
+    EXPECT_EQ(NumberFormatter::toString(fromBits(0x7fefffffffffffffull)), "1.7976931348623157e+308");
+    EXPECT_EQ(NumberFormatter::toString(fromBits(0x3ff0000000000001ull)), "1.0000000000000002");
+    EXPECT_EQ(NumberFormatter::toString(fromBits(0x3fefffffffffffffull)), "0.9999999999999999");
+    EXPECT_EQ(NumberFormatter::toString(2.0e-323), "2e-323");
+    EXPECT_EQ(NumberFormatter::toString(5.0e22), "5e+22");
+    EXPECT_EQ(NumberFormatter::toString(1.2345678901234567e-300), "1.2345678901234568e-300");
+}
+
+TEST(NumberFormatter, roundTrip)
+{
+    std::mt19937_64 random(42);
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        const double value = fromBits(random());
+        if (std::isnan(value))
+        {
+            continue;
+        }
+
+        const auto str = NumberFormatter::toString(value);
+        EXPECT_EQ(std::strtod(str.c_str(), nullptr), value) << str;
+    }
+}
+
+TEST(NumberFormatter, appendTo)
+{
+    std::string out = "value: ";
+    NumberFormatter::appendTo(-12.5, out);
+    out += ", ";
+    NumberFormatter::appendTo(1e21, out);
+
+    EXPECT_EQ(out, "value: -12.5, 1e+21");
+}
+
+TEST(NumberFormatter, formatFitsMaxLength)
+{
+    char buffer[NumberFormatter::MAX_LENGTH];
+
+    EXPECT_LE(NumberFormatter::format(-1.2345678901234567e-308, buffer), NumberFormatter::MAX_LENGTH);
+    EXPECT_LE(NumberFormatter::format(-0.0000012345678901234567, buffer), NumberFormatter::MAX_LENGTH);
+    EXPECT_LE(NumberFormatter::format(-123456789012345680000.0, buffer), NumberFormatter::MAX_LENGTH);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "../../infrastructure/object_wrappers.h"
+
+#include "std/private/number_parser.h"
+
+#include <cmath>
+#include <limits>
+
+class NumberParserTest : public test::GlobalTestAllocatorFixture
+{
+};
+
+namespace
+{
+double parseInt(const std::string& str, Union* radix)
+{
+    return NumberParser::parseInt(new test::String(str), radix)->unboxed();
+}
+} // namespace
+
+TEST(NumberParser, parseFloatInvalid)
+{
+    EXPECT_TRUE(std::isnan(NumberParser::parseFloat("")));
+    EXPECT_TRUE(std::isnan(NumberParser::parseFloat("   ")));
+    EXPECT_TRUE(std::isnan(NumberParser::parseFloat("str")));
+    EXPECT_TRUE(std::isnan(NumberParser::parseFloat("+")));
+    EXPECT_TRUE(std::isnan(NumberParser::parseFloat("--1")));
+    EXPECT_TRUE(std::isnan(NumberParser::parseFloat("e1")));
+    EXPECT_TRUE(std::isnan(NumberParser::parseFloat(".e1")));
+    EXPECT_TRUE(std::isnan(NumberParser::parseFloat("-.e-1")));
+    EXPECT_TRUE(std::isnan(NumberParser::parseFloat("inf")));
+    EXPECT_TRUE(std::isnan(NumberParser::parseFloat("nan")));
+    EXPECT_TRUE(std::isnan(NumberParser::parseFloat("infinity")));
+}
+
+TEST(NumberParser, parseFloatPrefix)
+{
+    EXPECT_EQ(NumberParser::parseFloat("11x"), 11);
+    EXPECT_EQ(NumberParser::parseFloat("11.s1"), 11);
+    EXPECT_EQ(NumberParser::parseFloat("  .5"), 0.5);
+    EXPECT_EQ(NumberParser::parseFloat("1..1"), 1);
+    EXPECT_EQ(NumberParser::parseFloat("0.1.1"), 0.1);
+    EXPECT_EQ(NumberParser::parseFloat("1ex"), 1);
+    EXPECT_EQ(NumberParser::parseFloat("1e-x"), 1);
+    EXPECT_EQ(NumberParser::parseFloat("1e1x"), 10);
+    EXPECT_EQ(NumberParser::parseFloat("0.1e-1x"), 0.01);
+    EXPECT_EQ(NumberParser::parseFloat("+2.5"), 2.5);
+    EXPECT_EQ(NumberParser::parseFloat("-2.5"), -2.5);
+    EXPECT_EQ(NumberParser::parseFloat("0x10"), 0);
+    EXPECT_EQ(NumberParser::parseFloat("Infinityx"), std::numeric_limits<double>::infinity());
+    EXPECT_EQ(NumberParser::parseFloat("-Infinity"), -std::numeric_limits<double>::infinity());
+}
+
+TEST(NumberParser, parseFloatIsCorrectlyRounded)
+{
+    EXPECT_EQ(NumberParser::parseFloat("0.30000000000000004"), 0.1 + 0.2);
+    EXPECT_EQ(NumberParser::parseFloat("2.2250738585072011e-308"), 2.2250738585072011e-308);
+    EXPECT_EQ(NumberParser::parseFloat("9007199254740993"), 9007199254740992.0);
+    EXPECT_EQ(NumberParser::parseFloat("1.7976931348623157e308"), std::numeric_limits<double>::max());
+    EXPECT_EQ(NumberParser::parseFloat("5e-324"), std::numeric_limits<double>::denorm_min());
+}
+
+TEST(NumberParser, parseFloatOutOfRange)
+{
+    EXPECT_EQ(NumberParser::parseFloat("1e400"), std::numeric_limits<double>::infinity());
+    EXPECT_EQ(NumberParser::parseFloat("-1e400"), -std::numeric_limits<double>::infinity());
+    EXPECT_EQ(NumberParser::parseFloat("1e-400"), 0.0);
+}
+
+TEST_F(NumberParserTest, parseInt)
+{
+    auto* noRadix = new test::Union();
+
+    EXPECT_EQ(parseInt("42", noRadix), 42);
+    EXPECT_EQ(parseInt("  -42px", noRadix), -42);
+    EXPECT_EQ(parseInt("+7.9", noRadix), 7);
+    EXPECT_EQ(parseInt("0x1F", noRadix), 31);
+    EXPECT_EQ(parseInt("9007199254740993", noRadix), 9007199254740992.0);
+    EXPECT_EQ(parseInt("123456789012345678901234567890", noRadix), 1.2345678901234568e+29);
+    EXPECT_TRUE(std::isnan(parseInt("", noRadix)));
+    EXPECT_TRUE(std::isnan(parseInt("x1", noRadix)));
+}
+
+TEST_F(NumberParserTest, parseIntWithRadix)
+{
+    EXPECT_EQ(parseInt("ff", new test::Union(new test::Number(16))), 255);
+    EXPECT_EQ(parseInt("0xff", new test::Union(new test::Number(16))), 255);
+    EXPECT_EQ(parseInt("101", new test::Union(new test::Number(2))), 5);
+    EXPECT_EQ(parseInt("z", new test::Union(new test::Number(36))), 35);
+    EXPECT_EQ(parseInt("ffffffffffffffffff", new test::Union(new test::Number(16))), 4.722366482869645e+21);
+    EXPECT_TRUE(std::isnan(parseInt("1", new test::Union(new test::Number(37)))));
+}
@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+
+#include "../../infrastructure/object_wrappers.h"
+
+#include <array>
+
+class StringConcatAllTest : public test::GlobalTestAllocatorFixture
+{
+};
+
+TEST_F(StringConcatAllTest, checkConcatenatesInOrder)
+{
+    auto* head = new test::String("key:");
+    std::array<void*, 3> others{new test::String("a"), new test::String(""), new test::String("ё1")};
+
+    auto* result = head->concatAll(others.data(), others.size());
+
+    EXPECT_EQ(result->cpp_str(), "key:aё1");
+    EXPECT_EQ(head->cpp_str(), "key:");
+}
+
+TEST_F(StringConcatAllTest, checkNoOthers)
+{
+    auto* head = new test::String("alone");
+
+    auto* result = head->concatAll(nullptr, 0);
+
+    EXPECT_EQ(result->cpp_str(), "alone");
+    EXPECT_NE(result, head);
+}
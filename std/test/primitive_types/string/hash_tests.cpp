@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include "../../infrastructure/object_wrappers.h"
+
+#include "std/tsnumber.h"
+
+class StringHashTest : public test::GlobalTestAllocatorFixture
+{
+};
+
+// Reference values of 32-bit FNV-1a
+TEST_F(StringHashTest, checkKnownValues)
+{
+    EXPECT_EQ((new test::String(""))->hash()->unboxed(), 2166136261.0);
+    EXPECT_EQ((new test::String("a"))->hash()->unboxed(), 3826002220.0);
+    EXPECT_EQ((new test::String("foobar"))->hash()->unboxed(), 3214735720.0);
+}
+
+TEST_F(StringHashTest, checkEqualStringsHaveEqualHashes)
+{
+    auto* lhs = new test::String("message_type");
+    auto* rhs = new test::String(std::string("message_") + "type");
+
+    EXPECT_EQ(lhs->hash()->unboxed(), rhs->hash()->unboxed());
+    EXPECT_NE(lhs->hash()->unboxed(), (new test::String("message_typE"))->hash()->unboxed());
+}
+
+TEST_F(StringHashTest, checkHashesUtf8Bytes)
+{
+    // "ё" is two bytes in UTF-8
+    EXPECT_EQ((new test::String("ё"))->hash()->unboxed(), 985704215.0);
+}
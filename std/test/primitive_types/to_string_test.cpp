@@ -120,11 +120,10 @@ TEST_F(ToStringTest, Promise)
 
     auto* envLength = new test::Number{1.0};
     auto* numArgs = new test::Number{1.0};
-    auto* opt = new test::Number{0.f};
 
     auto fn = toFunctionPtr([]() { return nullptr; });
 
-    auto closure = new test::Closure{(void*)fn, env, envLength, numArgs, opt};
+    auto closure = new test::Closure{(void*)fn, env, envLength, numArgs};
     auto* promise = new test::Promise(closure);
 
     checkStr(promise, "[object Promise]");
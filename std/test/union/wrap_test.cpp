@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include "../infrastructure/object_wrappers.h"
+
+class UnionWrapTest : public test::GlobalTestAllocatorFixture
+{
+};
+
+TEST_F(UnionWrapTest, UnwrapMember)
+{
+    auto* number = new test::Number(42.0);
+
+    EXPECT_EQ(Union::unwrap(number), number);
+}
+
+TEST_F(UnionWrapTest, UnwrapNestedUnions)
+{
+    auto* number = new test::Number(42.0);
+    auto* wrapped = new test::Union(new test::Union(number));
+
+    EXPECT_EQ(Union::unwrap(wrapped), number);
+}
+
+TEST_F(UnionWrapTest, WrapMember)
+{
+    auto* number = new test::Number(42.0);
+    auto* wrapped = Union::wrap(number);
+
+    ASSERT_TRUE(wrapped->isUnion());
+    EXPECT_EQ(wrapped->getValue(), number);
+}
+
+TEST_F(UnionWrapTest, WrapUnionReturnsIt)
+{
+    auto* wrapped = new test::Union(new test::Number(42.0));
+
+    EXPECT_EQ(Union::wrap(wrapped), wrapped);
+}
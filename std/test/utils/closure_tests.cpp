@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "../infrastructure/object_wrappers.h"
+
+#include <algorithm>
+#include <new>
+
+namespace
+{
+class ClosureTest : public test::GlobalTestAllocatorFixture
+{
+public:
+    // Mimics the compiler: closure and its environment share one allocation
+    ::TSClosure* makeInlineEnvironmentClosure(void* fn, std::uint32_t envLength, std::uint32_t numArgs)
+    {
+        void* storage = getAllocator().allocate(sizeof(::TSClosure) + envLength * sizeof(void**));
+
+        return ::new (storage) ::TSClosure(fn,
+                                           new test::Number(static_cast<double>(envLength)),
+                                           new test::Number(static_cast<double>(numArgs)));
+    }
+};
+
+void* sum(void*** env)
+{
+    auto* a = static_cast<Number*>(*env[0]);
+    auto* b = static_cast<Number*>(*env[1]);
+
+    return new test::Number(a->unboxed() + b->unboxed());
+}
+} // namespace
+
+TEST_F(ClosureTest, InlineEnvironment)
+{
+    auto* closure = makeInlineEnvironmentClosure(reinterpret_cast<void*>(&sum), 2, 2);
+
+    auto*** env = closure->getEnvironment();
+    EXPECT_EQ(reinterpret_cast<char*>(env), reinterpret_cast<char*>(closure) + sizeof(::TSClosure));
+
+    // Environment elements are pointers to cells holding the values
+    void* cells[2] = {nullptr, nullptr};
+    env[0] = &cells[0];
+    env[1] = &cells[1];
+
+    auto* a = new test::Number(20.0);
+    auto* b = new test::Number(3.0);
+    closure->setEnvironmentElement(a, 0);
+    closure->setEnvironmentElement(b, 1);
+
+    auto* result = static_cast<Number*>(closure->call());
+    EXPECT_EQ(result->unboxed(), 23);
+
+    const auto children = closure->getChildObjects();
+    EXPECT_NE(std::find(children.begin(), children.end(), a), children.end());
+    EXPECT_NE(std::find(children.begin(), children.end(), b), children.end());
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include "std/ievent_loop.h"
+#include "std/private/console_writer.h"
+
+#include <deque>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+class ManualEventLoop : public IEventLoop
+{
+public:
+    int run() override
+    {
+        processEvents();
+        return 0;
+    }
+
+    bool isRunning() const override
+    {
+        return false;
+    }
+
+    void stop() override
+    {
+    }
+
+    void enqueue(Callback&& callback) override
+    {
+        _callbacks.push_back(std::move(callback));
+    }
+
+    void processEvents() override
+    {
+        while (!_callbacks.empty())
+        {
+            auto callback = std::move(_callbacks.front());
+            _callbacks.pop_front();
+            callback();
+        }
+    }
+
+    std::size_t pending() const
+    {
+        return _callbacks.size();
+    }
+
+private:
+    std::deque<Callback> _callbacks;
+};
+
+void writeLine(ConsoleWriter& writer, const std::string& line)
+{
+    writer.buffer() += line;
+    writer.endLine();
+}
+} // namespace
+
+TEST(ConsoleWriter, lineFlushPolicy)
+{
+    std::ostringstream out;
+    ConsoleWriter writer(out);
+
+    writeLine(writer, "first");
+    EXPECT_EQ(out.str(), "first\n");
+
+    writeLine(writer, "second");
+    EXPECT_EQ(out.str(), "first\nsecond\n");
+}
+
+TEST(ConsoleWriter, sizeFlushPolicy)
+{
+    std::ostringstream out;
+    ConsoleWriter writer(out);
+
+    ConsoleWriter::Options options;
+    options.policy = ConsoleWriter::FlushPolicy::Size;
+    options.sizeThreshold = 10;
+    writer.setOptions(options);
+
+    writeLine(writer, "abc");
+    EXPECT_EQ(out.str(), "");
+
+    writeLine(writer, "defghi");
+    EXPECT_EQ(out.str(), "abc\ndefghi\n");
+}
+
+TEST(ConsoleWriter, intervalFlushPolicy)
+{
+    std::ostringstream out;
+    ConsoleWriter writer(out);
+
+    ConsoleWriter::Options options;
+    options.policy = ConsoleWriter::FlushPolicy::Interval;
+    options.interval = std::chrono::milliseconds(20);
+    writer.setOptions(options);
+
+    writeLine(writer, "abc");
+    EXPECT_EQ(out.str(), "");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+    writeLine(writer, "def");
+    EXPECT_EQ(out.str(), "abc\ndef\n");
+}
+
+TEST(ConsoleWriter, flushedByEventLoop)
+{
+    std::ostringstream out;
+    ConsoleWriter writer(out);
+    ManualEventLoop loop;
+
+    ConsoleWriter::Options options;
+    options.policy = ConsoleWriter::FlushPolicy::Size;
+    writer.setOptions(options);
+    writer.attachLoop(&loop);
+
+    writeLine(writer, "abc");
+    writeLine(writer, "def");
+
+    // Single flush per loop iteration
+    EXPECT_EQ(loop.pending(), 1u);
+    EXPECT_EQ(out.str(), "");
+
+    loop.processEvents();
+    EXPECT_EQ(out.str(), "abc\ndef\n");
+
+    writer.attachLoop(nullptr);
+}
+
+TEST(ConsoleWriter, flushedOnDestruction)
+{
+    std::ostringstream out;
+
+    {
+        ConsoleWriter writer(out);
+
+        ConsoleWriter::Options options;
+        options.policy = ConsoleWriter::FlushPolicy::Size;
+        writer.setOptions(options);
+
+        writeLine(writer, "abc");
+        EXPECT_EQ(out.str(), "");
+    }
+
+    EXPECT_EQ(out.str(), "abc\n");
+}
+
+TEST(ConsoleWriter, parseOptions)
+{
+    auto options = ConsoleWriter::parseOptions("line");
+    EXPECT_EQ(options.policy, ConsoleWriter::FlushPolicy::Line);
+
+    options = ConsoleWriter::parseOptions("size:4096");
+    EXPECT_EQ(options.policy, ConsoleWriter::FlushPolicy::Size);
+    EXPECT_EQ(options.sizeThreshold, 4096u);
+
+    options = ConsoleWriter::parseOptions("interval:250");
+    EXPECT_EQ(options.policy, ConsoleWriter::FlushPolicy::Interval);
+    EXPECT_EQ(options.interval, std::chrono::milliseconds(250));
+
+    options = ConsoleWriter::parseOptions("interval");
+    EXPECT_EQ(options.policy, ConsoleWriter::FlushPolicy::Interval);
+    EXPECT_EQ(options.interval, ConsoleWriter::Options{}.interval);
+
+    options = ConsoleWriter::parseOptions("size:abc");
+    EXPECT_EQ(options.policy, ConsoleWriter::FlushPolicy::Size);
+    EXPECT_EQ(options.sizeThreshold, ConsoleWriter::Options{}.sizeThreshold);
+
+    options = ConsoleWriter::parseOptions("unknown");
+    EXPECT_EQ(options.policy, ConsoleWriter::FlushPolicy::Line);
+}
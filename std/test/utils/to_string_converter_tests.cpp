@@ -233,11 +233,10 @@ TEST_F(ToStringConverterTest, Promise)
 
     auto* envLength = new test::Number{1.0};
     auto* numArgs = new test::Number{1.0};
-    auto* opt = new test::Number{0.f};
 
     auto fn = toFunctionPtr([]() { return nullptr; });
 
-    auto closure = new test::Closure{(void*)fn, env, envLength, numArgs, opt};
+    auto closure = new test::Closure{(void*)fn, env, envLength, numArgs};
     auto* promise = new test::Promise(closure);
 
     EXPECT_EQ(ToStringConverter::convert(promise), "Promise. Not ready");
@@ -259,4 +258,31 @@ TEST_F(ToStringConverterTest, Date)
     // EXPECT_TRUE(converted.find("95") != std::string::npos);
     // EXPECT_TRUE(converted.find("17") != std::string::npos);
     EXPECT_TRUE(converted.find("Date: ") != std::string::npos);
-}
\ No newline at end of file
+}
+TEST_F(ToStringConverterTest, StringWithLineBreaksInNestedObject)
+{
+    auto* nested = new test::Object();
+    nested->set("str", new test::String("a\nb"));
+
+    auto* o = new test::Object();
+    o->set("nested", nested);
+    o->set("num", new test::Number(0.5));
+
+    EXPECT_EQ(ToStringConverter::convert(o),
+              "{\n"
+              "  \"nested\": {\n"
+              "    \"str\": \"a\n"
+              "    b\"\n"
+              "  }\n"
+              "  \"num\": 0.5\n"
+              "}");
+}
+
+TEST_F(ToStringConverterTest, ConvertToAppends)
+{
+    std::string out = "prefix ";
+    ToStringConverter::convertTo(new test::Boolean(true), out);
+    ToStringConverter::convertTo(new test::Number(12), out);
+
+    EXPECT_EQ(out, "prefix true12");
+}
@@ -17,6 +17,14 @@ find_library(tsnative-std_LIBRARY
     NO_CMAKE_FIND_ROOT_PATH
 )
 
+# Optional, exists if the package was built with BUILD_BITCODE
+find_file(tsnative-std_BITCODE
+    NAMES tsnative-std.bc
+    PATHS ${_PACKAGE_LIBDIR}
+    NO_DEFAULT_PATH
+    NO_CMAKE_FIND_ROOT_PATH
+)
+
 # Cleanup
 set(_PACKAGE_LIBDIR )
 
@@ -5,7 +5,7 @@ from conan.tools.cmake import CMakeToolchain
 from conan.tools.files import copy, load, save
 
 from pathlib import Path
-import os, re, shutil, time
+import json, os, re, shutil, statistics, subprocess, time
 
 def pkg_suffix(self):
     if self._conan_user and self._conan_channel:
@@ -21,7 +21,7 @@ class TSNativeTestsConan(ConanFile):
     options = {
         "run_mode": ["compile", "runtime", "declarator", "all"],
         "test_filter": 'ANY',
-        "opt_level" : [0, 1 , 2, 3],
+        "opt_level" : [0, 1 , 2, 3, "s", "z"],
         "verbose" : [True, False],
         "print_ir" : [True, False],
         "trace_import" : [True, False],
@@ -29,6 +29,10 @@ class TSNativeTestsConan(ConanFile):
         "run_tests_with_memcheck" : [True, False],
         "fail_test_on_mem_leak" : [True, False],
         "enable_optimizations": [False, True],
+        "lto": [False, True],
+        "codegen_jobs": 'ANY',
+        "benchmark_runs": 'ANY',
+        "benchmark_baseline": 'ANY',
     }
 
     default_options = {
@@ -42,6 +46,10 @@ class TSNativeTestsConan(ConanFile):
         "run_tests_with_memcheck" : False,
         "fail_test_on_mem_leak" : False,
         "enable_optimizations": True,
+        "lto": False,
+        "codegen_jobs": 1,
+        "benchmark_runs": 0,
+        "benchmark_baseline": "",
     }
 
     src_path = Path("src/compiler/cases")
@@ -91,6 +99,8 @@ class TSNativeTestsConan(ConanFile):
         tc.variables["TRACE_IMPORT"] = bool(self.options.trace_import)
         tc.variables["TS_PROFILE_BUILD"] = bool(self.options.profile_build)
         tc.variables["OPT_LEVEL"] = "-O%s" % self.options.opt_level
+        tc.variables["LTO"] = bool(self.options.lto)
+        tc.variables["CODEGEN_JOBS"] = int(str(self.options.codegen_jobs))
 
         absolute_cpp_tests_path = self.toUnixPath(os.path.join(self.build_folder, self.getRelativeCppIntegrationTestsPath()))
         tc.variables["CPP_INTEGRATION_TESTS_PATH"] = absolute_cpp_tests_path
@@ -164,6 +174,47 @@ class TSNativeTestsConan(ConanFile):
         self.run("ctest " + test_options)
         os.chdir(prev_dir)
 
+    # Runs every compiled test several times and reports the median wall time per test.
+    # Results are saved to benchmark_O<opt_level>.json; pass such a file from another run
+    # as benchmark_baseline to see the speedup, e.g. -o opt_level=0 first, then -o opt_level=3.
+    def runBenchmark(self, out_dir):
+        runs = int(str(self.options.benchmark_runs))
+
+        ctestfile = load(self, os.path.join(out_dir, "CTestTestfile.cmake"))
+        binaries = sorted(set(l.split("\"")[1] for l in ctestfile.splitlines() if "add_test(" in l))
+
+        results = {}
+        for binary in binaries:
+            timings = []
+            for _ in range(runs):
+                start = time.perf_counter()
+                subprocess.run([binary], cwd=os.path.dirname(binary), stdout=subprocess.DEVNULL, check=True)
+                timings.append((time.perf_counter() - start) * 1000.0)
+            results[os.path.basename(binary)] = statistics.median(timings)
+
+        baseline = {}
+        if str(self.options.benchmark_baseline):
+            with open(str(self.options.benchmark_baseline), "r") as file:
+                baseline = json.load(file)["results"]
+
+        self.output.highlight("=== Benchmark, -O%s, median of %d runs" % (self.options.opt_level, runs))
+        for name, median in results.items():
+            line = "%-40s %10.2f ms" % (name, median)
+            if name in baseline and median > 0:
+                line += "  x%.2f" % (baseline[name] / median)
+            self.output.info(line)
+
+        if baseline:
+            common = [name for name in results if name in baseline]
+            total = sum(results[name] for name in common)
+            total_baseline = sum(baseline[name] for name in common)
+            if total > 0:
+                self.output.highlight("=== Total: %.2f ms vs %.2f ms baseline (x%.2f)" % (total, total_baseline, total_baseline / total))
+
+        output = os.path.join(self.build_folder, "benchmark_O%s.json" % self.options.opt_level)
+        save(self, output, json.dumps({"opt_level": str(self.options.opt_level), "runs": runs, "results": results}, indent=2))
+        self.output.info("Benchmark results saved to %s" % output)
+
     def buildCompiledTests(self):
         out_dir = "compiler_tests"
         # first - build pure ts tests
@@ -251,6 +302,9 @@ class TSNativeTestsConan(ConanFile):
         if self.settings.os != "Android":
             self.runCompiledTests(out_dir)
 
+            if int(str(self.options.benchmark_runs)) > 0:
+                self.runBenchmark(out_dir)
+
     def build(self):
         if self.settings.target_abi is None:
             self.output.error(
@@ -302,6 +356,10 @@ class TSNativeTestsConan(ConanFile):
         del self.info.options.print_ir
         del self.info.options.profile_build
         del self.info.options.run_tests_with_memcheck
+        del self.info.options.benchmark_runs
+        del self.info.options.benchmark_baseline
+        del self.info.options.lto
+        del self.info.options.codegen_jobs
 
     def setup_npm(self):
         self.init_npm_env()
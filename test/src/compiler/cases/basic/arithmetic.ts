@@ -196,3 +196,46 @@
   console.assert(less_than_or_equal(3, 3), "arithmetics: less_than_or_equal(3, 3) failed");
   console.assert(!less_than_or_equal(5, 4), "arithmetics: !less_than_or_equal(5, 4) failed");
 }
+
+{
+  // nested expressions are lowered to plain float instructions with a single boxing at the root
+  const polynomial = function (x: number): number {
+    return ((x * x) - 3 * x + 2) / (x + 1);
+  }
+
+  console.assert(polynomial(3) === 0.5, "arithmetics: polynomial(3) failed");
+  console.assert(-polynomial(3) * 2 === -1, "arithmetics: -polynomial(3) * 2 failed");
+  console.assert(7 % -3 === 1 && -7 % 3 === -1, "arithmetics: remainder sign failed");
+  console.assert(0.1 + 0.2 !== 0.3, "arithmetics: 0.1 + 0.2 !== 0.3 failed");
+
+  const nan = 0 / 0;
+  console.assert(nan !== nan, "arithmetics: NaN !== NaN failed");
+  console.assert(!(nan < 1) && !(nan >= 1), "arithmetics: NaN comparisons failed");
+
+  console.assert(((1 << 31) | 0) === -2147483648, "arithmetics: 1 << 31 failed");
+  console.assert((1 << 33) === 2, "arithmetics: shift count is not masked");
+  console.assert((-16 >> 2) === -4, "arithmetics: -16 >> 2 failed");
+  console.assert((0xFFFFFFFF & 0xFF) === 255, "arithmetics: ToInt32 failed");
+
+  // 'let' operands are not folded, these go through the runtime ToInt32
+  let notANumber = nan;
+  let infinity = 1 / 0;
+  let beyondUint32 = 4294967301;
+  let huge = 1e20;
+  let minusOne = -1;
+  console.assert((notANumber | 0) === 0, "arithmetics: NaN | 0 failed");
+  console.assert((infinity | 0) === 0 && (-infinity | 0) === 0, "arithmetics: Infinity | 0 failed");
+  console.assert((beyondUint32 | 0) === 5, "arithmetics: (2^32 + 5) | 0 failed");
+  console.assert((-beyondUint32 | 0) === -5, "arithmetics: -(2^32 + 5) | 0 failed");
+  console.assert((huge | 0) === 1661992960, "arithmetics: 1e20 | 0 failed");
+  console.assert((minusOne >>> 0) === 4294967295, "arithmetics: -1 >>> 0 failed");
+  console.assert((minusOne >>> 28) === 15, "arithmetics: -1 >>> 28 failed");
+
+  let sum = 0;
+  for (let i = 0; i < 10; ++i) {
+    if (i % 2 === 0 && i * i > 4) {
+      sum += i;
+    }
+  }
+  console.assert(sum === 4 + 6 + 8, "arithmetics: loop with numeric conditions failed");
+}
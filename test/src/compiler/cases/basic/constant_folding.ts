@@ -0,0 +1,52 @@
+const KB = 1 << 10;
+const MB = KB * KB;
+const GREETING = "Hello" + ", " + "world";
+const ENABLED = MB > KB && !false;
+
+function testFoldedNumbers() {
+    console.assert(KB === 1024, "Constant folding: 1 << 10 === 1024");
+    console.assert(MB === 1048576, "Constant folding: const chain KB * KB");
+    console.assert((2 + 3) * 4 - 1 === 19, "Constant folding: (2 + 3) * 4 - 1 === 19");
+    console.assert(-1 >>> 28 === 15, "Constant folding: -1 >>> 28 === 15");
+    console.assert(~5 === -6, "Constant folding: ~5 === -6");
+    console.assert(7 % -3 === 1, "Constant folding: 7 % -3 === 1");
+    console.assert(1 / 0 === Infinity, "Constant folding: 1 / 0 === Infinity");
+    console.assert([1, 2, 3].length === 3, "Constant folding: [1, 2, 3].length === 3");
+    console.assert(GREETING.length === 12, "Constant folding: length of constant string");
+}
+
+function testFoldedStdMembers() {
+    console.assert(Math.floor(Math.PI) === 3, "Constant folding: Math.floor(Math.PI) === 3");
+    console.assert(Math.trunc(-2.5) === -2, "Constant folding: Math.trunc(-2.5) === -2");
+    console.assert(Math.sqrt(16) === 4, "Constant folding: Math.sqrt(16) === 4");
+    console.assert(Math.max(1, 2) === 2 && Math.min(1, 2) === 1, "Constant folding: Math.max and Math.min");
+    console.assert(Number.MAX_SAFE_INTEGER + 1 === 9007199254740992, "Constant folding: MAX_SAFE_INTEGER + 1");
+    console.assert(Number.MIN_VALUE > 0 && Number.MIN_VALUE / 2 === 0, "Constant folding: MIN_VALUE is denormalized");
+    console.assert(Number.isInteger(KB / 4), "Constant folding: Number.isInteger(KB / 4)");
+    console.assert(!Number.isFinite(1 / 0), "Constant folding: Number.isFinite(1 / 0) is false");
+}
+
+function testFoldedStringsAndBooleans() {
+    console.assert(GREETING === "Hello, world", "Constant folding: string concatenation");
+    console.assert(`${KB} bytes` === "1024 bytes", "Constant folding: template with constant");
+    console.assert("n" + 1.5 === "n1.5", "Constant folding: number to string");
+    console.assert(ENABLED, "Constant folding: boolean const");
+    console.assert((KB > MB ? "yes" : "no") === "no", "Constant folding: conditional");
+}
+
+function testFoldedNumbersAreFresh() {
+    // every evaluation boxes its own number: changing one in place does not affect others
+    let a = KB + 1;
+    a++;
+    let b = KB + 1;
+    console.assert(a === 1026 && b === 1025, "Constant folding: folded numbers are not shared");
+
+    const values = [KB * 2, KB * 2];
+    values[0] += 1;
+    console.assert(values[0] === 2049 && values[1] === 2048, "Constant folding: folded array elements are not shared");
+}
+
+testFoldedNumbers();
+testFoldedStdMembers();
+testFoldedStringsAndBooleans();
+testFoldedNumbersAreFresh();
@@ -269,3 +269,73 @@
     testForLoopBodyCaptureCounterWithoutIncrementor();
     testForLoopCaptureCounterInsideObject();
 }
+
+// Counted loops: counter is a raw number unless a closure captures it
+{
+    function testCountedLoopCounterAsValue() {
+        const values: number[] = [];
+        for (let i = 0; i < 3; i++) {
+            values.push(i);
+        }
+
+        // every element is its own number
+        values[0] += 10;
+        console.assert(values[0] === 10 && values[1] === 1 && values[2] === 2, "For: counted loop counter pushed as value");
+    }
+
+    function testCountedLoopCounterArithmetic() {
+        let sum = 0;
+        for (let i = 10; i > 0; i -= 2) {
+            sum += i * 2;
+        }
+        console.assert(sum === 60, "For: counted loop with compound decrement");
+
+        let text = "";
+        for (let i = 3; i >= 1; --i) {
+            text += i.toString();
+        }
+        console.assert(text === "321", "For: counted loop counter method call");
+    }
+
+    function testCountedLoopWithContinueAndBreak() {
+        let count = 0;
+        for (let i = 0; i < 10; i++) {
+            if (i % 2 === 0) {
+                continue;
+            }
+
+            if (i > 6) {
+                break;
+            }
+
+            count++;
+        }
+        console.assert(count === 3, "For: counted loop with continue and break");
+    }
+
+    function testNestedCountedLoops() {
+        const matrix = [[1, 2], [3, 4]];
+        let sum = 0;
+        for (let i = 0; i < matrix.length; i++) {
+            for (let j = 0; j < matrix[i].length; j++) {
+                sum += matrix[i][j] * (i + 1);
+            }
+        }
+        console.assert(sum === 17, "For: nested counted loops");
+    }
+
+    function testCounterWrittenInBody() {
+        const visited: number[] = [];
+        for (let i = 0; i < 10; i++) {
+            visited.push(i);
+            i += 3;
+        }
+        console.assert(visited.length === 3 && visited[2] === 8, "For: counter changed by the body is not a counted loop");
+    }
+
+    testCountedLoopCounterAsValue();
+    testCountedLoopCounterArithmetic();
+    testCountedLoopWithContinueAndBreak();
+    testNestedCountedLoops();
+    testCounterWrittenInBody();
+}
@@ -67,4 +67,39 @@
         new TheWidget,
         new TheWidget,
     )
-}
\ No newline at end of file
+}
+
+{
+    const collect = (...items: number[]) => {
+        return items;
+    }
+
+    const source = [2, 3];
+    const tuple: [number, number] = [5, 6];
+
+    const collected = collect(1, ...source, 4, ...tuple);
+    console.assert(collected.length === 6, "Rest parameters with spreads in between (length)");
+
+    for (let i = 0; i < collected.length; ++i) {
+        console.assert(collected[i] === i + 1, "Rest parameters with spreads in between (order)");
+    }
+
+    collected.push(7);
+    console.assert(source.length === 2, "Spread array is copied into rest parameters");
+}
+
+{
+    const nested = (...items: number[][]) => {
+        return items;
+    }
+
+    const inner = [1, 2, 3];
+    const outer = nested(inner);
+    console.assert(outer.length === 1 && outer[0].length === 3, "Array argument is not flattened into rest parameters");
+}
+
+{
+    const array = [1, 2];
+    array.push(...array);
+    console.assert(array.length === 4 && array[2] === 1 && array[3] === 2, "Array spread into its own push");
+}
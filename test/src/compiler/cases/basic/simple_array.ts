@@ -826,3 +826,26 @@ class A {
   let a = [1, 2, 3][0];
   console.assert(a === 1, "Array literal indexing: a !== 1");
 }
+
+// Array functional methods
+{
+  const numbers: number[] = [8, 16, 32, 64, 128];
+
+  const big = numbers.filter((n: number) => n > 20);
+  console.assert(is_equal(big, [32, 64, 128]), "array: filter((n: number) => n > 20) failed");
+
+  const even = numbers.filter((n: number, i: number) => i % 2 === 0);
+  console.assert(is_equal(even, [8, 32, 128]), "array: filter((n: number, i: number)) failed");
+
+  console.assert(numbers.some((n: number) => n === 64), "array: some failed");
+  console.assert(!numbers.some((n: number) => n > 1000), "array: !some failed");
+  console.assert(numbers.every((n: number) => n % 8 === 0), "array: every failed");
+  console.assert(!numbers.every((n: number) => n < 100), "array: !every failed");
+
+  const found = numbers.find((n: number) => n > 20);
+  console.assert(found === 32, "array: find failed");
+  console.assert(numbers.find((n: number) => n > 1000) === undefined, "array: find undefined failed");
+
+  const sum = numbers.reduce((acc: number, n: number) => acc + n, 0);
+  console.assert(sum === 248, "array: reduce failed");
+}
@@ -1621,4 +1621,97 @@
   }
   
   buzzfuzz();
-}
\ No newline at end of file
+}
+{
+  // Calls that class hierarchy analysis resolves to a single method: private member makes the class nominal
+  class Vector {
+    x: number;
+    y: number;
+    private readonly dimensions = 2;
+
+    constructor(x: number, y: number) {
+      this.x = x;
+      this.y = y;
+    }
+
+    get length2(): number {
+      return this.dot(this);
+    }
+
+    get size(): number {
+      return this.dimensions;
+    }
+
+    dot(other: Vector): number {
+      return this.x * other.x + this.y * other.y;
+    }
+
+    scale(factor: number): Vector {
+      this.x *= factor;
+      this.y *= factor;
+      return this;
+    }
+  }
+
+  class Shape {
+    area(): number {
+      return 0;
+    }
+
+    describe(): string {
+      return "shape";
+    }
+  }
+
+  class Square extends Shape {
+    side: number = 2;
+
+    area(): number {
+      return this.side * this.side;
+    }
+  }
+
+  const v = new Vector(1, 2);
+  let sum = 0;
+  for (let i = 0; i < 100; ++i) {
+    sum += v.dot(v);
+  }
+
+  console.assert(sum === 500, "class: direct method call in a loop failed");
+  console.assert(v.scale(2).scale(0.5).length2 === 5, "class: direct calls of chained methods and getter failed");
+
+  const shapes: Shape[] = [new Shape(), new Square()];
+  console.assert(shapes[0].area() === 0, "class: call of overridden method on base failed");
+  console.assert(shapes[1].area() === 4, "class: call of overridden method on derived failed");
+  console.assert(shapes[1].describe() === "shape", "class: inherited method call failed");
+  console.assert(v.size === 2, "class: direct getter call failed");
+
+  // Structurally typed values of a class type that are no instances of it
+  class Circle {
+    area(): number {
+      return 3;
+    }
+
+    describe(): string {
+      return "circle";
+    }
+  }
+
+  class Triangle implements Shape {
+    area(): number {
+      return 1;
+    }
+
+    describe(): string {
+      return "triangle";
+    }
+  }
+
+  const circle: Shape = new Circle();
+  const triangle: Shape = new Triangle();
+  const literal: Shape = { area: () => 5, describe: () => "literal" };
+
+  console.assert(circle.area() === 3, "class: method call on instance of class of the same shape failed");
+  console.assert(triangle.describe() === "triangle", "class: method call on class implementing class failed");
+  console.assert(literal.area() === 5, "class: method call on object literal of class type failed");
+}
@@ -475,4 +475,45 @@ class MyError {
   }
 
   fuzz();
-}
\ No newline at end of file
+}
+{
+  function thrower(i: number) {
+    if (i % 2 === 0) throw i;
+    return i;
+  }
+
+  function sumCaught(n: number) {
+    let sum = 0;
+    for (let i = 0; i < n; i++) {
+      try {
+        if (i === 3) throw 100;          // caught within this function
+        sum += thrower(i);               // caught after unwinding from 'thrower'
+      } catch (e) {
+        const value: number = e;
+        sum -= value;
+      }
+    }
+    return sum;
+  }
+
+  // 0 - 0, 1, 2 - 2, 3 - 100, 4 - 4
+  console.assert(sumCaught(5) === -105, "Exceptions: local and unwinding throws in a loop");
+
+  function nested(): number {
+    try {
+      const inner = () => {
+        try {
+          throw 1;
+        } catch (e) {
+          throw 2;
+        }
+      };
+      inner();
+    } catch (e) {
+      return e;
+    }
+    return 0;
+  }
+
+  console.assert(nested() === 2, "Exceptions: throw from catch of a closure leaves the closure");
+}
@@ -210,3 +210,57 @@
   const r = f(i);
   console.assert(r === i + 1 && i === 22, "Parameters must shadow variables from outer scope");
 }
+
+// Recursion: every call has its own parameters
+{
+  let calls = 0;
+
+  function sumDigits(n: number, acc: number): number {
+    ++calls;
+
+    if (n === 0) {
+      return acc;
+    }
+
+    const digit = n % 10;
+    const rest = sumDigits((n - digit) / 10, acc + digit);
+
+    console.assert(n % 10 === digit, "Parameter must not be changed by recursive call");
+    return rest;
+  }
+
+  console.assert(sumDigits(12345, 0) === 15, "Recursive function with arguments failed");
+  console.assert(calls === 6, "Recursive function must see captured variables");
+
+  function ackermann(m: number, n: number): number {
+    if (m === 0) {
+      return n + 1;
+    }
+
+    if (n === 0) {
+      return ackermann(m - 1, 1);
+    }
+
+    return ackermann(m - 1, ackermann(m, n - 1));
+  }
+
+  console.assert(ackermann(2, 3) === 9, "Deep recursion failed");
+
+  function valueOr(value: number | null, fallback: number) {
+    if (value) {
+      return value as number;
+    }
+
+    return fallback;
+  }
+
+  console.assert(valueOr(7, 0) === 7 && valueOr(null, 5) === 5, "Union parameter failed");
+
+  function withColon(text: string) {
+    text += ":";
+    return text;
+  }
+
+  const text = "p";
+  console.assert(withColon(text) === "p:" && text === "p", "Primitive arguments must be passed by value");
+}
@@ -365,3 +365,27 @@
     }
   }
 }
+
+{
+  // literals are shared by every evaluation, values built from them must not affect each other
+  const parts: string[] = [];
+  for (let i = 0; i < 3; i++) {
+    let s = "item";
+    s += i;
+    parts.push(s);
+    parts.push("item");
+  }
+  console.assert(parts[0] === "item0" && parts[2] === "item1" && parts[4] === "item2", "String: literal in loop 1");
+  console.assert(parts[1] === "item" && parts[3] === "item" && parts[5] === "item", "String: literal in loop 2");
+}
+
+{
+  const n = 42;
+  const b = true;
+  const key = "user";
+  console.assert(key + ":" + n + ":" + b === "user:42:true", "String: '+' chain");
+  console.assert(1 + 2 + "x" + 1 + 2 === "3x12", "String: '+' chain starting with numbers");
+  console.assert(`${key}/${n}` === "user/42", "String: template literal");
+  console.assert(`${n}` === "42", "String: template literal of a single span");
+  console.assert(`[${key}]-${""}-${b}!` === "[user]--true!", "String: template literal with empty span");
+}
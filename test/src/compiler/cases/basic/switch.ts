@@ -411,3 +411,132 @@
   };
   console.assert(f(1) === undefined, "Unhadled switch-case value must return 'undefined'");
 }
+
+{
+  // opcode dispatch: integral labels are lowered to a jump table
+  const OP_HALT = 0;
+  const OP_PUSH = 1;
+
+  const run = function (program: number[]): number {
+    let acc = 0;
+    let steps = 0;
+
+    for (let pc = 0; pc < program.length; ++pc) {
+      ++steps;
+
+      switch (program[pc]) {
+        case OP_HALT:
+          return acc;
+        case OP_PUSH:
+          acc += program[++pc];
+          break;
+        case 2:
+          acc *= 2;
+          break;
+        case -3:
+          acc = -acc;
+          break;
+        case 7:
+        case 8:
+          acc += 100;
+          break;
+        case 2:
+          acc = -1000; // shadowed by the first 'case 2'
+          break;
+        default:
+          acc += 1000;
+      }
+    }
+
+    return steps;
+  }
+
+  console.assert(run([1, 5, 2, -3, 0]) === -10, "switch: opcode dispatch failed");
+  console.assert(run([7, 8, 0]) === 200, "switch: opcode dispatch (grouped labels) failed");
+  console.assert(run([2.5, 0]) === 1000, "switch: non-integral value must go to default");
+  console.assert(run([-0, 1, 3, 0]) === 0, "switch: -0 must match 'case 0'");
+  console.assert(run([NaN, 0]) === 1000, "switch: NaN must go to default");
+  console.assert(run([4294967298, 0]) === 1000, "switch: value out of int32 range must go to default");
+  console.assert(run([1, 1]) === 1, "switch: falling out of the loop failed");
+}
+
+{
+  // message type dispatch: string labels are dispatched on hash
+  const PING = "ping";
+
+  const handle = function (type: string): number {
+    let result = 0;
+
+    switch (type) {
+      case PING:
+        result += 1;
+        break;
+      case "pong":
+        result += 2;
+      case "data":
+        result += 4;
+        break;
+      case "":
+        result += 8;
+        break;
+      case "привет":
+        result += 16;
+        break;
+      case "ping":
+        result += 32; // shadowed by 'case PING'
+        break;
+      default:
+        result += 64;
+    }
+
+    return result;
+  }
+
+  console.assert(handle("ping") === 1, "switch: string dispatch ('ping') failed");
+  console.assert(handle("pong") === 6, "switch: string dispatch fallthrough ('pong') failed");
+  console.assert(handle("data") === 4, "switch: string dispatch ('data') failed");
+  console.assert(handle("") === 8, "switch: string dispatch (empty string) failed");
+  console.assert(handle("привет") === 16, "switch: string dispatch (non-ascii) failed");
+  console.assert(handle("pin" + "g") === 1, "switch: string dispatch (computed string) failed");
+  console.assert(handle("PING") === 64, "switch: string dispatch (default) failed");
+
+  const withoutDefault = function (type: string): number {
+    switch (type) {
+      case "a":
+        return 1;
+      case "b":
+        return 2;
+    }
+
+    return 0;
+  }
+
+  console.assert(withoutDefault("b") === 2, "switch: string dispatch without default failed");
+  console.assert(withoutDefault("c") === 0, "switch: string dispatch without default (no match) failed");
+}
+
+{
+  // discriminant is evaluated exactly once
+  let evaluations = 0;
+
+  const next = function (): number {
+    ++evaluations;
+    return 3;
+  }
+
+  let result = 0;
+
+  switch (next()) {
+    case 1:
+      result = 1;
+      break;
+    case 2:
+      result = 2;
+      break;
+    case 3:
+      result = 3;
+      break;
+  }
+
+  console.assert(result === 3 && evaluations === 1, "switch: discriminant must be evaluated once");
+}
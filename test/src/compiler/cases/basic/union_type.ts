@@ -439,3 +439,23 @@ function RxPane(args: RxPane_args) {
 RxPane({})
 RxPane({margins: undefined})
 
+
+// Assignment to a union variable does not change the unions it was copied to
+{
+    let u1: number | string = 1;
+    const u2 = u1;
+    u1 = "one";
+
+    console.assert(u1 === "one" && u2 === 1, "Union: assignment changed the copied union");
+}
+
+// Array.pop and Array.find return the element itself or undefined
+{
+    const numbers = [1, 2, 3];
+    const found = numbers.find((n) => n === 2);
+    const popped = numbers.pop();
+
+    console.assert(found === 2 && popped === 3, "Union: pop and find return the elements");
+    const empty: number[] = [];
+    console.assert(empty.pop() === undefined, "Union: pop of empty array returns undefined");
+}
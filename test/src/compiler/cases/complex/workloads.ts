@@ -0,0 +1,64 @@
+// Small CPU-bound kernels. Besides checking the results they give the test conanfile's
+// benchmark mode (-o benchmark_runs=N) something measurable to compare optimization levels on.
+
+{
+  // numeric loop
+  let sum = 0;
+  for (let i = 0; i < 200000; ++i) {
+    sum += (i * 3) % 7;
+  }
+  console.assert(sum === 600000, "workloads: numeric loop failed");
+}
+
+function fib(n: number): number {
+  return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+{
+  // recursion
+  console.assert(fib(20) === 6765, "workloads: fib(20) failed");
+}
+
+{
+  // array traversal
+  const values: number[] = [];
+  for (let i = 0; i < 10000; ++i) {
+    values.push(i);
+  }
+
+  let total = 0;
+  values.forEach((value: number) => {
+    total += value;
+  });
+  console.assert(total === 49995000, "workloads: array traversal failed");
+
+  const evens = values.filter((value: number) => value % 2 === 0);
+  console.assert(evens.length === 5000, "workloads: array filter failed");
+}
+
+{
+  // closures
+  const makeCounter = function () {
+    let count = 0;
+    return () => {
+      ++count;
+      return count;
+    };
+  }
+
+  const counter = makeCounter();
+  let last = 0;
+  for (let i = 0; i < 10000; ++i) {
+    last = counter();
+  }
+  console.assert(last === 10000, "workloads: closure counter failed");
+}
+
+{
+  // string building
+  let s = "";
+  for (let i = 0; i < 1000; ++i) {
+    s += "x";
+  }
+  console.assert(s.length === 1000, "workloads: string building failed");
+}
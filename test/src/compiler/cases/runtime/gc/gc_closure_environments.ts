@@ -0,0 +1,38 @@
+// Variable cells and environments are reclaimed by collections that run between event loop tasks.
+// Environments of closures that are still reachable must survive them.
+
+function makeCounter(start: number) {
+    let value = start;
+    return () => {
+        value = value + 1;
+        return value;
+    };
+}
+
+const counters: (() => number)[] = [];
+
+for (let i = 0; i < 3; ++i) {
+    counters.push(makeCounter(i * 10));
+}
+
+function generateLoad() {
+    let s = "";
+    for (let i = 0; i < 1000; ++i) {
+        s += "load" + i;
+        makeCounter(i)();
+    }
+    return s;
+}
+
+setTimeout(() => {
+    generateLoad();
+
+    setTimeout(() => {
+        generateLoad();
+
+        console.assert(counters[0]() === 1, "Closure environment must survive collection (0)");
+        console.assert(counters[1]() === 11, "Closure environment must survive collection (1)");
+        console.assert(counters[2]() === 21, "Closure environment must survive collection (2)");
+        console.assert(counters[0]() === 2, "Closure environment must keep its state");
+    }, 0);
+}, 0);
@@ -0,0 +1,63 @@
+// Variables no closure captures live in the stack frame of their function.
+// Frame is a gc root while the function runs, also after an exception is caught in it.
+
+function collectWithLocals(n: number) {
+    const values: number[] = [];
+    let text = "";
+
+    for (let i = 0; i < n; ++i) {
+        values.push(i);
+        text += i;
+    }
+
+    gc.collect();
+
+    console.assert(values.length === n, "Stack frame variable must survive collection");
+    console.assert(text === "0123", "Stack frame variable must keep its value");
+    return values;
+}
+
+function thrower(s: string) {
+    const local = s + "!";
+    throw local;
+}
+
+function catchAndCollect() {
+    const kept = [1, 2, 3];
+
+    try {
+        thrower("error");
+    } catch (e) {
+        gc.collect();
+    }
+
+    console.assert(kept.length === 3 && kept[2] === 3, "Stack frame variable must survive collection after catch");
+}
+
+// Exception leaves 'throwThroughFrame' for C++ code of the promise, which drops the frame
+function throwThroughFrame(n: number): number {
+    const local = [n, n + 1];
+    thrower("rejected " + local.length);
+    return local[0];
+}
+
+function collectAfterRejection() {
+    const kept = [4, 5, 6];
+
+    Promise.resolve(1).then((n: number): number => {
+        return throwThroughFrame(n);
+    }).catch((reason: string) => {
+        gc.collect();
+        console.assert(reason === "rejected 2!", "Rejection reason must survive collection");
+    });
+
+    gc.collect();
+    console.assert(kept[2] === 6, "Stack frame variable must survive collection after rejection");
+}
+
+const values = collectWithLocals(4);
+catchAndCollect();
+collectAfterRejection();
+gc.collect();
+
+console.assert(values[3] === 3, "Returned value must survive collection");